@@ -0,0 +1,147 @@
+/*
+@file		access_pattern_detector_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of AccessPatternDetector (the classification of the requests, and the confirmation of a switch)
+*/
+
+// STD
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "access_pattern_detector.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	/// Record requests, and return the pattern after each one
+	vector<AccessPattern> RecordAll(AccessPatternDetector &detector, const vector<long int> &frames)
+	{
+		vector<AccessPattern> patterns;
+		for (size_t index = 0; index < frames.size(); index++)
+		{
+			detector.Record(frames[index]);
+			patterns.push_back(detector.GetPattern());
+		}
+
+		return patterns;
+	}
+
+	/// Check the pattern after the last request
+	void CheckPattern(const vector<long int> &frames, AccessPattern expected, long int scrub_distance = 250)
+	{
+		AccessPatternDetector detector(scrub_distance);
+		vector<AccessPattern> patterns = RecordAll(detector, frames);
+
+		VS_CHECK_MESSAGE(patterns.back() == expected, string(AccessPatternDetector::GetPatternName(patterns.back())) +
+			" instead of " + AccessPatternDetector::GetPatternName(expected));
+	}
+}
+
+// Playback and reverse playback are detected on the request after the first one which shows them
+VS_TEST(AccessPatternSequentialAndReverse)
+{
+	AccessPatternDetector detector;
+
+	// The first classification needs MinHistory requests, and then one more to be confirmed
+	vector<AccessPattern> patterns = RecordAll(detector, { 1, 2, 3, 4, 5, 6 });
+	VS_CHECK(patterns[AccessPatternDetector::MinHistory - 1] == ACCESS_UNKNOWN);
+	VS_CHECK(patterns[AccessPatternDetector::MinHistory] == ACCESS_FORWARD);
+	VS_CHECK(patterns.back() == ACCESS_FORWARD);
+
+	AccessStrategy strategy = detector.GetStrategy();
+	VS_CHECK(strategy.prefetch_count > 0 && strategy.prefetch_step == 1);
+	VS_CHECK(strategy.walk_bias > 1.0);
+
+	// A paused playhead repeats its frame, which doesn't count as a request
+	RecordAll(detector, { 6, 6, 6 });
+	VS_CHECK(detector.GetPattern() == ACCESS_FORWARD);
+	VS_CHECK(detector.GetStats().requests == 6);
+
+	// Reverse playback, with a dropped frame
+	detector.Reset(250);
+	VS_CHECK(detector.GetPattern() == ACCESS_UNKNOWN);
+	RecordAll(detector, { 100, 99, 98, 97, 95, 94, 93, 92, 91 });
+	VS_CHECK(detector.GetPattern() == ACCESS_REVERSE);
+
+	strategy = detector.GetStrategy();
+	VS_CHECK(strategy.prefetch_step == -1 && strategy.retain_gop);
+
+	// Thumbnails (every 10th frame)
+	CheckPattern({ 1, 11, 21, 31, 41, 51 }, ACCESS_STRIDED);
+}
+
+// Irregular jumps are scrubbing within the scrub distance, and random access beyond it (also with a median distance
+// which changes on every request)
+VS_TEST(AccessPatternScrubAndRandom)
+{
+	CheckPattern({ 500, 520, 490, 530, 470, 540, 460, 545 }, ACCESS_SCRUB);
+	CheckPattern({ 500, 520, 490, 530, 470, 540, 460, 545 }, ACCESS_RANDOM, 10);
+	CheckPattern({ 100, 9000, 2500, 40000, 700, 12000, 31000 }, ACCESS_RANDOM);
+
+	AccessStrategy strategy = AccessPatternDetector::GetStrategy(ACCESS_SCRUB, 30);
+	VS_CHECK(strategy.prefetch_count == 0 && strategy.walk_bias < 1.0);
+}
+
+// An A/B compare alternates between two regions, a frame forward each time: scrubbing when the regions are close,
+// random access when they are far apart
+VS_TEST(AccessPatternAlternatingRegions)
+{
+	CheckPattern({ 100, 200, 101, 201, 102, 202, 103, 203 }, ACCESS_SCRUB);
+	CheckPattern({ 1000, 5000, 1001, 5001, 1002, 5002, 1003, 5003 }, ACCESS_RANDOM);
+
+	// Never mistaken for playback
+	AccessPatternDetector detector;
+	vector<AccessPattern> patterns = RecordAll(detector, { 1000, 5000, 1001, 5001, 1002, 5002, 1003, 5003, 1004, 5004 });
+	for (size_t index = 0; index < patterns.size(); index++)
+		VS_CHECK(patterns[index] == ACCESS_UNKNOWN || patterns[index] == ACCESS_RANDOM);
+}
+
+// A new pattern is only adopted once two requests in a row show it, so a single jump during playback keeps the
+// prefetch going
+VS_TEST(AccessPatternSwitchNeedsTwoConfirmations)
+{
+	VS_CHECK(AccessPatternDetector::SwitchConfirmations == 2);
+
+	AccessPatternDetector detector;
+	RecordAll(detector, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+	VS_CHECK(detector.GetPattern() == ACCESS_FORWARD);
+
+	// A single jump
+	RecordAll(detector, { 300, 301, 302 });
+	VS_CHECK(detector.GetPattern() == ACCESS_FORWARD);
+
+	// Sampling every 10th frame: classified as scrubbing and then as sampling, each one switched to a request later
+	detector.Reset(250);
+	RecordAll(detector, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+	vector<AccessPattern> patterns = RecordAll(detector, { 19, 29, 39, 49, 59, 69, 79 });
+	VS_CHECK(patterns[2] == ACCESS_FORWARD);
+	VS_CHECK(patterns[3] == ACCESS_SCRUB);
+	VS_CHECK(patterns[5] == ACCESS_SCRUB);
+	VS_CHECK(patterns[6] == ACCESS_STRIDED);
+	VS_CHECK(detector.GetStrategy().prefetch_step == 10);
+
+	// Every switch is logged, with the request which confirmed it
+	deque<AccessPatternSwitch> switches = detector.GetSwitches();
+	VS_CHECK(switches.size() == 4);
+	VS_CHECK(switches.back().from == ACCESS_SCRUB && switches.back().to == ACCESS_STRIDED);
+	VS_CHECK(switches.back().frame == 79 && switches.back().stride == 10);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
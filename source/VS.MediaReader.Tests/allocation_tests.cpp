@@ -0,0 +1,123 @@
+/*
+@file		allocation_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Counts the allocations of the decode loop (with a counting operator new for the whole test program)
+*/
+
+// STD
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "reader.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	// The small objects a frame may allocate in order (the frame, its shared pointer, and the nodes of the maps
+	// and caches tracking it), once the caches are full
+	const int MaxAllocationsPerFrame = 64;
+
+	// The bytes a frame may allocate with operator new, as a fraction of its image (the pixels, packets,
+	// AVFrames and scratch buffers must all be reused)
+	const int MaxBytesPerFrameDivisor = 16;
+
+	// The allocations of every thread, while counting
+	atomic<bool> is_counting(false);
+	atomic<long long> allocation_count(0);
+	atomic<long long> allocated_bytes(0);
+}
+
+// Count the allocations (the other forms of operator new and delete call these ones)
+void* operator new(size_t size)
+{
+	if (is_counting)
+	{
+		allocation_count++;
+		allocated_bytes += size;
+	}
+
+	void *pointer = malloc(size ? size : 1);
+	if (pointer == NULL)
+		throw bad_alloc();
+
+	return pointer;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+	free(pointer);
+}
+
+// Once the caches are full, decoding frames in order only allocates a few small objects per frame
+VS_TEST(SteadyStateDecodeAllocations)
+{
+	FFmpegReader reader(GetTestMedia());
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	// The first half fills the caches and the buffer pools, the second half is counted
+	long int frames = min(reader.info.video_length, (long int)(4.0 * reader.info.fps.ToDouble()));
+	if (frames < 20)
+		VS_SKIP("the test media is too short");
+
+	long int warmup = frames / 2;
+	for (long int number = 1; number <= warmup; number++)
+		reader.GetFrame(number);
+
+	allocation_count = 0;
+	allocated_bytes = 0;
+	is_counting = true;
+	for (long int number = warmup + 1; number <= frames; number++)
+		reader.GetFrame(number);
+	is_counting = false;
+
+	long int counted = frames - warmup;
+	long long int allocations_per_frame = allocation_count / counted;
+	long long int bytes_per_frame = allocated_bytes / counted;
+	long long int image_bytes = (long long int)reader.info.width * reader.info.height * 4;
+
+	VS_CHECK_MESSAGE(allocations_per_frame <= MaxAllocationsPerFrame, to_string(allocations_per_frame) + " allocations per frame");
+	VS_CHECK_MESSAGE(bytes_per_frame < image_bytes / MaxBytesPerFrameDivisor, to_string(bytes_per_frame) + " bytes per frame");
+
+	reader.Close();
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,238 @@
+/*
+@file		audio_conversion_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of AudioConversion, and of the sample formats the reader converts without avresample
+*/
+
+// STD
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "audio_conversion.hpp"
+#include "reader.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	// The channel counts with a path of their own, and a few without
+	const int ChannelCounts[] = { 1, 2, 3, 5, 6, 7, 8 };
+
+	/// Get one pointer per channel, into planar samples (channel after channel)
+	template <typename Pointer, typename Sample>
+	vector<Pointer> GetChannelPointers(vector<Sample> &planar, int channels, int num_samples)
+	{
+		vector<Pointer> pointers;
+		for (int channel = 0; channel < channels; channel++)
+			pointers.push_back(planar.data() + (size_t)channel * num_samples);
+
+		return pointers;
+	}
+
+	/// Fill a buffer with random samples of a format (any bits for the integers, -1.0 to 1.0 for the floats)
+	void FillSamples(uint8_t *data, AVSampleFormat sample_fmt, int count, mt19937 &random)
+	{
+		uniform_real_distribution<double> amplitude(-1.0, 1.0);
+
+		switch (av_get_packed_sample_fmt(sample_fmt))
+		{
+		case AV_SAMPLE_FMT_FLT:
+			for (int index = 0; index < count; index++)
+				((float*)data)[index] = (float)amplitude(random);
+			break;
+
+		case AV_SAMPLE_FMT_DBL:
+			for (int index = 0; index < count; index++)
+				((double*)data)[index] = amplitude(random);
+			break;
+
+		default:
+			for (int index = 0; index < count * av_get_bytes_per_sample(sample_fmt); index++)
+				data[index] = (uint8_t)random();
+			break;
+		}
+	}
+}
+
+// Splitting the channels (and combining them back) gives every sample of every channel at its place, for each
+// channel count and for the samples left over after the vector loops
+VS_TEST(DeinterleaveMatchesScalar)
+{
+	for (size_t index = 0; index < sizeof(ChannelCounts) / sizeof(ChannelCounts[0]); index++)
+	{
+		int channels = ChannelCounts[index];
+		for (int num_samples = 0; num_samples <= 13; num_samples++)
+		{
+			vector<float> interleaved((size_t)channels * num_samples);
+			for (size_t sample = 0; sample < interleaved.size(); sample++)
+				interleaved[sample] = (float)sample;
+
+			vector<float> planar((size_t)channels * num_samples, -1.0f);
+			vector<float*> dest = GetChannelPointers<float*>(planar, channels, num_samples);
+			AudioConversion::Deinterleave(dest.data(), interleaved.data(), channels, num_samples);
+
+			bool is_equal = true;
+			for (int channel = 0; channel < channels; channel++)
+				for (int sample = 0; sample < num_samples; sample++)
+					is_equal = is_equal && dest[channel][sample] == (float)(sample * channels + channel);
+
+			string name = to_string(channels) + " channels, " + to_string(num_samples) + " samples";
+			VS_CHECK_MESSAGE(is_equal, "deinterleave of " + name);
+
+			vector<float> combined((size_t)channels * num_samples, -1.0f);
+			vector<const float*> src = GetChannelPointers<const float*>(planar, channels, num_samples);
+			AudioConversion::Interleave(combined.data(), src.data(), channels, num_samples);
+			VS_CHECK_MESSAGE(combined == interleaved, "interleave of " + name);
+		}
+	}
+}
+
+// Each sample format converts to floats and back to the same samples (the formats with more precision than a float
+// come back to within its precision)
+VS_TEST(AudioConversionRoundTrip)
+{
+	const int NumSamples = 1031;
+	mt19937 random(32);
+	vector<float> floats(NumSamples);
+
+	// 16-bit
+	vector<int16_t> int16_samples(NumSamples);
+	for (int index = 0; index < NumSamples; index++)
+		int16_samples[index] = (int16_t)random();
+	int16_samples[0] = -32768;
+	int16_samples[1] = 32767;
+
+	AudioConversion::Int16ToFloat(floats.data(), int16_samples.data(), 1.0f / 32768.0f, NumSamples);
+	bool is_equal = true;
+	for (int index = 0; index < NumSamples; index++)
+		is_equal = is_equal && (int16_t)lrintf(floats[index] * 32768.0f) == int16_samples[index] && fabs(floats[index]) <= 1.0f;
+	VS_CHECK_MESSAGE(is_equal, "s16");
+
+	// 32-bit (exact for the samples with 24 significant bits, the 24-bit audio stored in 32 bits)
+	vector<int32_t> int32_samples(NumSamples);
+	for (int index = 0; index < NumSamples; index++)
+		int32_samples[index] = (int32_t)(random() & 0xFFFFFF00u);
+	int32_samples[0] = INT32_MIN;
+
+	AudioConversion::Int32ToFloat(floats.data(), int32_samples.data(), 1.0f / 2147483648.0f, NumSamples);
+	is_equal = true;
+	for (int index = 0; index < NumSamples; index++)
+		is_equal = is_equal && (int32_t)llrint((double)floats[index] * 2147483648.0) == int32_samples[index];
+	VS_CHECK_MESSAGE(is_equal, "s32");
+
+	// Float (copied, and scaled by a power of two and back)
+	vector<float> float_samples(NumSamples);
+	uniform_real_distribution<double> amplitude(-1.0, 1.0);
+	for (int index = 0; index < NumSamples; index++)
+		float_samples[index] = (float)amplitude(random);
+
+	AudioConversion::FloatToFloat(floats.data(), float_samples.data(), 1.0f, NumSamples);
+	VS_CHECK_MESSAGE(floats == float_samples, "flt");
+
+	vector<float> halved(NumSamples);
+	AudioConversion::FloatToFloat(halved.data(), float_samples.data(), 0.5f, NumSamples);
+	AudioConversion::FloatToFloat(floats.data(), halved.data(), 2.0f, NumSamples);
+	VS_CHECK_MESSAGE(floats == float_samples, "flt scaled");
+
+	// Double (rounded to the nearest float)
+	vector<double> double_samples(NumSamples);
+	for (int index = 0; index < NumSamples; index++)
+		double_samples[index] = amplitude(random);
+
+	AudioConversion::DoubleToFloat(floats.data(), double_samples.data(), 1.0f, NumSamples);
+	is_equal = true;
+	for (int index = 0; index < NumSamples; index++)
+		is_equal = is_equal && floats[index] == (float)double_samples[index];
+	VS_CHECK_MESSAGE(is_equal, "dbl");
+}
+
+// The sample formats converted without avresample give the same floats as avresample
+VS_TEST(ConvertedSamplesMatchAvresample)
+{
+	const AVSampleFormat formats[] = { AV_SAMPLE_FMT_S16, AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_S32, AV_SAMPLE_FMT_S32P,
+		AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_DBL, AV_SAMPLE_FMT_DBLP };
+
+	// An odd number of samples, so every vector loop leaves some for its scalar loop
+	const int NumSamples = 1027;
+
+	mt19937 random(34);
+	AudioSampleBuffer interleaved_buffer(1, 1);
+	for (size_t format_index = 0; format_index < sizeof(formats) / sizeof(formats[0]); format_index++)
+	{
+		for (size_t channel_index = 0; channel_index < sizeof(ChannelCounts) / sizeof(ChannelCounts[0]); channel_index++)
+		{
+			AVSampleFormat sample_fmt = formats[format_index];
+			int channels = ChannelCounts[channel_index];
+			string name = string(av_get_sample_fmt_name(sample_fmt)) + " with " + to_string(channels) + " channels";
+
+			uint8_t *input[AV_NUM_DATA_POINTERS] = { NULL };
+			int input_linesize = 0;
+			av_samples_alloc(input, &input_linesize, channels, NumSamples, sample_fmt, 0);
+			int planes = av_sample_fmt_is_planar(sample_fmt) ? channels : 1;
+			for (int plane = 0; plane < planes; plane++)
+				FillSamples(input[plane], sample_fmt, NumSamples * channels / planes, random);
+
+			// The reader's conversion
+			vector<float> actual((size_t)channels * NumSamples);
+			vector<float*> channel_buffers = GetChannelPointers<float*>(actual, channels, NumSamples);
+			VS_CHECK_MESSAGE(FFmpegReader::ConvertSampleFormat(input, sample_fmt, channels, NumSamples, channel_buffers.data(), interleaved_buffer), name);
+
+			// avresample's conversion (to planar floats, with the same layout and rate)
+			int64_t layout = av_get_default_channel_layout(channels);
+			AVAudioResampleContext *avr = avresample_alloc_context();
+			av_opt_set_int(avr, "in_channel_layout", layout, 0);
+			av_opt_set_int(avr, "out_channel_layout", layout, 0);
+			av_opt_set_int(avr, "in_sample_fmt", sample_fmt, 0);
+			av_opt_set_int(avr, "out_sample_fmt", AV_SAMPLE_FMT_FLTP, 0);
+			av_opt_set_int(avr, "in_sample_rate", 48000, 0);
+			av_opt_set_int(avr, "out_sample_rate", 48000, 0);
+			VS_CHECK_MESSAGE(avresample_open(avr) == 0, name);
+
+			uint8_t *output[AV_NUM_DATA_POINTERS] = { NULL };
+			int output_linesize = 0;
+			av_samples_alloc(output, &output_linesize, channels, NumSamples, AV_SAMPLE_FMT_FLTP, 0);
+			int converted = avresample_convert(avr, output, output_linesize, NumSamples, input, input_linesize, NumSamples);
+			VS_CHECK_MESSAGE(converted == NumSamples, name);
+
+			float largest_difference = 0.0f;
+			for (int channel = 0; channel < channels; channel++)
+				for (int sample = 0; sample < NumSamples; sample++)
+					largest_difference = max(largest_difference, fabs(channel_buffers[channel][sample] - ((const float*)output[channel])[sample]));
+			VS_CHECK_MESSAGE(largest_difference <= 1e-7f, name + " differs by " + to_string(largest_difference));
+
+			avresample_close(avr);
+			avresample_free(&avr);
+			av_freep(&output[0]);
+			av_freep(&input[0]);
+		}
+	}
+
+	// The other formats are left to avresample
+	vector<float> samples(2);
+	vector<float*> channel_buffers = GetChannelPointers<float*>(samples, 1, 2);
+	uint8_t u8_samples[2] = { 0, 255 };
+	uint8_t *input[1] = { u8_samples };
+	VS_CHECK(!FFmpegReader::ConvertSampleFormat(input, AV_SAMPLE_FMT_U8, 1, 2, channel_buffers.data(), interleaved_buffer));
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,212 @@
+/*
+@file		buffer_pool_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of PixelBufferPool, and of the frames laid out in its buffers
+*/
+
+// STD
+#include <cstdint>
+#include <cstring>
+
+#include "buffer_pool.hpp"
+#include "frame.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+// Released buffers go back to the pool (up to its max free buffers) and are handed out again, and buffers of another
+// size are freed instead
+VS_TEST(PixelBufferPoolRecyclesBuffers)
+{
+	QSharedPointer<PixelBufferPool> pool(new PixelBufferPool(1000, 2));
+
+	PixelBuffer *buffers[3];
+	for (int index = 0; index < 3; index++)
+	{
+		buffers[index] = pool->Acquire();
+		VS_CHECK(buffers[index]->size == 1000);
+		VS_CHECK(((uintptr_t)buffers[index]->data & (PixelBufferPool::Alignment - 1)) == 0);
+		VS_CHECK(buffers[index]->pool == pool);
+	}
+
+	// A buffer with another reference isn't recycled until the last one is dropped
+	PixelBufferPool::Retain(buffers[0]);
+	PixelBufferPool::Release(buffers[0]);
+	VS_CHECK(pool->CountFree() == 0);
+
+	// The third buffer doesn't fit in the pool
+	for (int index = 0; index < 3; index++)
+		PixelBufferPool::Release(buffers[index]);
+	VS_CHECK(pool->CountFree() == 2);
+
+	PixelBuffer *recycled = pool->Acquire();
+	VS_CHECK(recycled == buffers[0] || recycled == buffers[1]);
+	VS_CHECK(recycled->references == 1 && recycled->pool == pool);
+	VS_CHECK(pool->CountFree() == 1);
+
+	// A new size frees the buffers of the old one, even the ones still out
+	pool->SetBufferSize(2000);
+	VS_CHECK(pool->CountFree() == 0);
+	PixelBufferPool::Release(recycled);
+	VS_CHECK(pool->CountFree() == 0);
+	VS_CHECK(pool->GetBufferSize() == 2000);
+
+	// Buffers without a pool are freed
+	PixelBuffer *unpooled = PixelBufferPool::AcquireUnpooled(64);
+	VS_CHECK(!unpooled->pool && unpooled->size == 64);
+	PixelBufferPool::Release(unpooled);
+
+	pool->Clear();
+	VS_CHECK(pool->CountFree() == 0);
+}
+
+// A buffer keeps its pool alive, so frames can outlive their reader
+VS_TEST(PixelBuffersKeepTheirPoolAlive)
+{
+	QSharedPointer<PixelBufferPool> pool(new PixelBufferPool(256, 4));
+	QWeakPointer<PixelBufferPool> weak_pool = pool;
+
+	PixelBuffer *buffer = pool->Acquire();
+	pool.reset();
+	VS_CHECK(!weak_pool.isNull());
+
+	// Buffers sitting in the pool don't keep it alive
+	PixelBufferPool::Release(buffer);
+	VS_CHECK(weak_pool.isNull());
+}
+
+// The decoded pixels are written in place into the image plane of the frame's storage, which the image wraps without a
+// copy (with the padded lines the scaler wrote)
+VS_TEST(StorageImageWrapsThePixelsInPlace)
+{
+	const int Width = 100;
+	const int Height = 20;
+	const int Samples = 1600;
+	const int Channels = 2;
+
+	int stride = PixelBufferPool::GetAlignedStride(Width, 4);
+	VS_CHECK(stride == 448);
+
+	QSharedPointer<PixelBufferPool> pool(new PixelBufferPool(Frame::GetStorageSize(stride, Height, Samples, Channels), 2));
+	Frame frame(1, Width, Height, stride, Samples, Channels, pool->Acquire());
+
+	// Another size doesn't fit the plane
+	int bytes_per_line = 0;
+	VS_CHECK(frame.GetStoragePixels(Width / 2, Height, bytes_per_line) == NULL);
+
+	unsigned char *pixels = frame.GetStoragePixels(Width, Height, bytes_per_line);
+	VS_CHECK(pixels != NULL && bytes_per_line == stride);
+	for (int y = 0; y < Height; y++)
+		memset(pixels + (size_t)y * bytes_per_line, y, (size_t)Width * 4);
+
+	frame.AddStorageImage(QImage::Format_RGBA8888);
+	QSharedPointer<QImage> image = frame.GetImage();
+	VS_CHECK(image->constBits() == pixels);
+	VS_CHECK(image->bytesPerLine() == stride);
+	VS_CHECK(image->width() == Width && image->height() == Height);
+	VS_CHECK(image->constScanLine(Height - 1)[Width * 4 - 1] == Height - 1);
+
+	// The plane is only handed out once
+	VS_CHECK(frame.GetStoragePixels(Width, Height, bytes_per_line) == NULL);
+}
+
+// A frame sharing the image of another one (a missing or duplicate frame) keeps only its audio in a pooled buffer,
+// which goes back to the pool with the frame, while the shared pixels stay with the frame they came from
+VS_TEST(SharedImageFramesRecycleTheirAudioStorage)
+{
+	const int Width = 640;
+	const int Height = 360;
+	const int Samples = 1601;
+	const int Channels = 2;
+
+	int stride = PixelBufferPool::GetAlignedStride(Width, 4);
+	QSharedPointer<PixelBufferPool> pixel_pool(new PixelBufferPool(Frame::GetStorageSize(stride, Height, Samples, Channels), 4));
+	QSharedPointer<PixelBufferPool> audio_pool(new PixelBufferPool(Frame::GetStorageSize(0, 0, Samples, Channels), 4));
+
+	QSharedPointer<Frame> parent = QSharedPointer<Frame>::create(1, Width, Height, stride, Samples, Channels, pixel_pool->Acquire());
+	int bytes_per_line = 0;
+	VS_CHECK(parent->GetStoragePixels(Width, Height, bytes_per_line) != NULL);
+	parent->AddStorageImage(QImage::Format_RGBA8888);
+
+	PixelBuffer *audio_storage = audio_pool->Acquire();
+	{
+		Frame missing(2, Width, Height, 0, Samples, Channels, audio_storage);
+		missing.AddImage(QSharedPointer<QImage>::create(*parent->GetImage()));
+
+		// The audio is in the pooled buffer, and there is no image plane to write to
+		VS_CHECK(missing.GetAudioSamples(0) >= (float*)audio_storage->data);
+		VS_CHECK(missing.GetAudioSamples(Channels - 1) + Samples <= (float*)(audio_storage->data + audio_storage->size));
+		VS_CHECK(missing.GetStoragePixels(Width, Height, bytes_per_line) == NULL);
+		VS_CHECK(missing.GetImage()->constBits() == parent->GetImage()->constBits());
+		VS_CHECK(audio_pool->CountFree() == 0);
+	}
+
+	// The next missing frame gets the same buffer back
+	VS_CHECK(audio_pool->CountFree() == 1);
+	VS_CHECK(audio_pool->Acquire() == audio_storage);
+	PixelBufferPool::Release(audio_storage);
+
+	// The image plane goes back to its pool with the last frame showing it
+	VS_CHECK(pixel_pool->CountFree() == 0);
+	parent.reset();
+	VS_CHECK(pixel_pool->CountFree() == 1);
+}
+
+// A copy of a frame shares its pixels and lays its samples out in a storage of its own, so the original frame's storage
+// goes back to the pool as soon as nothing shows its image
+VS_TEST(CopiedFramesHaveTheirOwnStorage)
+{
+	const int Width = 64;
+	const int Height = 36;
+	const int Samples = 800;
+	const int Channels = 6;
+
+	int stride = PixelBufferPool::GetAlignedStride(Width, 4);
+	QSharedPointer<PixelBufferPool> pool(new PixelBufferPool(Frame::GetStorageSize(stride, Height, Samples, Channels), 4));
+
+	QSharedPointer<Frame> original = QSharedPointer<Frame>::create(7, Width, Height, stride, Samples, Channels, pool->Acquire());
+	int bytes_per_line = 0;
+	memset(original->GetStoragePixels(Width, Height, bytes_per_line), 0x80, (size_t)bytes_per_line * Height);
+	original->AddStorageImage(QImage::Format_RGBA8888);
+	for (int channel = 0; channel < Channels; channel++)
+		for (int sample = 0; sample < Samples; sample++)
+			original->GetAudioSamples(channel)[sample] = (float)(channel * Samples + sample);
+
+	Frame copy(*original);
+	VS_CHECK(copy.number == 7);
+	VS_CHECK(copy.GetAudioChannelsCount() == Channels && copy.GetAudioSamplesCount() == Samples);
+	VS_CHECK(copy.GetImage()->constBits() == original->GetImage()->constBits());
+	VS_CHECK(copy.GetStoragePixels(Width, Height, bytes_per_line) == NULL);
+
+	bool is_equal = true;
+	for (int channel = 0; channel < Channels; channel++)
+	{
+		VS_CHECK(copy.GetAudioSamples(channel) != original->GetAudioSamples(channel));
+		for (int sample = 0; sample < Samples; sample++)
+			is_equal = is_equal && copy.GetAudioSamples(channel)[sample] == (float)(channel * Samples + sample);
+	}
+	VS_CHECK(is_equal);
+
+	// The copy's image still holds the original storage, its audio doesn't
+	original.reset();
+	VS_CHECK(pool->CountFree() == 0);
+	copy.AddImage(QSharedPointer<QImage>::create(Width, Height, QImage::Format_RGBA8888));
+	VS_CHECK(pool->CountFree() == 1);
+	VS_CHECK(copy.GetAudioSamples(Channels - 1)[Samples - 1] == (float)(Channels * Samples - 1));
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
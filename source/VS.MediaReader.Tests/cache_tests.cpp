@@ -0,0 +1,174 @@
+/*
+@file		cache_tests.cpp
+@author		Webstar
+@date		2026-10-19 13:05
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of FrameCache
+*/
+
+// STD
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cache.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+// The statistics count the lookups, the new frames and the evictions by reason, and restart from the resident frames
+VS_TEST(CacheStatsCountLookupsAndEvictions)
+{
+	// Room for 25 frames (the cache always keeps at least 20)
+	long long int frame_bytes = Frame(1, 16, 16, "#000000").GetBytes();
+	FrameCache cache(frame_bytes * 25);
+
+	for (long int number = 1; number <= 30; number++)
+		cache.Add(QSharedPointer<Frame>(new Frame(number, 16, 16, "#000000")));
+
+	// The oldest frames made room for the newest ones
+	CacheStats stats = cache.GetStats();
+	VS_CHECK(stats.inserts == 30);
+	VS_CHECK(stats.evictions[EVICTION_CAPACITY] == 5);
+	VS_CHECK(stats.frames == 25 && stats.bytes == frame_bytes * 25);
+	VS_CHECK(stats.peak_bytes == frame_bytes * 25);
+	VS_CHECK(!cache.Contains(5) && cache.Contains(6));
+
+	// Only GetFrame counts as a lookup, and adding a cached frame again is not an insert
+	VS_CHECK(cache.GetFrame(30));
+	VS_CHECK(cache.GetFrame(6));
+	VS_CHECK(!cache.GetFrame(1));
+	cache.Contains(2);
+	cache.GetClosestFrame(2, 10);
+	cache.Add(cache.GetFrame(10));
+
+	stats = cache.GetStats();
+	VS_CHECK(stats.hits == 3 && stats.misses == 1);
+	VS_CHECK(stats.inserts == 30);
+
+	// Removed and cleared frames
+	cache.Remove(20, 22);
+	VS_CHECK(cache.GetStats().evictions[EVICTION_REMOVED] == 3);
+	cache.Clear();
+
+	stats = cache.ResetStats();
+	VS_CHECK(stats.evictions[EVICTION_CLEARED] == 22);
+	VS_CHECK(stats.frames == 0 && stats.bytes == 0);
+	VS_CHECK(stats.average_residency >= 0.0 && stats.average_residency <= stats.elapsed);
+
+	// The counters restart
+	stats = cache.GetStats();
+	VS_CHECK(stats.hits == 0 && stats.misses == 0 && stats.inserts == 0 && stats.peak_bytes == 0);
+	for (int reason = 0; reason < EVICTION_REASON_COUNT; reason++)
+		VS_CHECK(stats.evictions[reason] == 0);
+}
+
+// The pinned ranges stop at the max pinned bytes, and Pin() reports the part of each range which fits
+VS_TEST(PinnedRangesFitInMaxPinnedBytes)
+{
+	FrameCache cache;
+	cache.SetMaxBytesFromInfo(8, 1920, 1080, 48000, 2);
+
+	// Room for 10 frames
+	const long long int frame_bytes = 1920LL * 1080 * 4 + 48000 * 2 * 4;
+	cache.SetMaxPinnedBytes(frame_bytes * 10);
+
+	VS_CHECK(cache.Pin(1, 6) == 6);
+	VS_CHECK(cache.Pin(100, 200) == 103);
+	VS_CHECK(cache.Pin(300, 310) == 299);
+	VS_CHECK(cache.IsPinned(103));
+	VS_CHECK(!cache.IsPinned(104));
+
+	// Unpinning makes room again
+	cache.Unpin(1, 6);
+	VS_CHECK(cache.Pin(300, 310) == 305);
+
+	// No limit
+	cache.SetMaxPinnedBytes(0);
+	VS_CHECK(cache.Pin(1000, 5000) == 5000);
+}
+
+// The pins are counted per frame: evicting a range only removes the frames no overlapping range still pins
+VS_TEST(OverlappingPinnedRangesAreCounted)
+{
+	FrameCache cache;
+	for (long int number = 10; number <= 25; number++)
+		cache.Add(QSharedPointer<Frame>(new Frame(number, 16, 16, "#000000")));
+
+	VS_CHECK(cache.Pin(10, 20) == 20);
+	VS_CHECK(cache.Pin(15, 25) == 25);
+
+	// Release the first range, as FFmpegReader::Evict does
+	cache.Unpin(10, 20);
+	cache.RemoveUnpinned(10, 20);
+
+	for (long int number = 10; number <= 14; number++)
+		VS_CHECK_MESSAGE(!cache.IsPinned(number) && !cache.Contains(number), "frame " + to_string(number));
+	for (long int number = 15; number <= 25; number++)
+		VS_CHECK_MESSAGE(cache.IsPinned(number) && cache.Contains(number), "frame " + to_string(number));
+
+	vector<pair<long int, long int>> ranges = cache.GetPinnedRanges();
+	VS_CHECK(ranges.size() == 1 && ranges[0] == make_pair(15L, 25L));
+
+	// The same range pinned twice needs two releases
+	VS_CHECK(cache.Pin(15, 25) == 25);
+	cache.Unpin(15, 25);
+	cache.RemoveUnpinned(15, 25);
+	VS_CHECK(cache.IsPinned(15) && cache.Contains(25));
+
+	// A release spanning several ranges takes one pin from each frame (and leaves the parts outside it)
+	VS_CHECK(cache.Pin(5, 17) == 17);
+	cache.Unpin(12, 30);
+	ranges = cache.GetPinnedRanges();
+	VS_CHECK(ranges.size() == 2 && ranges[0] == make_pair(5L, 11L) && ranges[1] == make_pair(15L, 17L));
+
+	cache.Unpin(1, 100);
+	cache.RemoveUnpinned(1, 100);
+	VS_CHECK(cache.GetPinnedRanges().empty());
+	VS_CHECK(cache.Count() == 0);
+}
+
+// A duplicate frame sharing the image of the previous frame (as enable_frame_dedup does) only counts its pixels once
+VS_TEST(SharedImagesAreCountedOnce)
+{
+	FrameCache cache;
+	QSharedPointer<Frame> first(new Frame(1, 64, 32, "#204080"));
+	cache.Add(first);
+	long long int first_bytes = cache.GetBytes();
+	long long int image_bytes = first->GetImageBytes();
+	VS_CHECK(image_bytes == 64 * 32 * 4);
+
+	// A copy of the QImage shares its pixels (copy-on-write)
+	QSharedPointer<Frame> duplicate(new Frame(2, 64, 32, "#000000"));
+	duplicate->AddImage(QSharedPointer<QImage>(new QImage(*first->GetImage())));
+	VS_CHECK(duplicate->GetImageKey() == first->GetImageKey());
+
+	cache.Add(duplicate);
+	VS_CHECK(cache.GetStats().shared_bytes == image_bytes);
+	VS_CHECK(cache.GetBytes() == first_bytes + duplicate->GetBytes() - image_bytes);
+
+	// A frame with pixels of its own counts them
+	QSharedPointer<Frame> other(new Frame(3, 64, 32, "#204080"));
+	VS_CHECK(other->GetImageKey() != first->GetImageKey());
+	cache.Add(other);
+	VS_CHECK(cache.GetStats().shared_bytes == image_bytes);
+
+	// Once the first frame is gone, the duplicate counts the pixels
+	cache.Remove(1);
+	VS_CHECK(cache.GetStats().shared_bytes == 0);
+	VS_CHECK(cache.GetBytes() == duplicate->GetBytes() + other->GetBytes());
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 13:05
+#vNext
+=============================================================
+*/
@@ -0,0 +1,212 @@
+/*
+@file		float_vector_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Checks the vector kernels give the same bits as the scalar kernels, and times them
+*/
+
+// STD
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "float_vector_operations.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	const char *InstructionSetNames[VECTOR_INSTRUCTION_SET_COUNT] = { "scalar", "sse2", "avx2", "avx512" };
+
+	// The largest array of the comparisons (more than two AVX-512 registers, plus values left over)
+	const int MaxValues = 67;
+
+	// The arrays start this many values past an aligned address (so the loads are misaligned too)
+	const int MaxOffset = 3;
+
+	/// Random values of one type, with a few zeros of both signs (min / max must pick the same one as the scalar loop)
+	template <typename Type>
+	vector<Type> GetRandomValues(mt19937 &random, int count)
+	{
+		uniform_real_distribution<double> distribution(-2.0, 2.0);
+		vector<Type> values(count);
+		for (int index = 0; index < count; index++)
+			values[index] = (Type)distribution(random);
+
+		for (int index = 0; index < count; index += 7)
+			values[index] = (index % 2) ? (Type)-0.0 : (Type)0.0;
+
+		return values;
+	}
+
+	/// Run an operation on one instruction set, and return its output
+	template <typename Type>
+	vector<Type> RunOperation(VectorInstructionSet set, const vector<Type> &initial, const function<void(Type *dest)> &operation)
+	{
+		FloatVectorOperations::setInstructionSet(set);
+
+		vector<Type> output(initial);
+		operation(output.data());
+		return output;
+	}
+
+	/// Check an operation gives the same bits on an instruction set as on the scalar kernels
+	template <typename Type>
+	void CheckOperation(VectorInstructionSet set, const char *name, int count, const vector<Type> &initial, const function<void(Type *dest)> &operation)
+	{
+		vector<Type> expected = RunOperation(VECTOR_SCALAR, initial, operation);
+		vector<Type> actual = RunOperation(set, initial, operation);
+
+		string message = string(name) + " differs on " + InstructionSetNames[set] + " for " + to_string(count) + " values";
+		VS_CHECK_MESSAGE(memcmp(expected.data(), actual.data(), expected.size() * sizeof(Type)) == 0, message);
+	}
+
+	/// Check every operation of one type, for every size up to MaxValues, and every misalignment up to MaxOffset
+	template <typename Type>
+	void CheckOperations(VectorInstructionSet set)
+	{
+		mt19937 random(1234);
+
+		for (int offset = 0; offset <= MaxOffset; offset++)
+		{
+			for (int count = 0; count <= MaxValues; count++)
+			{
+				vector<Type> a = GetRandomValues<Type>(random, MaxValues + MaxOffset);
+				vector<Type> b = GetRandomValues<Type>(random, MaxValues + MaxOffset);
+				vector<Type> initial = GetRandomValues<Type>(random, MaxValues + MaxOffset);
+				const Type *src1 = a.data() + offset;
+				const Type *src2 = b.data() + offset;
+				const Type value = (Type)0.7;
+
+				CheckOperation<Type>(set, "fill", count, initial, [&](Type *dest) { FloatVectorOperations::fill(dest + offset, value, count); });
+				CheckOperation<Type>(set, "copyWithMultiply", count, initial, [&](Type *dest) { FloatVectorOperations::copyWithMultiply(dest + offset, src1, value, count); });
+				CheckOperation<Type>(set, "add value", count, initial, [&](Type *dest) { FloatVectorOperations::add(dest + offset, value, count); });
+				CheckOperation<Type>(set, "add src value", count, initial, [&](Type *dest) { FloatVectorOperations::add(dest + offset, src1, value, count); });
+				CheckOperation<Type>(set, "add src", count, initial, [&](Type *dest) { FloatVectorOperations::add(dest + offset, src1, count); });
+				CheckOperation<Type>(set, "add src1 src2", count, initial, [&](Type *dest) { FloatVectorOperations::add(dest + offset, src1, src2, count); });
+				CheckOperation<Type>(set, "subtract src", count, initial, [&](Type *dest) { FloatVectorOperations::subtract(dest + offset, src1, count); });
+				CheckOperation<Type>(set, "subtract src1 src2", count, initial, [&](Type *dest) { FloatVectorOperations::subtract(dest + offset, src1, src2, count); });
+				CheckOperation<Type>(set, "addWithMultiply value", count, initial, [&](Type *dest) { FloatVectorOperations::addWithMultiply(dest + offset, src1, value, count); });
+				CheckOperation<Type>(set, "addWithMultiply src1 src2", count, initial, [&](Type *dest) { FloatVectorOperations::addWithMultiply(dest + offset, src1, src2, count); });
+				CheckOperation<Type>(set, "subtractWithMultiply value", count, initial, [&](Type *dest) { FloatVectorOperations::subtractWithMultiply(dest + offset, src1, value, count); });
+				CheckOperation<Type>(set, "subtractWithMultiply src1 src2", count, initial, [&](Type *dest) { FloatVectorOperations::subtractWithMultiply(dest + offset, src1, src2, count); });
+				CheckOperation<Type>(set, "multiply src", count, initial, [&](Type *dest) { FloatVectorOperations::multiply(dest + offset, src1, count); });
+				CheckOperation<Type>(set, "multiply src1 src2", count, initial, [&](Type *dest) { FloatVectorOperations::multiply(dest + offset, src1, src2, count); });
+				CheckOperation<Type>(set, "multiply value", count, initial, [&](Type *dest) { FloatVectorOperations::multiply(dest + offset, value, count); });
+				CheckOperation<Type>(set, "multiply src value", count, initial, [&](Type *dest) { FloatVectorOperations::multiply(dest + offset, src1, value, count); });
+				CheckOperation<Type>(set, "negate", count, initial, [&](Type *dest) { FloatVectorOperations::negate(dest + offset, src1, count); });
+				CheckOperation<Type>(set, "abs", count, initial, [&](Type *dest) { FloatVectorOperations::abs(dest + offset, src1, count); });
+				CheckOperation<Type>(set, "min value", count, initial, [&](Type *dest) { FloatVectorOperations::min(dest + offset, src1, (Type)0.0, count); });
+				CheckOperation<Type>(set, "min src1 src2", count, initial, [&](Type *dest) { FloatVectorOperations::min(dest + offset, src1, src2, count); });
+				CheckOperation<Type>(set, "max value", count, initial, [&](Type *dest) { FloatVectorOperations::max(dest + offset, src1, (Type)-0.0, count); });
+				CheckOperation<Type>(set, "max src1 src2", count, initial, [&](Type *dest) { FloatVectorOperations::max(dest + offset, src1, src2, count); });
+				CheckOperation<Type>(set, "clip", count, initial, [&](Type *dest) { FloatVectorOperations::clip(dest + offset, src1, (Type)-0.5, (Type)0.5, count); });
+				CheckOperation<Type>(set, "findMinAndMax", count, initial, [&](Type *dest) { FloatVectorOperations::findMinAndMax(src1, count, dest[0], dest[1]); });
+				CheckOperation<Type>(set, "findMinimum", count, initial, [&](Type *dest) { dest[0] = FloatVectorOperations::findMinimum(src1, count); });
+				CheckOperation<Type>(set, "findMaximum", count, initial, [&](Type *dest) { dest[0] = FloatVectorOperations::findMaximum(src1, count); });
+			}
+		}
+	}
+
+	/// Restores the instruction set picked for the CPU, when a test returns (or throws)
+	struct InstructionSetScope
+	{
+		VectorInstructionSet previous;
+		InstructionSetScope() : previous(FloatVectorOperations::getInstructionSet()) {}
+		~InstructionSetScope() { FloatVectorOperations::setInstructionSet(previous); }
+	};
+}
+
+// Every instruction set the CPU supports gives the same bits as the scalar kernels (on this compiler and its flags)
+VS_TEST(FloatVectorKernelsMatchScalar)
+{
+	InstructionSetScope scope;
+
+	int checked = 0;
+	for (int set = VECTOR_SSE2; set < VECTOR_INSTRUCTION_SET_COUNT; set++)
+	{
+		if (!FloatVectorOperations::isInstructionSetSupported((VectorInstructionSet)set))
+			continue;
+
+		CheckOperations<float>((VectorInstructionSet)set);
+		CheckOperations<double>((VectorInstructionSet)set);
+
+		// The integer conversion only has a float version
+		mt19937 random(5678);
+		for (int count = 0; count <= MaxValues; count++)
+		{
+			vector<int> integers(count);
+			for (int index = 0; index < count; index++)
+				integers[index] = (int)random() - (int)(random.max() / 2);
+
+			vector<float> initial(MaxValues, 0.0f);
+			CheckOperation<float>((VectorInstructionSet)set, "convertFixedToFloat", count, initial, [&](float *dest) {
+				FloatVectorOperations::convertFixedToFloat(dest, integers.data(), 1.0f / 0x7fffffff, count); });
+		}
+
+		checked++;
+	}
+
+	if (checked == 0)
+		VS_SKIP("the CPU only supports the scalar kernels");
+}
+
+// The time per value of the most used operations, on every instruction set the CPU supports
+VS_BENCHMARK(FloatVectorKernels)
+{
+	InstructionSetScope scope;
+
+	const int count = 4096;
+	const int repeats = 20000;
+
+	mt19937 random(1234);
+	vector<float> src = GetRandomValues<float>(random, count);
+	vector<float> dest = GetRandomValues<float>(random, count);
+
+	for (int set = VECTOR_SCALAR; set < VECTOR_INSTRUCTION_SET_COUNT; set++)
+	{
+		if (!FloatVectorOperations::setInstructionSet((VectorInstructionSet)set))
+			continue;
+
+		const string prefix = string(InstructionSetNames[set]) + " ";
+		const double values = (double)count * repeats;
+
+		Stopwatch stopwatch;
+		for (int repeat = 0; repeat < repeats; repeat++)
+			FloatVectorOperations::multiply(dest.data(), src.data(), 0.5f, count);
+		ReportBenchmark(prefix + "multiply", stopwatch.GetSeconds() * 1e9 / values, "ns/value");
+
+		stopwatch.Restart();
+		for (int repeat = 0; repeat < repeats; repeat++)
+			FloatVectorOperations::addWithMultiply(dest.data(), src.data(), 0.5f, count);
+		ReportBenchmark(prefix + "addWithMultiply", stopwatch.GetSeconds() * 1e9 / values, "ns/value");
+
+		stopwatch.Restart();
+		for (int repeat = 0; repeat < repeats; repeat++)
+			FloatVectorOperations::clip(dest.data(), src.data(), -1.0f, 1.0f, count);
+		ReportBenchmark(prefix + "clip", stopwatch.GetSeconds() * 1e9 / values, "ns/value");
+
+		float lowest = 0.0f, highest = 0.0f;
+		stopwatch.Restart();
+		for (int repeat = 0; repeat < repeats; repeat++)
+			FloatVectorOperations::findMinAndMax(src.data(), count, lowest, highest);
+		ReportBenchmark(prefix + "findMinAndMax", stopwatch.GetSeconds() * 1e9 / values, "ns/value");
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
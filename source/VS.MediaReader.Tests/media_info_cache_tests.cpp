@@ -0,0 +1,97 @@
+/*
+@file		media_info_cache_tests.cpp
+@author		Webstar
+@date		2026-10-19 14:20
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of MediaInfoCache
+*/
+
+// QT
+#include <QDir>
+#include <QFile>
+
+#include "media_info_cache.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	/// A snapshot of a file with a H.264 video stream with B-frames
+	MediaInfoSnapshot GetSnapshot(int width)
+	{
+		MediaInfoSnapshot snapshot = MediaInfoSnapshot();
+		snapshot.info.has_video = true;
+		snapshot.info.width = width;
+		snapshot.video_pts_offset = 99999;
+		snapshot.audio_pts_offset = 99999;
+		snapshot.stream_count = 1;
+		snapshot.video = StreamParameters();
+		snapshot.video.index = 0;
+		snapshot.video.width = width;
+		snapshot.video.video_delay = 2;
+		snapshot.video.bits_per_raw_sample = 8;
+		snapshot.video.extradata = QByteArray("\x01\x64\x00\x28", 4);
+		snapshot.audio = StreamParameters();
+		snapshot.audio.index = -1;
+		return snapshot;
+	}
+}
+
+// The least recently used snapshots are removed first, once the cache is full
+VS_TEST(MediaInfoCacheRemovesLeastRecentlyUsed)
+{
+	MediaInfoCache cache;
+	cache.SetMaxSnapshots(2);
+
+	cache.Store("a", GetSnapshot(1));
+	cache.Store("b", GetSnapshot(2));
+
+	MediaInfoSnapshot snapshot;
+	VS_CHECK(cache.Find("a", snapshot));
+
+	cache.Store("c", GetSnapshot(3));
+	VS_CHECK(cache.Count() == 2);
+	VS_CHECK(cache.Find("a", snapshot) && snapshot.info.width == 1);
+	VS_CHECK(!cache.Find("b", snapshot));
+	VS_CHECK(cache.Find("c", snapshot) && snapshot.info.width == 3);
+
+	cache.SetMaxSnapshots(1);
+	VS_CHECK(cache.Count() == 1);
+	VS_CHECK(cache.Find("c", snapshot));
+}
+
+// The parameters of the streams survive a save and a load (i.e. the decoder delay of B-frames)
+VS_TEST(MediaInfoCacheSavesStreamParameters)
+{
+	const QString path = QDir::temp().filePath("vs_media_info_cache_test.mediainfo");
+
+	MediaInfoCache saved;
+	saved.Store("a", GetSnapshot(1920));
+	VS_CHECK(saved.Save(path));
+
+	MediaInfoCache loaded;
+	VS_CHECK(loaded.Load(path));
+	QFile::remove(path);
+
+	MediaInfoSnapshot snapshot;
+	VS_CHECK(loaded.Find("a", snapshot));
+	VS_CHECK(snapshot.video.width == 1920);
+	VS_CHECK(snapshot.video.video_delay == 2);
+	VS_CHECK(snapshot.video.bits_per_raw_sample == 8);
+	VS_CHECK(snapshot.video.extradata == QByteArray("\x01\x64\x00\x28", 4));
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 14:20
+#vNext
+=============================================================
+*/
@@ -0,0 +1,132 @@
+/*
+@file		multi_cursor_reader_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests and benchmarks of MultiCursorReader (on the file of VS_TEST_MEDIA)
+*/
+
+// STD
+#include <algorithm>
+#include <string>
+
+#include "multi_cursor_reader.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	/// The frames of an A/B compare: a region at a quarter of the file, and one at three quarters
+	void GetRegions(long int video_length, long int &region_a, long int &region_b)
+	{
+		region_a = max(1L, video_length / 4);
+		region_b = max(1L, video_length * 3 / 4);
+	}
+
+	/// Alternate between the two regions, one frame forward each time (returns the seconds per jump)
+	double AlternateRegions(MultiCursorReader &reader, long int region_a, long int region_b, int jumps)
+	{
+		Stopwatch stopwatch;
+		for (int jump = 0; jump < jumps; jump++)
+			reader.GetFrame(((jump % 2) ? region_b : region_a) + jump / 2);
+
+		return stopwatch.GetSeconds() / jumps;
+	}
+}
+
+// The cursors opened on demand get the settings of the reader (a cursor without audio has frames without audio)
+VS_TEST(MultiCursorReaderCopiesSettings)
+{
+	MultiCursorReader reader(GetTestMedia(), 2);
+	reader.enable_audio = false;
+	reader.enable_prefetch = false;
+	reader.info_cache = NULL;
+	reader.Open();
+
+	if (reader.info.video_length < 100)
+		VS_SKIP("the test media is too short");
+
+	VS_CHECK(!reader.info.has_audio);
+
+	long int region_a = 0;
+	long int region_b = 0;
+	GetRegions(reader.info.video_length, region_a, region_b);
+
+	VS_CHECK(reader.GetFrame(region_a)->GetAudioChannelsCount() == 0);
+	VS_CHECK(reader.GetFrame(region_b)->GetAudioChannelsCount() == 0);
+	VS_CHECK(reader.GetCursorCount() == 2);
+
+	reader.Close();
+}
+
+// Once each region has a cursor, alternating between them only decodes the requested frames (no seek, no GOP)
+VS_TEST(MultiCursorReaderAlternatesWithoutSeeking)
+{
+	MultiCursorReader reader(GetTestMedia(), 2);
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	if (reader.info.video_length < 100)
+		VS_SKIP("the test media is too short");
+
+	long int region_a = 0;
+	long int region_b = 0;
+	GetRegions(reader.info.video_length, region_a, region_b);
+
+	// Position a cursor in each region
+	reader.GetFrame(region_a);
+	reader.GetFrame(region_b);
+	VS_CHECK(reader.GetCursorCount() == 2);
+
+	// Each jump steps its cursor forward (the frames just after a request may be decoded with it already)
+	const int Jumps = 20;
+	long long int decoded = reader.GetDecodedVideoFrames();
+	for (int jump = 2; jump < Jumps + 2; jump++)
+		reader.GetFrame(((jump % 2) ? region_b : region_a) + jump / 2);
+
+	long long int jump_decoded = reader.GetDecodedVideoFrames() - decoded;
+	VS_CHECK_MESSAGE(jump_decoded <= 2 * Jumps, to_string(jump_decoded) + " frames decoded for " + to_string(Jumps) + " jumps");
+
+	reader.Close();
+}
+
+// The time of a jump of an A/B compare, with a single cursor (a seek every jump) and with a cursor per region
+VS_BENCHMARK(MultiCursorReaderAlternatingJumps)
+{
+	const int Jumps = 40;
+
+	for (int cursors = 1; cursors <= 2; cursors++)
+	{
+		MultiCursorReader reader(GetTestMedia(), cursors);
+		reader.enable_prefetch = false;
+		reader.Open();
+
+		long int region_a = 0;
+		long int region_b = 0;
+		GetRegions(reader.info.video_length, region_a, region_b);
+
+		// The first two jumps open and position the cursors
+		reader.GetFrame(region_a);
+		reader.GetFrame(region_b);
+
+		double seconds = AlternateRegions(reader, region_a + 1, region_b + 1, Jumps);
+		ReportBenchmark(to_string(cursors) + " cursor(s): time per A/B jump", seconds * 1000.0, "ms");
+
+		reader.Close();
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,102 @@
+/*
+@file		pixel_operations_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of PixelOperations (the hash and the comparison which find duplicate frames)
+*/
+
+// STD
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pixel_operations.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	/// An image with padded lines (the padding is random, so it differs between two copies of the image)
+	struct PaddedImage
+	{
+		vector<unsigned char> pixels;
+		int line_bytes;
+		int height;
+		int bytes_per_line;
+
+		PaddedImage(const vector<unsigned char> &image, int line_bytes, int height, int padding, mt19937 &random)
+			: pixels((size_t)(line_bytes + padding) * height), line_bytes(line_bytes), height(height), bytes_per_line(line_bytes + padding)
+		{
+			for (size_t index = 0; index < pixels.size(); index++)
+				pixels[index] = (unsigned char)random();
+
+			for (int y = 0; y < height; y++)
+				for (int x = 0; x < line_bytes; x++)
+					pixels[(size_t)y * bytes_per_line + x] = image[(size_t)y * line_bytes + x];
+		}
+
+		uint64_t Hash() const { return PixelOperations::Hash(pixels.data(), line_bytes, height, bytes_per_line); }
+	};
+}
+
+// The same pixels hash and compare equal whatever the padding of their lines, and a single changed byte (in the
+// vector loops or in the bytes after them) makes them differ
+VS_TEST(DuplicateImagesHashAndCompareEqual)
+{
+	mt19937 random(32);
+
+	// Line sizes around the 16, 32 and 64 byte steps of the loops
+	const int LineBytes[] = { 4, 15, 16, 33, 64, 100, 1920 * 4 };
+	const int Height = 9;
+
+	for (size_t size_index = 0; size_index < sizeof(LineBytes) / sizeof(LineBytes[0]); size_index++)
+	{
+		int line_bytes = LineBytes[size_index];
+		string name = to_string(line_bytes) + " bytes per line";
+
+		vector<unsigned char> image((size_t)line_bytes * Height);
+		for (size_t index = 0; index < image.size(); index++)
+			image[index] = (unsigned char)random();
+
+		PaddedImage first(image, line_bytes, Height, 0, random);
+		PaddedImage second(image, line_bytes, Height, 28, random);
+
+		VS_CHECK_MESSAGE(first.Hash() == second.Hash(), name);
+		VS_CHECK_MESSAGE(PixelOperations::Equal(first.pixels.data(), first.bytes_per_line, second.pixels.data(), second.bytes_per_line, line_bytes, Height), name);
+
+		// Change the first, a middle and the last byte of a line
+		const int Offsets[] = { 0, line_bytes / 2, line_bytes - 1 };
+		for (size_t offset_index = 0; offset_index < sizeof(Offsets) / sizeof(Offsets[0]); offset_index++)
+		{
+			vector<unsigned char> changed = image;
+			changed[(size_t)(Height / 2) * line_bytes + Offsets[offset_index]] ^= 0x01;
+			PaddedImage third(changed, line_bytes, Height, 12, random);
+
+			string changed_name = name + ", byte " + to_string(Offsets[offset_index]) + " changed";
+			VS_CHECK_MESSAGE(first.Hash() != third.Hash(), changed_name);
+			VS_CHECK_MESSAGE(!PixelOperations::Equal(first.pixels.data(), first.bytes_per_line, third.pixels.data(), third.bytes_per_line, line_bytes, Height), changed_name);
+		}
+	}
+
+	// The same bytes in another shape are another image
+	vector<unsigned char> image(64 * 4, 7);
+	PaddedImage wide(image, 64, 4, 0, random);
+	PaddedImage tall(image, 32, 8, 0, random);
+	VS_CHECK(wide.Hash() != tall.Hash());
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
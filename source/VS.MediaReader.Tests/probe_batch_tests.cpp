@@ -0,0 +1,119 @@
+/*
+@file		probe_batch_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of ProbeBatch (the reports, Wait and Cancel)
+*/
+
+// STD
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "probe_batch.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	/// Paths of files which don't exist (each one is reported as invalid)
+	vector<string> GetMissingPaths(const string &prefix, int count)
+	{
+		vector<string> paths;
+		for (int index = 0; index < count; index++)
+			paths.push_back("missing_" + prefix + "_" + to_string(index) + ".mp4");
+
+		return paths;
+	}
+}
+
+// Every file is reported once, with an error if it can't be probed, before Wait() returns
+VS_TEST(ProbeBatchReportsEveryFile)
+{
+	const int Files = 20;
+
+	mutex results_mutex;
+	vector<ProbeResult> results;
+	ProbeBatch batch(3);
+
+	batch.Probe(GetMissingPaths("report", Files), [&](const ProbeResult &result) {
+		lock_guard<mutex> lock(results_mutex);
+		results.push_back(result);
+	});
+	batch.Wait();
+
+	VS_CHECK(batch.GetPendingCount() == 0);
+
+	lock_guard<mutex> lock(results_mutex);
+	VS_CHECK(results.size() == Files);
+	for (size_t index = 0; index < results.size(); index++)
+	{
+		VS_CHECK_MESSAGE(!results[index].is_valid, results[index].path);
+		VS_CHECK_MESSAGE(!results[index].error.empty(), results[index].path);
+	}
+}
+
+// The files queued before Cancel() are skipped (the file being reported still finishes), and the files queued after
+// it are probed
+VS_TEST(ProbeBatchCancelSkipsQueuedFiles)
+{
+	const int Files = 10;
+
+	mutex results_mutex;
+	condition_variable results_changed;
+	int reported = 0;
+	bool is_released = false;
+
+	// One file at a time, so the others are still queued while the first one is reported
+	ProbeBatch batch(1);
+
+	batch.Probe(GetMissingPaths("cancel", Files), [&](const ProbeResult&) {
+		unique_lock<mutex> lock(results_mutex);
+		reported++;
+		results_changed.notify_all();
+		results_changed.wait(lock, [&] { return is_released; });
+	});
+
+	{
+		unique_lock<mutex> lock(results_mutex);
+		VS_CHECK(results_changed.wait_for(lock, chrono::seconds(10), [&] { return reported == 1; }));
+	}
+
+	batch.Cancel();
+	{
+		lock_guard<mutex> lock(results_mutex);
+		is_released = true;
+		results_changed.notify_all();
+	}
+
+	batch.Wait();
+	VS_CHECK(batch.GetPendingCount() == 0);
+	VS_CHECK(reported == 1);
+
+	// A new batch of files after the cancel
+	batch.Probe(GetMissingPaths("after_cancel", Files), [&](const ProbeResult&) {
+		lock_guard<mutex> lock(results_mutex);
+		reported++;
+	});
+	batch.Wait();
+
+	VS_CHECK(reported == 1 + Files);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,383 @@
+/*
+@file		reader_tests.cpp
+@author		Webstar
+@date		2026-10-19 11:40
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests and benchmarks of FFmpegReader (on the file of VS_TEST_MEDIA)
+*/
+
+// STD
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pixel_operations.hpp"
+#include "reader.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	/// Hash the image of a frame (0 if it has none)
+	uint64_t HashImage(const QSharedPointer<Frame> &frame)
+	{
+		if (!frame || !frame->has_image_data)
+			return 0;
+
+		QSharedPointer<QImage> image = frame->GetImage();
+		return PixelOperations::Hash(image->constBits(), image->width() * 4, image->height(), image->bytesPerLine());
+	}
+
+	/// Decode the first frames of a reader in order, and hash their images
+	vector<uint64_t> HashFrames(FFmpegReader &reader, long int frames)
+	{
+		vector<uint64_t> hashes;
+		for (long int number = 1; number <= frames; number++)
+			hashes.push_back(HashImage(reader.GetFrame(number)));
+
+		return hashes;
+	}
+
+	/// Wait until a range of frames is cached (false if it takes longer than 10 seconds)
+	bool WaitForCached(FFmpegReader &reader, long int start_frame, long int end_frame)
+	{
+		Stopwatch stopwatch;
+		while (stopwatch.GetSeconds() < 10.0)
+		{
+			long int number = start_frame;
+			while (number <= end_frame && reader.GetCache()->Contains(number))
+				number++;
+
+			if (number > end_frame)
+				return true;
+
+			this_thread::sleep_for(chrono::milliseconds(10));
+		}
+
+		return false;
+	}
+}
+
+// A low latency open decodes the same images as a normal open, across the keyframes where its video codec gets its
+// threads (a frame numbered from the wrong packet, or filled in with the previous image, has another hash)
+VS_TEST(LowLatencyOpenDecodesInOrder)
+{
+	long int frames = 0;
+	vector<uint64_t> expected;
+	{
+		FFmpegReader reader(GetTestMedia());
+		reader.enable_prefetch = false;
+		reader.Open();
+
+		frames = min(reader.info.video_length, (long int)(10.0 * reader.info.fps.ToDouble()));
+		expected = HashFrames(reader, frames);
+
+		// The frames need two keyframes after the first frame (the upgrade happens at the first one)
+		long int last_keyframe = reader.GetCostModel()->GetKeyframeBefore(frames);
+		if (reader.GetCostModel()->GetKeyframeBefore(last_keyframe - 1) <= 1)
+			VS_SKIP("the test media needs 3 keyframes in its first 10 seconds");
+
+		reader.Close();
+	}
+
+	FFmpegReader reader(GetTestMedia());
+	reader.low_latency_open = true;
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	vector<uint64_t> actual = HashFrames(reader, frames);
+	for (long int index = 0; index < frames; index++)
+	{
+		VS_CHECK_MESSAGE(actual[index] != 0, "frame " + to_string(index + 1) + " has no image");
+		VS_CHECK_MESSAGE(actual[index] == expected[index], "frame " + to_string(index + 1) + " differs from a normal open");
+	}
+
+	reader.Close();
+}
+
+// The audio requested after a low latency open decodes a pinned range again with its audio, and keeps it pinned
+VS_TEST(ResumedAudioRefillsPinnedRanges)
+{
+	FFmpegReader reader(GetTestMedia());
+	reader.low_latency_open = true;
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	if (!reader.info.has_video || !reader.info.has_audio)
+		VS_SKIP("the test media needs a video and an audio stream");
+	if (reader.info.video_length < 60)
+		VS_SKIP("the test media is too short");
+
+	// A thumbnail range doesn't need the audio
+	VS_CHECK(reader.Prefetch(1, 10, REQUEST_THUMBNAIL) == 10);
+	VS_CHECK(WaitForCached(reader, 1, 10));
+	VS_CHECK(!reader.GetCache()->GetFrame(5)->has_audio_data);
+
+	// The next request decodes the audio
+	reader.RequestAudio();
+	VS_CHECK(reader.GetFrame(40)->has_audio_data);
+
+	VS_CHECK_MESSAGE(WaitForCached(reader, 1, 10), "the pinned range was not decoded again");
+	for (long int number = 1; number <= 10; number++)
+	{
+		QSharedPointer<Frame> frame = reader.GetCache()->GetFrame(number);
+		VS_CHECK_MESSAGE(frame && frame->has_audio_data, "frame " + to_string(number) + " has no audio");
+		VS_CHECK(reader.GetCache()->IsPinned(number));
+	}
+
+	reader.Evict(1, 10);
+	reader.Close();
+}
+
+// Requests stopped at any stage (waiting, between packets, before converting or assembling) leave the reader where
+// the next request decodes the same images as a reader which was never stopped
+VS_TEST(StoppedRequestsKeepTheReaderConsistent)
+{
+	long int frames = 0;
+	vector<uint64_t> expected;
+	{
+		FFmpegReader reader(GetTestMedia());
+		reader.enable_prefetch = false;
+		reader.Open();
+
+		frames = min(reader.info.video_length, (long int)(4.0 * reader.info.fps.ToDouble()));
+		expected = HashFrames(reader, frames);
+		reader.Close();
+	}
+
+	FFmpegReader reader(GetTestMedia());
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	for (long int number = 1; number <= frames; number++)
+	{
+		// A deadline of a few hundred microseconds stops the request somewhere in its decoding
+		RequestToken token(RequestToken::Clock::now() + chrono::microseconds(100 * (number % 8)));
+		reader.GetFrame(number, REQUEST_PLAYHEAD, token);
+		VS_CHECK(token.GetStatus() == REQUEST_TIMED_OUT || token.GetStatus() == REQUEST_COMPLETED);
+
+		VS_CHECK_MESSAGE(HashImage(reader.GetFrame(number)) == expected[number - 1], "frame " + to_string(number) + " differs after a stopped request");
+	}
+
+	// A cancelled request for a frame which isn't cached stops right away
+	long int uncached = frames + 1;
+	if (uncached <= reader.info.video_length && !reader.GetCache()->Contains(uncached))
+	{
+		RequestToken cancelled;
+		cancelled.Cancel();
+		reader.GetFrame(uncached, REQUEST_PLAYHEAD, cancelled);
+		VS_CHECK(cancelled.GetStatus() == REQUEST_CANCELLED);
+	}
+
+	reader.Close();
+}
+
+// Concurrent requests for the same frame share one decode (the same frames are decoded as for a single request)
+VS_TEST(ConcurrentRequestsDecodeOnce)
+{
+	const int Requests = 8;
+
+	long int target = 0;
+	long long int single_decoded = 0;
+	{
+		FFmpegReader reader(GetTestMedia());
+		reader.enable_prefetch = false;
+		reader.Open();
+
+		target = min(reader.info.video_length, (long int)(2.0 * reader.info.fps.ToDouble()));
+		reader.GetFrame(target);
+		single_decoded = reader.GetDecodedVideoFrames();
+
+		reader.Close();
+	}
+
+	FFmpegReader reader(GetTestMedia());
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	vector<QSharedPointer<Frame>> frames(Requests);
+	vector<thread> requests;
+	for (int index = 0; index < Requests; index++)
+		requests.push_back(thread([&reader, &frames, target, index] {
+			frames[index] = reader.GetFrame(target);
+		}));
+	for (int index = 0; index < Requests; index++)
+		requests[index].join();
+
+	VS_CHECK_MESSAGE(reader.GetDecodedVideoFrames() == single_decoded, to_string(reader.GetDecodedVideoFrames()) + " frames decoded instead of " + to_string(single_decoded));
+	for (int index = 0; index < Requests; index++)
+	{
+		VS_CHECK(frames[index] && frames[index]->number == target);
+		VS_CHECK(frames[index] == frames[0]);
+	}
+
+	// The info can be read while another thread decodes
+	VS_CHECK(reader.GetInfo().video_length == reader.info.video_length);
+
+	reader.Close();
+}
+
+// A reader reopened with a stream disabled forgets that stream (its info and its frames only have the enabled one)
+VS_TEST(ReopenedReaderOnlyHasEnabledStreams)
+{
+	FFmpegReader reader(GetTestMedia());
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	if (!reader.info.has_video || !reader.info.has_audio)
+		VS_SKIP("the test media needs a video and an audio stream");
+
+	reader.Close();
+
+	// Audio only
+	reader.enable_video = false;
+	reader.Open();
+	MediaInfo info = reader.GetInfo();
+	VS_CHECK(!info.has_video && info.video_stream_index == -1);
+	VS_CHECK(info.has_audio && info.audio_stream_index != -1);
+	VS_CHECK(reader.GetFrame(1)->GetAudioChannelsCount() > 0);
+	reader.Close();
+
+	// Video only
+	reader.enable_video = true;
+	reader.enable_audio = false;
+	reader.Open();
+	info = reader.GetInfo();
+	VS_CHECK(info.has_video && info.video_stream_index != -1);
+	VS_CHECK(!info.has_audio && info.audio_stream_index == -1);
+	VS_CHECK(reader.GetFrame(1)->GetAudioChannelsCount() == 0);
+	reader.Close();
+}
+
+// Going back to the start rewinds the open file (a loop of a short clip): the frames decode again to the same images,
+// and the final cache and the info are kept, which closing and re-opening the file would have dropped
+VS_TEST(RewindKeepsTheFileOpen)
+{
+	FFmpegReader reader(GetTestMedia());
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	long int frames = min(reader.info.video_length, (long int)(3.0 * reader.info.fps.ToDouble()));
+	if (frames < 40)
+		VS_SKIP("the test media is too short");
+
+	vector<uint64_t> expected = HashFrames(reader, frames);
+	MediaInfo info = reader.GetInfo();
+
+	// Loop back to the start twice (only the last frame is left in the cache, so the others are decoded again)
+	for (int loop = 0; loop < 2; loop++)
+	{
+		reader.GetCache()->Remove(1, frames - 1);
+
+		vector<uint64_t> actual = HashFrames(reader, 10);
+		for (long int index = 0; index < 10; index++)
+			VS_CHECK_MESSAGE(actual[index] == expected[index], "frame " + to_string(index + 1) + " of loop " + to_string(loop + 1));
+
+		VS_CHECK(reader.GetCache()->Contains(frames));
+	}
+
+	VS_CHECK(reader.GetInfo().video_length == info.video_length);
+	VS_CHECK(reader.GetInfo().duration == info.duration);
+
+	reader.Close();
+}
+
+// Scrub() returns right away without decoding (not even the keyframe), and the refinement decodes the exact frame
+VS_TEST(ScrubReturnsWithoutDecoding)
+{
+	FFmpegReader reader(GetTestMedia());
+	reader.enable_prefetch = false;
+	reader.Open();
+
+	long int gop_length = (long int)ceil(reader.GetCostModel()->GetEstimates().gop_length);
+	long int target = reader.info.video_length / 2;
+	if (target < 4 * gop_length)
+		VS_SKIP("the test media needs 8 GOPs");
+
+	reader.GetFrame(1);
+
+	// Nothing is cached near the target
+	long long int decoded = reader.GetDecodedVideoFrames();
+	mutex refined_mutex;
+	condition_variable refined_changed;
+	long int refined_number = 0;
+	ScrubResult result = reader.Scrub(target, [&](const ScrubResult &refined) {
+		lock_guard<mutex> lock(refined_mutex);
+		refined_number = refined.frame->number;
+		refined_changed.notify_all();
+	});
+
+	VS_CHECK(reader.GetDecodedVideoFrames() == decoded);
+	VS_CHECK(result.is_approximate);
+	VS_CHECK(!result.frame);
+
+	// The playhead rests on the target, so the exact frame follows
+	unique_lock<mutex> lock(refined_mutex);
+	VS_CHECK(refined_changed.wait_for(lock, chrono::seconds(10), [&] { return refined_number != 0; }));
+	VS_CHECK(refined_number == target);
+	lock.unlock();
+
+	// The exact frame is cached now
+	result = reader.Scrub(target);
+	VS_CHECK(!result.is_approximate && result.frame->number == target);
+
+	reader.Close();
+}
+
+// The time to the first frame, and the slowest of the next 2 seconds of frames (a seek to restart the video codec
+// would show up there), for a normal and a low latency open of the same file
+VS_BENCHMARK(LowLatencyOpenTimeToFirstFrame)
+{
+	const string path = GetTestMedia();
+
+	// Store the snapshot of the file first (a low latency open is meant to be used with it)
+	{
+		FFmpegReader reader(path);
+		reader.Open();
+		reader.Close();
+	}
+
+	for (int low_latency = 0; low_latency < 2; low_latency++)
+	{
+		const string prefix = low_latency ? "low latency " : "normal ";
+
+		Stopwatch stopwatch;
+		FFmpegReader reader(path);
+		reader.low_latency_open = low_latency != 0;
+		reader.enable_prefetch = false;
+		reader.Open();
+		reader.GetFrame(1);
+		ReportBenchmark(prefix + "time to first frame", stopwatch.GetSeconds() * 1000.0, "ms");
+
+		double slowest = 0.0;
+		long int frames = min(reader.info.video_length, (long int)(2.0 * reader.info.fps.ToDouble()));
+		for (long int number = 2; number <= frames; number++)
+		{
+			stopwatch.Restart();
+			reader.GetFrame(number);
+			slowest = max(slowest, stopwatch.GetSeconds());
+		}
+		ReportBenchmark(prefix + "slowest of the next frames", slowest * 1000.0, "ms");
+
+		reader.Close();
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 11:40
+#vNext
+=============================================================
+*/
@@ -0,0 +1,267 @@
+/*
+@file		request_scheduler_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests and benchmarks of RequestScheduler under a mixed load of requests
+*/
+
+// STD
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "request_scheduler.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	// The time to decode a packet (spun, since sleeping can take a whole timer tick)
+	const int PacketMicroseconds = 1000;
+
+	// The packets of a background job (a job takes a lot longer than the playhead may wait)
+	const int JobPackets = 200;
+
+	// The longest a playhead request may wait for the decoder under load (a packet, plus waking up)
+	const int MaxPlayheadWaitMilliseconds = 50;
+
+	/// Keep the CPU busy for a while, like decoding a packet
+	void DecodePacket()
+	{
+		Stopwatch stopwatch;
+		while (stopwatch.GetSeconds() * 1e6 < PacketMicroseconds)
+			;
+	}
+
+	/// Wait until a number of requests of a class are waiting for the decoder
+	void WaitForWaiting(RequestScheduler &scheduler, RequestPriority priority, int count)
+	{
+		while (scheduler.CountWaiting(priority) < count)
+			this_thread::yield();
+	}
+
+	/// @brief Background requests (thumbnails and analysis), which decode jobs of JobPackets until stopped
+	/// @remark They yield to more urgent requests at every packet, as the reader does.
+	class BackgroundLoad
+	{
+	private:
+		RequestScheduler &scheduler;
+		atomic<bool> stop;
+		atomic<int> packets;
+		vector<thread> workers;
+
+		void Run(RequestPriority priority)
+		{
+			while (!stop)
+			{
+				ScheduledRequest request(scheduler, priority, RequestScheduler::NoDeadline());
+				for (int packet = 0; packet < JobPackets && !stop; packet++)
+				{
+					if (request.ShouldYield())
+						request.Yield();
+
+					DecodePacket();
+					packets++;
+				}
+			}
+		}
+
+	public:
+		BackgroundLoad(RequestScheduler &scheduler, int thumbnails, int analyses) : scheduler(scheduler), stop(false), packets(0)
+		{
+			for (int index = 0; index < thumbnails + analyses; index++)
+				workers.push_back(thread(&BackgroundLoad::Run, this, (index < thumbnails) ? REQUEST_THUMBNAIL : REQUEST_ANALYSIS));
+		}
+
+		~BackgroundLoad()
+		{
+			stop = true;
+			for (size_t index = 0; index < workers.size(); index++)
+				workers[index].join();
+		}
+
+		/// Get the packets decoded so far
+		int GetPackets() { return packets; }
+	};
+
+	/// Measure how long a number of playhead requests wait for the decoder (in milliseconds), each holding it for a packet
+	vector<double> MeasurePlayheadWaits(RequestScheduler &scheduler, int requests)
+	{
+		vector<double> waits;
+		for (int index = 0; index < requests; index++)
+		{
+			Stopwatch stopwatch;
+			{
+				ScheduledRequest request(scheduler, REQUEST_PLAYHEAD, RequestScheduler::NoDeadline());
+				waits.push_back(stopwatch.GetSeconds() * 1000.0);
+				DecodePacket();
+			}
+
+			// Let the background requests take the decoder back
+			this_thread::sleep_for(chrono::milliseconds(2));
+		}
+
+		sort(waits.begin(), waits.end());
+		return waits;
+	}
+}
+
+// Waiting requests take the decoder by class, then by deadline, then by arrival
+VS_TEST(RequestSchedulerOrdersWaitingRequests)
+{
+	RequestScheduler scheduler;
+	RequestScheduler::Ticket holder = scheduler.Begin(REQUEST_ANALYSIS, RequestScheduler::NoDeadline());
+
+	mutex order_mutex;
+	vector<string> order;
+	vector<thread> requests;
+	RequestScheduler::Clock::time_point now = RequestScheduler::Clock::now();
+
+	// Queue the requests one at a time, so their arrival order is known
+	struct { const char *name; RequestPriority priority; RequestScheduler::Clock::time_point deadline; } queued[] = {
+		{ "thumbnail", REQUEST_THUMBNAIL, RequestScheduler::NoDeadline() },
+		{ "analysis", REQUEST_ANALYSIS, RequestScheduler::NoDeadline() },
+		{ "playhead late", REQUEST_PLAYHEAD, now + chrono::seconds(20) },
+		{ "prefetch", REQUEST_PREFETCH, RequestScheduler::NoDeadline() },
+		{ "playhead", REQUEST_PLAYHEAD, RequestScheduler::NoDeadline() },
+		{ "playhead early", REQUEST_PLAYHEAD, now + chrono::seconds(10) },
+	};
+	int waiting[REQUEST_PRIORITY_COUNT] = {};
+
+	for (size_t index = 0; index < sizeof(queued) / sizeof(queued[0]); index++)
+	{
+		const char *name = queued[index].name;
+		RequestPriority priority = queued[index].priority;
+		RequestScheduler::Clock::time_point deadline = queued[index].deadline;
+
+		requests.push_back(thread([&scheduler, &order_mutex, &order, name, priority, deadline] {
+			ScheduledRequest request(scheduler, priority, deadline);
+			lock_guard<mutex> lock(order_mutex);
+			order.push_back(name);
+		}));
+		WaitForWaiting(scheduler, priority, ++waiting[priority]);
+	}
+
+	// The playhead requests make the holder yield
+	VS_CHECK(scheduler.ShouldYield(holder));
+	scheduler.End(holder);
+
+	for (size_t index = 0; index < requests.size(); index++)
+		requests[index].join();
+
+	const char *expected[] = { "playhead early", "playhead late", "playhead", "prefetch", "thumbnail", "analysis" };
+	VS_CHECK(order.size() == 6);
+	for (size_t index = 0; index < order.size(); index++)
+		VS_CHECK_MESSAGE(order[index] == expected[index], "request " + to_string(index) + " was " + order[index]);
+}
+
+// A waiting request stopped by its token leaves the line, and the requests behind it go on
+VS_TEST(RequestSchedulerStoppedRequestLeavesLine)
+{
+	RequestScheduler scheduler;
+	RequestScheduler::Ticket holder = scheduler.Begin(REQUEST_ANALYSIS, RequestScheduler::NoDeadline());
+
+	RequestToken token;
+	atomic<bool> has_decoder(true);
+	thread stopped([&] {
+		RequestScheduler::Ticket ticket;
+		has_decoder = scheduler.Begin(REQUEST_PLAYHEAD, token, ticket);
+		if (has_decoder)
+			scheduler.End(ticket);
+	});
+	WaitForWaiting(scheduler, REQUEST_PLAYHEAD, 1);
+
+	Stopwatch stopwatch;
+	token.Cancel();
+	stopped.join();
+	VS_CHECK(!has_decoder);
+	VS_CHECK(scheduler.CountWaiting(REQUEST_PLAYHEAD) == 0);
+	VS_CHECK(stopwatch.GetSeconds() * 1000.0 < MaxPlayheadWaitMilliseconds);
+
+	// Giving the decoder back with a ticket which doesn't hold it is ignored
+	RequestScheduler::Ticket stale;
+	stale.priority = REQUEST_PLAYHEAD;
+	stale.deadline = RequestScheduler::NoDeadline();
+	stale.sequence = holder.sequence + 100;
+	scheduler.End(stale);
+
+	RequestToken late_token(RequestScheduler::Clock::now() + chrono::milliseconds(20));
+	RequestScheduler::Ticket late;
+	VS_CHECK(!scheduler.Begin(REQUEST_PLAYHEAD, late_token, late));
+
+	// The holder still gives it back
+	scheduler.End(holder);
+	RequestToken next_token(RequestScheduler::Clock::now() + chrono::seconds(5));
+	RequestScheduler::Ticket next;
+	VS_CHECK(scheduler.Begin(REQUEST_PLAYHEAD, next_token, next));
+	scheduler.End(next);
+}
+
+// Under a mixed load of thumbnail and analysis jobs, a playhead request waits about a packet (not a whole job)
+VS_TEST(RequestSchedulerPlayheadLatencyUnderLoad)
+{
+	RequestScheduler scheduler;
+	int background_packets = 0;
+	vector<double> waits;
+	{
+		BackgroundLoad load(scheduler, 2, 2);
+		WaitForWaiting(scheduler, REQUEST_ANALYSIS, 1);
+
+		waits = MeasurePlayheadWaits(scheduler, 50);
+		background_packets = load.GetPackets();
+	}
+
+	// A whole job takes JobPackets milliseconds, so waiting for one would show
+	string message = "the slowest playhead request waited " + to_string(waits.back()) + " ms";
+	VS_CHECK_MESSAGE(waits.back() < MaxPlayheadWaitMilliseconds, message);
+
+	// The background requests still decode between the playhead requests
+	VS_CHECK(background_packets > 0);
+}
+
+// The waits of playhead requests under a mixed load (median, 99th percentile and slowest)
+VS_BENCHMARK(RequestSchedulerPlayheadLatency)
+{
+	const int loads[][2] = { { 0, 0 }, { 1, 1 }, { 4, 4 } };
+
+	for (int load_index = 0; load_index < 3; load_index++)
+	{
+		int thumbnails = loads[load_index][0];
+		int analyses = loads[load_index][1];
+		string prefix = to_string(thumbnails) + " thumbnail + " + to_string(analyses) + " analysis jobs: playhead wait ";
+
+		RequestScheduler scheduler;
+		vector<double> waits;
+		{
+			BackgroundLoad load(scheduler, thumbnails, analyses);
+			if (analyses > 0)
+				WaitForWaiting(scheduler, REQUEST_ANALYSIS, 1);
+
+			waits = MeasurePlayheadWaits(scheduler, 200);
+		}
+
+		ReportBenchmark(prefix + "median", waits[waits.size() / 2], "ms");
+		ReportBenchmark(prefix + "p99", waits[waits.size() * 99 / 100], "ms");
+		ReportBenchmark(prefix + "max", waits.back(), "ms");
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
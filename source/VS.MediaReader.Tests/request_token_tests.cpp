@@ -0,0 +1,88 @@
+/*
+@file		request_token_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of RequestToken (cancellation, deadlines and status)
+*/
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "request_token.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+// A token without a deadline only stops once it is cancelled
+VS_TEST(RequestTokenCancel)
+{
+	RequestToken token;
+	VS_CHECK(token.GetDeadline() == RequestToken::Clock::time_point::max());
+	VS_CHECK(token.GetStatus() == REQUEST_PENDING);
+	VS_CHECK(!token.IsCancelled());
+	VS_CHECK(!token.IsExpired());
+	VS_CHECK(!token.ShouldStop());
+
+	// Cancelled from another thread
+	thread canceller([&token] { token.Cancel(); });
+	canceller.join();
+
+	VS_CHECK(token.IsCancelled());
+	VS_CHECK(!token.IsExpired());
+	VS_CHECK(token.ShouldStop());
+	VS_CHECK(token.GetStopStatus() == REQUEST_CANCELLED);
+
+	// The status is set by the reader
+	token.SetStatus(token.GetStopStatus());
+	VS_CHECK(token.GetStatus() == REQUEST_CANCELLED);
+}
+
+// A token stops once its deadline has passed (and a cancelled token reports the cancellation, even when late)
+VS_TEST(RequestTokenDeadline)
+{
+	RequestToken late(RequestToken::Clock::now() - chrono::milliseconds(1));
+	VS_CHECK(late.IsExpired());
+	VS_CHECK(late.ShouldStop());
+	VS_CHECK(!late.IsCancelled());
+	VS_CHECK(late.GetStopStatus() == REQUEST_TIMED_OUT);
+
+	late.Cancel();
+	VS_CHECK(late.GetStopStatus() == REQUEST_CANCELLED);
+
+	// Not expired until the deadline
+	RequestToken::Clock::time_point deadline = RequestToken::Clock::now() + chrono::milliseconds(50);
+	RequestToken token(deadline);
+	VS_CHECK(token.GetDeadline() == deadline);
+	VS_CHECK(!token.IsExpired());
+	VS_CHECK(!token.ShouldStop());
+
+	this_thread::sleep_until(deadline + chrono::milliseconds(1));
+	VS_CHECK(token.IsExpired());
+	VS_CHECK(token.ShouldStop());
+	VS_CHECK(token.GetStopStatus() == REQUEST_TIMED_OUT);
+
+	// Every outcome can be stored
+	const RequestStatus statuses[] = { REQUEST_COMPLETED, REQUEST_CANCELLED, REQUEST_TIMED_OUT, REQUEST_FAILED, REQUEST_PENDING };
+	for (size_t index = 0; index < sizeof(statuses) / sizeof(statuses[0]); index++)
+	{
+		token.SetStatus(statuses[index]);
+		VS_CHECK(token.GetStatus() == statuses[index]);
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,130 @@
+/*
+@file		seek_cost_model_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of SeekCostModel (the keyframe estimates, the walk or seek decision, and the skip window)
+*/
+
+#include "seek_cost_model.hpp"
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	/// Feed a measurement until the moving average has (nearly) reached it
+	template <typename AddFunction>
+	void Converge(SeekCostModel &model, AddFunction add, double seconds)
+	{
+		for (int index = 0; index < 200; index++)
+			(model.*add)(seconds);
+	}
+}
+
+// Without an index, a frame further than a GOP from the last known keyframe is assumed to be half a GOP after its
+// own keyframe, and the keyframes of the index are used as they are
+VS_TEST(SeekCostModelEstimatesKeyframes)
+{
+	SeekCostModel model(50.0);
+
+	// Nothing observed: the default GOP
+	VS_CHECK(model.GetKeyframeBefore(10) == 1);
+	VS_CHECK(model.GetKeyframeBefore(51) == 1);
+	VS_CHECK(model.GetKeyframeBefore(1000) == 975);
+
+	// Observed keyframes give the GOP length (100 frames)
+	model.AddKeyframe(1);
+	model.AddKeyframe(101);
+	VS_CHECK(model.GetEstimates().gop_length == 100.0);
+	VS_CHECK(!model.GetEstimates().has_index);
+	VS_CHECK(model.GetKeyframeBefore(150) == 101);
+	VS_CHECK(model.GetKeyframeBefore(201) == 101);
+	VS_CHECK(model.GetKeyframeBefore(500) == 450);
+
+	// The index lists every keyframe, so the closest one is used however far it is
+	model.AddKeyframe(301, true);
+	VS_CHECK(model.GetEstimates().has_index);
+	VS_CHECK(model.GetKeyframeBefore(250) == 101);
+	VS_CHECK(model.GetKeyframeBefore(500) == 301);
+	VS_CHECK(model.GetKeyframeBefore(301) == 301);
+
+	// Invalid frames are ignored
+	model.AddKeyframe(0, true);
+	VS_CHECK(model.GetEstimates().keyframes == 3);
+
+	// A new file starts over
+	model.Reset(50.0);
+	VS_CHECK(model.GetEstimates().keyframes == 0);
+	VS_CHECK(!model.GetEstimates().has_index);
+	VS_CHECK(model.GetKeyframeBefore(500) == 475);
+}
+
+// Walking is chosen while decoding to the frame costs less than the seek and the decoding from its keyframe
+VS_TEST(SeekCostModelWalkThreshold)
+{
+	// Keyframes every 100 frames (5 ms to decode a frame, 20 ms to seek)
+	SeekCostModel model(50.0);
+	model.AddKeyframe(1, true);
+	model.AddKeyframe(101, true);
+	model.AddKeyframe(201, true);
+
+	// Seeking to 180 decodes from 101: 20 ms + 80 frames, which is the cost of walking 84 frames
+	VS_CHECK(model.ShouldWalk(97, 180));
+	VS_CHECK(model.ShouldWalk(179, 180));
+	VS_CHECK(!model.ShouldWalk(94, 180));
+	VS_CHECK(!model.ShouldWalk(20, 180));
+
+	// The bias moves the threshold
+	VS_CHECK(model.ShouldWalk(94, 180, 1.1));
+	VS_CHECK(!model.ShouldWalk(97, 180, 0.9));
+
+	// Walking only goes forward (position 0 is the start of the stream)
+	VS_CHECK(!model.ShouldWalk(180, 180));
+	VS_CHECK(!model.ShouldWalk(181, 180));
+	VS_CHECK(model.ShouldWalk(0, 10));
+
+	// Just after a keyframe, seeking is always cheaper than a long walk
+	VS_CHECK(!model.ShouldWalk(150, 202));
+
+	// Slow seeks make longer walks worth it
+	Converge(model, &SeekCostModel::AddSeekTime, 1.0);
+	VS_CHECK(model.ShouldWalk(20, 180));
+	VS_CHECK(model.ShouldWalk(150, 202));
+}
+
+// The frames kept before a request cost less to convert than a seek back to them, up to MaxSkipWindow
+VS_TEST(SeekCostModelSkipWindowIsCapped)
+{
+	// (20 ms seek + 25 frames to decode) / 2 ms to convert a frame
+	SeekCostModel model(50.0);
+	VS_CHECK(model.GetSkipWindow() == 73);
+
+	// Slow seeks keep more frames, but never more than the cap
+	Converge(model, &SeekCostModel::AddSeekTime, 10.0);
+	VS_CHECK(model.GetSkipWindow() == SeekCostModel::MaxSkipWindow);
+
+	// Slow conversions keep at least the frame before the request
+	model.Reset(50.0);
+	Converge(model, &SeekCostModel::AddConvertTime, 10.0);
+	VS_CHECK(model.GetSkipWindow() == 1);
+
+	// Free conversions are still capped
+	model.Reset(50.0);
+	Converge(model, &SeekCostModel::AddConvertTime, 0.0);
+	VS_CHECK(model.GetSkipWindow() == SeekCostModel::MaxSkipWindow);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,139 @@
+/*
+@file		slice_conversion_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Checks the conversion of FFmpegReader in slices against a single sws_scale pass
+*/
+
+// STD
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "reader.hpp"
+#include "test_harness.hpp"
+#include "utilities.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	// An odd height, so the slices are not all the same size
+	const int Width = 640;
+	const int Height = 362;
+
+	/// Make a frame of random pixels
+	AVFrame* MakeFrame(AVPixelFormat pix_fmt, mt19937 &random)
+	{
+		AVFrame *frame = av_frame_alloc();
+		frame->format = pix_fmt;
+		frame->width = Width;
+		frame->height = Height;
+		if (av_frame_get_buffer(frame, 32) < 0)
+		{
+			av_frame_free(&frame);
+			return NULL;
+		}
+
+		// Fill every line of every plane (8-bit formats, so any byte is a valid sample)
+		const AVPixFmtDescriptor *descriptor = av_pix_fmt_desc_get(pix_fmt);
+		for (int plane = 0; plane < av_pix_fmt_count_planes(pix_fmt); plane++)
+		{
+			int lines = (plane == 1 || plane == 2) ? AV_CEIL_RSHIFT(Height, descriptor->log2_chroma_h) : Height;
+			for (int line = 0; line < lines; line++)
+				for (int index = 0; index < frame->linesize[plane]; index++)
+					frame->data[plane][(ptrdiff_t)line * frame->linesize[plane] + index] = (uint8_t)random();
+		}
+
+		return frame;
+	}
+
+	/// Convert a frame to RGBA in one pass (as the reader does for the formats which can't be sliced)
+	vector<uint8_t> ConvertOnePass(const AVFrame *frame, int stride)
+	{
+		vector<uint8_t> rgba((size_t)stride * Height);
+		uint8_t *rgba_data[4] = { rgba.data(), NULL, NULL, NULL };
+		int rgba_linesize[4] = { stride, 0, 0, 0 };
+
+		SwsContext *context = sws_getContext(Width, Height, (AVPixelFormat)frame->format, Width, Height,
+			AV_PIX_FMT_RGBA, SWS_BILINEAR, NULL, NULL, NULL);
+		sws_scale(context, frame->data, frame->linesize, 0, Height, rgba_data, rgba_linesize);
+		sws_freeContext(context);
+
+		return rgba;
+	}
+}
+
+// The formats without vertical chroma subsampling convert to the same pixels in slices as in one pass
+VS_TEST(SlicedConversionMatchesOnePass)
+{
+	const AVPixelFormat formats[] = { AV_PIX_FMT_YUV422P, AV_PIX_FMT_YUV444P, AV_PIX_FMT_YUYV422, AV_PIX_FMT_RGB24, AV_PIX_FMT_GRAY8 };
+	const int stride = Width * 4 + 64;
+
+	mt19937 random(36);
+	vector<SwsContext*> contexts;
+	for (size_t format_index = 0; format_index < sizeof(formats) / sizeof(formats[0]); format_index++)
+	{
+		string name = av_get_pix_fmt_name(formats[format_index]);
+		VS_CHECK_MESSAGE(FFmpegReader::CanSliceFormat(formats[format_index]), name);
+
+		AVFrame *frame = MakeFrame(formats[format_index], random);
+		VS_CHECK_MESSAGE(frame != NULL, name);
+
+		vector<uint8_t> expected = ConvertOnePass(frame, stride);
+		for (int slices = 2; slices <= 5; slices++)
+		{
+			vector<uint8_t> actual((size_t)stride * Height);
+			FFmpegReader::ConvertSlices(frame, slices, actual.data(), stride, contexts);
+
+			for (int line = 0; line < Height; line++)
+			{
+				bool is_equal = memcmp(&actual[(size_t)line * stride], &expected[(size_t)line * stride], Width * 4) == 0;
+				VS_CHECK_MESSAGE(is_equal, name + " in " + to_string(slices) + " slices differs at line " + to_string(line));
+			}
+		}
+
+		av_frame_free(&frame);
+	}
+
+	for (size_t index = 0; index < contexts.size(); index++)
+		sws_freeContext(contexts[index]);
+}
+
+// The formats with vertical chroma subsampling are converted in one pass (sws_scale would interpolate their chroma
+// within each slice only), and the slices start on whole chroma lines for the built-in converter
+VS_TEST(SubsampledChromaIsNotSliced)
+{
+	VS_CHECK(!FFmpegReader::CanSliceFormat(AV_PIX_FMT_YUV420P));
+	VS_CHECK(!FFmpegReader::CanSliceFormat(AV_PIX_FMT_NV12));
+	VS_CHECK(!FFmpegReader::CanSliceFormat(AV_PIX_FMT_YUV410P));
+
+	for (int slices = 1; slices <= 8; slices++)
+	{
+		VS_CHECK(FFmpegReader::GetSliceStart(0, slices, 1080) == 0);
+		VS_CHECK(FFmpegReader::GetSliceStart(slices, slices, 1080) == 1080);
+
+		for (int slice = 1; slice < slices; slice++)
+		{
+			int first_line = FFmpegReader::GetSliceStart(slice, slices, 1080);
+			VS_CHECK(first_line % FFmpegReader::SliceLineAlignment == 0);
+			VS_CHECK(first_line > FFmpegReader::GetSliceStart(slice - 1, slices, 1080));
+		}
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,114 @@
+#ifndef GUARD_test_harness_20261019091000_
+#define GUARD_test_harness_20261019091000_
+/*
+@file		test_harness.hpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		A minimal test and benchmark registry for the VS.MediaReader tests
+*/
+
+// STD
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vs
+{
+	namespace tests
+	{
+		/// A test (or benchmark) registered with VS_TEST / VS_BENCHMARK
+		struct TestCase
+		{
+			const char *name;
+			void (*body)();
+			bool is_benchmark;			///< Only run with --benchmarks (benchmarks report timings, and don't fail)
+		};
+
+		/// Thrown by VS_CHECK when a condition doesn't hold
+		class TestFailure : public std::runtime_error
+		{
+		public:
+			TestFailure(const std::string &message) : std::runtime_error(message) {}
+		};
+
+		/// Thrown by VS_SKIP when a test can't run here (i.e. no test media, or an instruction set the CPU lacks)
+		class TestSkipped : public std::runtime_error
+		{
+		public:
+			TestSkipped(const std::string &reason) : std::runtime_error(reason) {}
+		};
+
+		/// Get every registered test
+		std::vector<TestCase>& GetTests();
+
+		/// Register a test (used by VS_TEST / VS_BENCHMARK)
+		bool RegisterTest(const char *name, void (*body)(), bool is_benchmark);
+
+		/// Throw a TestFailure for a failed check
+		void Fail(const char *file, int line, const std::string &message);
+
+		/// @brief Get the path of the video file used by the reader tests (the VS_TEST_MEDIA environment variable)
+		/// @remark The test is skipped if the variable isn't set. The file should have video and audio, and at least
+		/// a few GOPs (i.e. a 10 second 1080p H.264 clip with B-frames).
+		std::string GetTestMedia();
+
+		/// Print a timing of a benchmark
+		void ReportBenchmark(const std::string &name, double value, const char *unit);
+
+		/// Measure the time of a block of code (in seconds)
+		class Stopwatch
+		{
+		private:
+			std::chrono::steady_clock::time_point started;
+
+		public:
+			Stopwatch() : started(std::chrono::steady_clock::now()) {}
+
+			/// Start over
+			void Restart() { started = std::chrono::steady_clock::now(); }
+
+			/// Get the seconds since the stopwatch was started
+			double GetSeconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count(); }
+		};
+	}
+}
+
+/// Define a test (a function which throws on failure)
+#define VS_TEST(name) \
+	static void name(); \
+	static const bool name##_registered = vs::tests::RegisterTest(#name, &name, false); \
+	static void name()
+
+/// Define a benchmark (only run with --benchmarks)
+#define VS_BENCHMARK(name) \
+	static void name(); \
+	static const bool name##_registered = vs::tests::RegisterTest(#name, &name, true); \
+	static void name()
+
+/// Fail the test if a condition doesn't hold
+#define VS_CHECK(condition) \
+	do { if (!(condition)) vs::tests::Fail(__FILE__, __LINE__, #condition); } while (0)
+
+/// Fail the test with a message, if a condition doesn't hold
+#define VS_CHECK_MESSAGE(condition, message) \
+	do { if (!(condition)) vs::tests::Fail(__FILE__, __LINE__, std::string(#condition) + ": " + (message)); } while (0)
+
+/// Skip the test
+#define VS_SKIP(reason) \
+	throw vs::tests::TestSkipped(reason)
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,119 @@
+/*
+@file		test_main.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <sstream>
+
+#include "test_harness.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+vector<TestCase>& vs::tests::GetTests()
+{
+	static vector<TestCase> tests;
+	return tests;
+}
+
+bool vs::tests::RegisterTest(const char *name, void (*body)(), bool is_benchmark)
+{
+	TestCase test = { name, body, is_benchmark };
+	GetTests().push_back(test);
+	return true;
+}
+
+void vs::tests::Fail(const char *file, int line, const string &message)
+{
+	ostringstream text;
+	text << file << "(" << line << "): " << message;
+	throw TestFailure(text.str());
+}
+
+string vs::tests::GetTestMedia()
+{
+	const char *path = getenv("VS_TEST_MEDIA");
+	if (path == NULL || *path == 0)
+		VS_SKIP("VS_TEST_MEDIA is not set");
+
+	return path;
+}
+
+void vs::tests::ReportBenchmark(const string &name, double value, const char *unit)
+{
+	printf("    %-48s %12.3f %s\n", name.c_str(), value, unit);
+}
+
+// Usage: VS.MediaReader.Tests [--benchmarks] [name ...]
+// Runs the tests (and the benchmarks, with --benchmarks), or only the ones named. Returns the number of failures.
+int main(int argc, char *argv[])
+{
+	bool run_benchmarks = false;
+	vector<string> names;
+	for (int index = 1; index < argc; index++)
+	{
+		if (strcmp(argv[index], "--benchmarks") == 0)
+			run_benchmarks = true;
+		else
+			names.push_back(argv[index]);
+	}
+
+	int passed = 0;
+	int failed = 0;
+	int skipped = 0;
+
+	for (const TestCase &test : GetTests())
+	{
+		bool is_named = false;
+		for (const string &name : names)
+			is_named |= (name == test.name);
+
+		if (names.empty() ? (test.is_benchmark && !run_benchmarks) : !is_named)
+			continue;
+
+		printf("[ RUN  ] %s\n", test.name);
+		fflush(stdout);
+
+		try
+		{
+			test.body();
+			printf("[  OK  ] %s\n", test.name);
+			passed++;
+		}
+		catch (const TestSkipped &e)
+		{
+			printf("[ SKIP ] %s (%s)\n", test.name, e.what());
+			skipped++;
+		}
+		catch (const exception &e)
+		{
+			printf("[ FAIL ] %s\n    %s\n", test.name, e.what());
+			failed++;
+		}
+	}
+
+	printf("%d passed, %d failed, %d skipped\n", passed, failed, skipped);
+	return failed;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,197 @@
+/*
+@file		thread_pool_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Tests of ThreadPool (work stealing and ParallelFor) and of the accounting of DecoderThreadBudget
+*/
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "decoder_thread_budget.hpp"
+#include "test_harness.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+// The tasks a worker queues for itself are stolen by the idle workers, while it is busy
+VS_TEST(ThreadPoolStealsWork)
+{
+	const int Tasks = 8;
+
+	mutex tasks_mutex;
+	condition_variable tasks_changed;
+	set<thread::id> task_threads;
+	int finished = 0;
+	thread::id owner;
+
+	// Declared last, so its workers are joined before the state of the tasks goes away
+	ThreadPool pool(4);
+
+	pool.Submit([&] {
+		{
+			lock_guard<mutex> lock(tasks_mutex);
+			owner = this_thread::get_id();
+		}
+
+		// Queued on the worker's own queue, which it doesn't get back to until they are done
+		for (int index = 0; index < Tasks; index++)
+			pool.Submit([&] {
+				this_thread::sleep_for(chrono::milliseconds(5));
+				lock_guard<mutex> lock(tasks_mutex);
+				task_threads.insert(this_thread::get_id());
+				finished++;
+				tasks_changed.notify_all();
+			});
+
+		unique_lock<mutex> lock(tasks_mutex);
+		tasks_changed.wait_for(lock, chrono::seconds(10), [&] { return finished == Tasks; });
+	});
+
+	unique_lock<mutex> lock(tasks_mutex);
+	VS_CHECK(tasks_changed.wait_for(lock, chrono::seconds(10), [&] { return finished == Tasks; }));
+	VS_CHECK(task_threads.find(owner) == task_threads.end());
+	VS_CHECK(task_threads.size() > 1);
+}
+
+// ParallelFor calls every iteration exactly once (also from a task, and nested in another ParallelFor)
+VS_TEST(ParallelForCoversEveryIteration)
+{
+	const int Iterations = 1000;
+
+	vector<atomic<int>> calls(Iterations);
+	for (int index = 0; index < Iterations; index++)
+		calls[index] = 0;
+
+	atomic<int> nested(0);
+	mutex done_mutex;
+	condition_variable done_changed;
+	bool is_done = false;
+	ThreadPool pool(3);
+
+	pool.ParallelFor(Iterations, [&](int index) { calls[index]++; });
+	for (int index = 0; index < Iterations; index++)
+		VS_CHECK_MESSAGE(calls[index] == 1, "iteration " + to_string(index) + " ran " + to_string(calls[index]) + " times");
+
+	// From a task, with nested loops (the calling threads make progress on their own loops)
+	pool.Submit([&] {
+		pool.ParallelFor(10, [&](int) {
+			pool.ParallelFor(10, [&](int) { nested++; });
+		});
+
+		lock_guard<mutex> lock(done_mutex);
+		is_done = true;
+		done_changed.notify_all();
+	});
+
+	unique_lock<mutex> lock(done_mutex);
+	VS_CHECK(done_changed.wait_for(lock, chrono::seconds(10), [&] { return is_done; }));
+	VS_CHECK(nested == 100);
+
+	// Nothing to share
+	int single = 0;
+	pool.ParallelFor(1, [&](int index) { single += index + 1; });
+	pool.ParallelFor(0, [&](int) { single += 10; });
+	VS_CHECK(single == 1);
+}
+
+// An iteration which throws makes ParallelFor rethrow, once the running iterations have finished
+VS_TEST(ParallelForRethrowsAfterSlicesFinish)
+{
+	atomic<int> running(0);
+	atomic<int> finished(0);
+	bool has_thrown = false;
+	ThreadPool pool(3);
+
+	try
+	{
+		pool.ParallelFor(64, [&](int index) {
+			running++;
+			this_thread::sleep_for(chrono::milliseconds(2));
+			running--;
+			finished++;
+
+			if (index == 3)
+				throw runtime_error("slice 3 failed");
+		});
+	}
+	catch (const runtime_error &error)
+	{
+		has_thrown = string(error.what()) == "slice 3 failed";
+	}
+
+	VS_CHECK(has_thrown);
+	VS_CHECK(running == 0);
+
+	// The iterations after the failure are skipped, and the pool keeps working
+	int after = finished;
+	this_thread::sleep_for(chrono::milliseconds(20));
+	VS_CHECK(finished == after);
+	VS_CHECK(after < 64);
+
+	atomic<int> calls(0);
+	pool.ParallelFor(16, [&](int) { calls++; });
+	VS_CHECK(calls == 16);
+}
+
+// The budget gives out shares of its threads, never more than what's left (except the one thread of each codec)
+VS_TEST(DecoderThreadBudgetAccounting)
+{
+	const int64_t Workload = DecoderThreadBudget::WorkloadPerThread;
+
+	DecoderThreadBudget budget(8);
+	VS_CHECK(budget.GetTotalThreads() == 8);
+
+	// A workload gets the threads it can use
+	int first = budget.Acquire(4 * Workload);
+	VS_CHECK(first == 4);
+
+	// A larger one gets what's left (less than its share of 8 * 8 / 12 threads)
+	int second = budget.Acquire(8 * Workload);
+	VS_CHECK(second == 4);
+	VS_CHECK(budget.GetThreadsInUse() == 8);
+
+	// With nothing left, a codec still gets one thread
+	int third = budget.Acquire(2 * Workload);
+	VS_CHECK(third == 1);
+	VS_CHECK(budget.GetThreadsInUse() == 9);
+
+	// A small workload doesn't take more than it can use, and never more than its share
+	budget.Release(4 * Workload, first);
+	int fourth = budget.Acquire(Workload / 2);
+	VS_CHECK(fourth == 1);
+	VS_CHECK(budget.GetThreadsInUse() == 6);
+
+	budget.Release(8 * Workload, second);
+	budget.Release(2 * Workload, third);
+	budget.Release(Workload / 2, fourth);
+	VS_CHECK(budget.GetThreadsInUse() == 0);
+
+	// Once everything is given back, a codec can take the whole budget again
+	int whole = budget.Acquire(16 * Workload);
+	VS_CHECK(whole == 8);
+	budget.Release(16 * Workload, whole);
+	VS_CHECK(budget.GetThreadsInUse() == 0);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
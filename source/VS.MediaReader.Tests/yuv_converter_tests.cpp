@@ -0,0 +1,292 @@
+/*
+@file		yuv_converter_tests.cpp
+@author		Webstar
+@date		2026-10-19 09:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		Checks the YUV converter against its scalar loop and sws_scale, and times them
+*/
+
+// STD
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cpu_features.hpp"
+#include "test_harness.hpp"
+#include "utilities.hpp"
+#include "yuv_converter.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::tests;
+
+namespace
+{
+	// The widest line of the kernel comparisons (more than two blocks of 16 pixels, plus pixels left over)
+	const int MaxWidth = 67;
+
+	// The largest difference allowed with sws_scale (rounding, and where the chroma samples sit)
+	const int MaxSwscaleDifference = 3;
+
+	/// A YUV image, and the planes it points at
+	struct TestImage
+	{
+		YuvImage image;
+		AVPixelFormat pix_fmt;
+		vector<uint8_t> planes[3];
+	};
+
+	/// @brief Make an 8-bit limited range BT.601 image (the matrix sws_scale uses)
+	/// @remark The values are smooth gradients, which change by less than a level between chroma samples, so the
+	/// interpolation doesn't depend on where the chroma samples sit.
+	TestImage MakeImage(YuvLayout layout, int width, int height)
+	{
+		TestImage test;
+		YuvImage &image = test.image;
+		image.layout = layout;
+		image.matrix = YUV_MATRIX_BT601;
+		image.range = YUV_RANGE_LIMITED;
+		image.bit_depth = 8;
+		image.width = width;
+		image.height = height;
+
+		int chroma_width = (width + 1) / 2;
+		int chroma_height = (layout == YUV_LAYOUT_422P) ? height : (height + 1) / 2;
+		int plane_count = (layout == YUV_LAYOUT_NV12) ? 2 : 3;
+		test.pix_fmt = (layout == YUV_LAYOUT_420P) ? AV_PIX_FMT_YUV420P : ((layout == YUV_LAYOUT_422P) ? AV_PIX_FMT_YUV422P : AV_PIX_FMT_NV12);
+
+		for (int plane = 0; plane < 3; plane++)
+		{
+			image.planes[plane] = NULL;
+			image.strides[plane] = 0;
+			if (plane >= plane_count)
+				continue;
+
+			// Aligned lines, like the frames of the decoder
+			int samples = (plane == 0) ? width : ((layout == YUV_LAYOUT_NV12) ? chroma_width * 2 : chroma_width);
+			int lines = (plane == 0) ? height : chroma_height;
+			image.strides[plane] = (samples + 31) & ~31;
+			test.planes[plane].resize((size_t)image.strides[plane] * lines);
+			image.planes[plane] = test.planes[plane].data();
+
+			for (int line = 0; line < lines; line++)
+			{
+				uint8_t *values = test.planes[plane].data() + (size_t)line * image.strides[plane];
+				for (int x = 0; x < samples; x++)
+				{
+					if (plane == 0)
+						values[x] = (uint8_t)(16 + (x * 150 / width + line * 69 / height));
+					else
+					{
+						// U follows the columns, V the lines (NV12 interleaves them)
+						bool is_u = (layout == YUV_LAYOUT_NV12) ? (x % 2 == 0) : (plane == 1);
+						int column = (layout == YUV_LAYOUT_NV12) ? x / 2 : x;
+						values[x] = (uint8_t)(is_u ? 64 + column * 128 / (chroma_width + 1) : 192 - line * 128 / (chroma_height + 1));
+					}
+				}
+			}
+		}
+
+		return test;
+	}
+
+	/// Convert an image to RGBA with sws_scale (as the reader does, when the size doesn't change)
+	void ConvertWithSwscale(SwsContext *context, const TestImage &test, uint8_t *rgba)
+	{
+		const YuvImage &image = test.image;
+		const uint8_t *planes[4] = { image.planes[0], image.planes[1], image.planes[2], NULL };
+		int strides[4] = { image.strides[0], image.strides[1], image.strides[2], 0 };
+		uint8_t *rgba_planes[4] = { rgba, NULL, NULL, NULL };
+		int rgba_strides[4] = { image.width * 4, 0, 0, 0 };
+
+		sws_scale(context, planes, strides, 0, image.height, rgba_planes, rgba_strides);
+	}
+
+	/// Get a scaler context which converts an image to RGBA at the same size (SWS_BILINEAR, like the reader)
+	SwsContext* GetSwscaleContext(const TestImage &test)
+	{
+		return sws_getContext(test.image.width, test.image.height, test.pix_fmt, test.image.width, test.image.height,
+			AV_PIX_FMT_RGBA, SWS_BILINEAR, NULL, NULL, NULL);
+	}
+
+#if VS_CPU_X86
+	/// Check a line of the AVX2 kernels gives the same bits as the scalar loop
+	template <typename Sample>
+	void CheckLine(const char *name, int width, const vector<Sample> &y, const vector<uint16_t> &u, const vector<uint16_t> &v, const YuvCoefficients &coefficients,
+		int (*kernel)(unsigned char *, const Sample *, const uint16_t *, const uint16_t *, int, const YuvCoefficients &))
+	{
+		vector<unsigned char> expected((size_t)width * 4 + 1, 0);
+		vector<unsigned char> actual((size_t)width * 4 + 1, 0);
+
+		helpers::ConvertYuvLine(expected.data(), y.data(), u.data(), v.data(), 0, width, coefficients);
+		int converted = kernel(actual.data(), y.data(), u.data(), v.data(), width, coefficients);
+		helpers::ConvertYuvLine(actual.data(), y.data(), u.data(), v.data(), converted, width, coefficients);
+
+		string message = string(name) + " differs from the scalar loop for " + to_string(width) + " pixels";
+		VS_CHECK_MESSAGE(memcmp(expected.data(), actual.data(), expected.size()) == 0, message);
+	}
+
+	/// Check the chroma interpolation kernels give the same values as the scalar loop
+	void CheckInterpolation(mt19937 &random, int count)
+	{
+		uniform_int_distribution<int> distribution(0, 1023);
+		vector<uint8_t> nearest8(count * 2), farther8(count * 2);
+		vector<uint16_t> nearest16(count), farther16(count);
+		for (int x = 0; x < count * 2; x++)
+		{
+			nearest8[x] = (uint8_t)distribution(random);
+			farther8[x] = (uint8_t)distribution(random);
+		}
+		for (int x = 0; x < count; x++)
+		{
+			nearest16[x] = (uint16_t)distribution(random);
+			farther16[x] = (uint16_t)distribution(random);
+		}
+
+		vector<uint16_t> expected(count), expected_v(count), actual(count), actual_v(count);
+		string size = " differs from the scalar loop for " + to_string(count) + " samples";
+
+		helpers::InterpolateChromaLine(expected.data(), nearest8.data(), farther8.data(), 1, 0, count);
+		helpers::InterpolateChromaLine(actual.data(), nearest8.data(), farther8.data(), 1, avx2::InterpolateChromaLine8(actual.data(), nearest8.data(), farther8.data(), count), count);
+		VS_CHECK_MESSAGE(expected == actual, "InterpolateChromaLine8" + size);
+
+		helpers::InterpolateChromaLine(expected.data(), nearest16.data(), farther16.data(), 1, 0, count);
+		helpers::InterpolateChromaLine(actual.data(), nearest16.data(), farther16.data(), 1, avx2::InterpolateChromaLine16(actual.data(), nearest16.data(), farther16.data(), count), count);
+		VS_CHECK_MESSAGE(expected == actual, "InterpolateChromaLine16" + size);
+
+		helpers::InterpolateChromaLine(expected.data(), nearest8.data(), farther8.data(), 2, 0, count);
+		helpers::InterpolateChromaLine(expected_v.data(), nearest8.data() + 1, farther8.data() + 1, 2, 0, count);
+		int interpolated = avx2::InterpolateChromaLineNv12(actual.data(), actual_v.data(), nearest8.data(), farther8.data(), count);
+		helpers::InterpolateChromaLine(actual.data(), nearest8.data(), farther8.data(), 2, interpolated, count);
+		helpers::InterpolateChromaLine(actual_v.data(), nearest8.data() + 1, farther8.data() + 1, 2, interpolated, count);
+		VS_CHECK_MESSAGE(expected == actual && expected_v == actual_v, "InterpolateChromaLineNv12" + size);
+	}
+#endif
+}
+
+// The AVX2 kernels give the same values as the scalar loops (every width up to MaxWidth, every matrix and range)
+VS_TEST(YuvConverterKernelsMatchScalar)
+{
+#if VS_CPU_X86
+	if (!YuvConverter::IsSupported())
+		VS_SKIP("the CPU has no AVX2");
+
+	mt19937 random(1234);
+
+	for (int count = 0; count <= MaxWidth; count++)
+		CheckInterpolation(random, count);
+
+	for (int bit_depth = 8; bit_depth <= 10; bit_depth += 2)
+	{
+		uniform_int_distribution<int> distribution(0, (1 << bit_depth) - 1);
+
+		for (int matrix = YUV_MATRIX_BT601; matrix <= YUV_MATRIX_BT709; matrix++)
+		{
+			for (int range = YUV_RANGE_LIMITED; range <= YUV_RANGE_FULL; range++)
+			{
+				YuvCoefficients coefficients = YuvConverter::GetCoefficients((YuvMatrix)matrix, (YuvRange)range, bit_depth);
+
+				for (int width = 0; width <= MaxWidth; width++)
+				{
+					// Random values (so the colors clip too), with the chroma sample after the line
+					vector<uint16_t> u(width / 2 + 2), v(width / 2 + 2);
+					for (size_t index = 0; index < u.size(); index++)
+					{
+						u[index] = (uint16_t)distribution(random);
+						v[index] = (uint16_t)distribution(random);
+					}
+
+					if (bit_depth == 8)
+					{
+						vector<uint8_t> y(width);
+						for (int x = 0; x < width; x++)
+							y[x] = (uint8_t)distribution(random);
+
+						CheckLine<uint8_t>("ConvertYuvLine8", width, y, u, v, coefficients, &avx2::ConvertYuvLine8);
+					}
+					else
+					{
+						vector<uint16_t> y(width);
+						for (int x = 0; x < width; x++)
+							y[x] = (uint16_t)distribution(random);
+
+						CheckLine<uint16_t>("ConvertYuvLine16", width, y, u, v, coefficients, &avx2::ConvertYuvLine16);
+					}
+				}
+			}
+		}
+	}
+#else
+	VS_SKIP("the AVX2 kernels are only built for x86");
+#endif
+}
+
+// The converter gives the colors of sws_scale (BT.601, limited range, bilinear chroma), within a few levels
+VS_TEST(YuvConverterMatchesSwscale)
+{
+	const YuvLayout layouts[] = { YUV_LAYOUT_420P, YUV_LAYOUT_422P, YUV_LAYOUT_NV12 };
+	const char *layout_names[] = { "yuv420p", "yuv422p", "nv12" };
+
+	for (int layout = 0; layout < 3; layout++)
+	{
+		TestImage test = MakeImage(layouts[layout], 318, 180);
+
+		size_t bytes = (size_t)test.image.width * test.image.height * 4;
+		vector<uint8_t> expected(bytes), actual(bytes);
+
+		SwsContext *context = GetSwscaleContext(test);
+		VS_CHECK(context != NULL);
+		ConvertWithSwscale(context, test, expected.data());
+		sws_freeContext(context);
+
+		YuvConverter::Convert(test.image, actual.data(), test.image.width * 4, 0, test.image.height);
+
+		int largest = 0;
+		for (size_t index = 0; index < expected.size(); index++)
+			largest = std::max(largest, abs((int)expected[index] - (int)actual[index]));
+
+		string message = string(layout_names[layout]) + " differs by " + to_string(largest) + " levels";
+		VS_CHECK_MESSAGE(largest <= MaxSwscaleDifference, message);
+	}
+}
+
+// The time to convert a frame with the converter (one thread) and with sws_scale, at 1080p and 4K
+VS_BENCHMARK(YuvConverterAgainstSwscale)
+{
+	const int sizes[][2] = { { 1920, 1080 }, { 3840, 2160 } };
+	const int frames = 20;
+
+	for (int size = 0; size < 2; size++)
+	{
+		TestImage test = MakeImage(YUV_LAYOUT_420P, sizes[size][0], sizes[size][1]);
+		vector<uint8_t> rgba((size_t)test.image.width * test.image.height * 4);
+		string prefix = to_string(test.image.height) + "p yuv420p ";
+
+		Stopwatch stopwatch;
+		for (int frame = 0; frame < frames; frame++)
+			YuvConverter::Convert(test.image, rgba.data(), test.image.width * 4, 0, test.image.height);
+		ReportBenchmark(prefix + (YuvConverter::IsSupported() ? "converter (avx2)" : "converter (scalar)"), stopwatch.GetSeconds() * 1000.0 / frames, "ms/frame");
+
+		SwsContext *context = GetSwscaleContext(test);
+		stopwatch.Restart();
+		for (int frame = 0; frame < frames; frame++)
+			ConvertWithSwscale(context, test, rgba.data());
+		ReportBenchmark(prefix + "sws_scale", stopwatch.GetSeconds() * 1000.0 / frames, "ms/frame");
+		sws_freeContext(context);
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-19 09:10
+#vNext
+=============================================================
+*/
@@ -0,0 +1,289 @@
+/*
+@file		access_pattern_detector.cpp
+@author		Webstar
+@date		2026-10-18 21:12
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include "access_pattern_detector.hpp"
+
+using namespace std;
+using namespace vs;
+
+// Constructor
+AccessPatternDetector::AccessPatternDetector(long int scrub_distance)
+	: stats()
+{
+	Reset(scrub_distance);
+}
+
+// Forget the requests, and start over
+void AccessPatternDetector::Reset(long int scrub_distance)
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	history.clear();
+	prefetched_frames.clear();
+	this->scrub_distance = std::max(1L, scrub_distance);
+	pattern = ACCESS_UNKNOWN;
+	stride = 0;
+	candidate = ACCESS_UNKNOWN;
+	candidate_stride = 0;
+	candidate_count = 0;
+}
+
+// Set the longest jump still considered scrubbing
+void AccessPatternDetector::SetScrubDistance(long int scrub_distance)
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	this->scrub_distance = std::max(1L, scrub_distance);
+}
+
+// Classify the requests in the history
+AccessPattern AccessPatternDetector::Classify(long int &classified_stride)
+{
+	classified_stride = 0;
+
+	if ((int)history.size() < MinHistory)
+		return ACCESS_UNKNOWN;
+
+	// Count the distances between consecutive requests
+	std::map<long int, int> counts;
+	std::vector<long int> jumps;
+	for (size_t index = 1; index < history.size(); index++)
+	{
+		long int distance = history[index] - history[index - 1];
+		counts[distance]++;
+		jumps.push_back(std::labs(distance));
+	}
+
+	// The most common distance
+	std::map<long int, int>::iterator common = counts.begin();
+	for (std::map<long int, int>::iterator itr = counts.begin(); itr != counts.end(); ++itr)
+		if (itr->second > common->second)
+			common = itr;
+
+	// Playback, reverse playback and sampling repeat the same distance (allowing for a few dropped frames)
+	if (common->second * 4 >= (int)jumps.size() * 3)
+	{
+		classified_stride = common->first;
+
+		if (classified_stride == 1)
+			return ACCESS_FORWARD;
+		else if (classified_stride == -1)
+			return ACCESS_REVERSE;
+		else
+			return ACCESS_STRIDED;
+	}
+
+	// Irregular jumps: scrubbing stays around the same area, random access doesn't
+	std::nth_element(jumps.begin(), jumps.begin() + jumps.size() / 2, jumps.end());
+	classified_stride = jumps[jumps.size() / 2];
+
+	return classified_stride <= scrub_distance ? ACCESS_SCRUB : ACCESS_RANDOM;
+}
+
+// Record a request
+void AccessPatternDetector::Record(long int frame)
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	// Count the requests for prefetched frames
+	std::set<long int>::iterator prefetched = prefetched_frames.find(frame);
+	if (prefetched != prefetched_frames.end())
+	{
+		prefetched_frames.erase(prefetched);
+		stats.prefetch_hits++;
+	}
+
+	// Repeated requests (i.e. a paused playhead) don't change the pattern
+	if (!history.empty() && history.back() == frame)
+		return;
+
+	history.push_back(frame);
+	if ((int)history.size() > MaxHistory)
+		history.pop_front();
+
+	// Keep the same classification for a few requests, before switching to it (the median distance of scrubbing
+	// and random access changes with every jump, so only their pattern needs to repeat)
+	long int classified_stride = 0;
+	AccessPattern classified = Classify(classified_stride);
+	bool is_irregular = classified == ACCESS_SCRUB || classified == ACCESS_RANDOM;
+
+	if (classified == candidate && (classified_stride == candidate_stride || is_irregular))
+		candidate_count++;
+	else
+		candidate_count = 1;
+
+	candidate = classified;
+	candidate_stride = classified_stride;
+
+	if (candidate_count >= SwitchConfirmations && (candidate != pattern || candidate_stride != stride))
+	{
+		// Scrubbing and random access only change their median distance: not a new strategy
+		if (candidate != pattern)
+		{
+			AccessPatternSwitch change = { stats.requests + 1, frame, pattern, candidate, candidate_stride };
+			switches.push_back(change);
+			if ((int)switches.size() > MaxSwitches)
+				switches.pop_front();
+
+			stats.switches++;
+		}
+
+		pattern = candidate;
+		stride = candidate_stride;
+	}
+
+	stats.requests++;
+	stats.pattern_requests[pattern]++;
+}
+
+// Record a frame decoded ahead of the requests
+void AccessPatternDetector::AddPrefetched(long int frame)
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	// Forget old prefetched frames which were never requested
+	if (prefetched_frames.size() >= 1024)
+		prefetched_frames.clear();
+
+	prefetched_frames.insert(frame);
+	stats.prefetched++;
+}
+
+// Get the current pattern
+AccessPattern AccessPatternDetector::GetPattern()
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	return pattern;
+}
+
+// Get the last recorded request
+long int AccessPatternDetector::GetLastRequest()
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	return history.empty() ? 0 : history.back();
+}
+
+// Get the strategy of the current pattern
+AccessStrategy AccessPatternDetector::GetStrategy()
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	return GetStrategy(pattern, stride);
+}
+
+// Get the strategy of a pattern
+AccessStrategy AccessPatternDetector::GetStrategy(AccessPattern pattern, long int stride)
+{
+	AccessStrategy strategy = { 0, 1, false, 1.0 };
+
+	switch (pattern)
+	{
+	case ACCESS_FORWARD:
+		// Stay a few frames ahead of the playhead, and never seek when walking is close to the cost of seeking
+		strategy.prefetch_count = 8;
+		strategy.walk_bias = 2.0;
+		break;
+
+	case ACCESS_REVERSE:
+		// Every frame before the playhead will be needed: keep the whole GOP decoded after each seek
+		strategy.prefetch_count = 8;
+		strategy.prefetch_step = -1;
+		strategy.retain_gop = true;
+		break;
+
+	case ACCESS_STRIDED:
+		// Decode the next couple of samples ahead (a larger stride is the same work as a seek each time)
+		strategy.prefetch_count = 2;
+		strategy.prefetch_step = stride;
+		break;
+
+	case ACCESS_SCRUB:
+	case ACCESS_RANDOM:
+		// The next request can't be predicted: keep the decoder free, and seek as soon as it's cheaper
+		strategy.walk_bias = 0.5;
+		break;
+
+	default:
+		break;
+	}
+
+	return strategy;
+}
+
+// Get the name of a pattern
+const char* AccessPatternDetector::GetPatternName(AccessPattern pattern)
+{
+	switch (pattern)
+	{
+	case ACCESS_FORWARD:
+		return "forward";
+	case ACCESS_REVERSE:
+		return "reverse";
+	case ACCESS_STRIDED:
+		return "strided";
+	case ACCESS_SCRUB:
+		return "scrub";
+	case ACCESS_RANDOM:
+		return "random";
+	default:
+		return "unknown";
+	}
+}
+
+// Get a snapshot of the counters
+AccessPatternStats AccessPatternDetector::GetStats()
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	AccessPatternStats snapshot = stats;
+	snapshot.pattern = pattern;
+	snapshot.stride = stride;
+
+	return snapshot;
+}
+
+// Get the last pattern changes
+std::deque<AccessPatternSwitch> AccessPatternDetector::GetSwitches()
+{
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	return switches;
+}
+
+// Reset the counters and the pattern changes
+AccessPatternStats AccessPatternDetector::ResetStats()
+{
+	AccessPatternStats snapshot = GetStats();
+
+	std::lock_guard<std::mutex> lock(detector_mutex);
+
+	stats = AccessPatternStats();
+	switches.clear();
+
+	return snapshot;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 21:12
+#vNext
+=============================================================
+*/
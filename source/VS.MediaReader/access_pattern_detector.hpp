@@ -0,0 +1,158 @@
+#ifndef GUARD_access_pattern_detector_20261018211210_
+#define GUARD_access_pattern_detector_20261018211210_
+/*
+@file		access_pattern_detector.hpp
+@author		Webstar
+@date		2026-10-18 21:12
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <deque>
+#include <mutex>
+#include <set>
+
+namespace vs
+{
+	/// @brief The way the frames of a reader are being requested
+	enum AccessPattern
+	{
+		ACCESS_UNKNOWN = 0,		///< Not enough requests yet
+		ACCESS_FORWARD,			///< Playback (each frame after the previous one)
+		ACCESS_REVERSE,			///< Reverse playback (each frame before the previous one)
+		ACCESS_STRIDED,			///< Sampling every Nth frame (i.e. thumbnails, fast forward / rewind)
+		ACCESS_SCRUB,			///< Short jumps back and forth (i.e. dragging the playhead)
+		ACCESS_RANDOM,			///< Long jumps anywhere in the file
+		ACCESS_PATTERN_COUNT
+	};
+
+	/// @brief How a reader serves the requests of an access pattern
+	struct AccessStrategy
+	{
+		int prefetch_count;		///< Number of frames to decode ahead of the requests (0 disables prefetching)
+		long int prefetch_step;	///< Distance between the prefetched frames (negative for reverse)
+		bool retain_gop;		///< Keep every frame decoded between a keyframe and the requested frame
+		double walk_bias;		///< Multiplies the seek cost in the walk / seek decision (> 1 walks further, < 1 seeks sooner)
+	};
+
+	/// @brief A change of access pattern
+	struct AccessPatternSwitch
+	{
+		long long int request;	///< The number of the request that confirmed the new pattern
+		long int frame;			///< The frame of that request
+		AccessPattern from;
+		AccessPattern to;
+		long int stride;		///< The distance between the requests of the new pattern
+	};
+
+	/// @brief This struct holds a snapshot of the counters tracked by an AccessPatternDetector
+	struct AccessPatternStats
+	{
+		long long int requests;								///< Number of recorded requests
+		long long int pattern_requests[ACCESS_PATTERN_COUNT];	///< Number of requests recorded under each pattern
+		long long int switches;								///< Number of pattern changes
+		long long int prefetched;							///< Number of frames prefetched
+		long long int prefetch_hits;						///< Number of requests for a prefetched frame
+		AccessPattern pattern;								///< The current pattern
+		long int stride;									///< The distance between the requests of the current pattern
+	};
+
+	/// @brief This class classifies the recent requests of a reader, and picks the strategy to serve them with
+	/// @remark The distances between the last requests decide the pattern: mostly +1 is playback, mostly -1 is
+	/// reverse playback, mostly the same other distance is strided sampling, and the rest is scrubbing (short
+	/// jumps) or random access (long jumps). A new pattern is only adopted once it has been seen on consecutive
+	/// requests, so a single jump during playback doesn't throw the prefetched frames away.
+	/// @code
+	/// detector.Record(requested_frame);
+	/// AccessStrategy strategy = detector.GetStrategy();
+	/// @endcode
+	class AccessPatternDetector
+	{
+	private:
+		std::mutex detector_mutex;
+
+		std::deque<long int> history;		///< The last requested frames (oldest first)
+		long int scrub_distance;
+
+		AccessPattern pattern;
+		long int stride;
+		AccessPattern candidate;			///< The pattern of the last requests, waiting to be confirmed
+		long int candidate_stride;
+		int candidate_count;
+
+		AccessPatternStats stats;
+		std::deque<AccessPatternSwitch> switches;
+		std::set<long int> prefetched_frames;	///< The prefetched frames not requested yet
+
+		/// Classify the requests in the history (the lock is held)
+		AccessPattern Classify(long int &classified_stride);
+
+	public:
+		/// Number of requests the patterns are detected from
+		static const int MaxHistory = 9;
+
+		/// Number of requests needed before detecting a pattern
+		static const int MinHistory = 4;
+
+		/// Number of consecutive requests a new pattern must be seen for, before switching to it
+		static const int SwitchConfirmations = 2;
+
+		/// Number of pattern changes kept for GetSwitches()
+		static const int MaxSwitches = 32;
+
+		/// @brief Constructor
+		/// @param scrub_distance The longest jump (in frames) still considered scrubbing, instead of random access
+		AccessPatternDetector(long int scrub_distance = 250);
+
+		/// Forget the requests, and start over (the statistics are kept)
+		void Reset(long int scrub_distance);
+
+		/// Set the longest jump (in frames) still considered scrubbing (i.e. a few seconds of the file)
+		void SetScrubDistance(long int scrub_distance);
+
+		/// Record a request (repeated requests for the same frame are ignored)
+		void Record(long int frame);
+
+		/// Record a frame decoded ahead of the requests
+		void AddPrefetched(long int frame);
+
+		/// Get the current pattern
+		AccessPattern GetPattern();
+
+		/// Get the last recorded request (0 if there is none)
+		long int GetLastRequest();
+
+		/// Get the strategy of the current pattern
+		AccessStrategy GetStrategy();
+
+		/// Get the strategy of a pattern
+		static AccessStrategy GetStrategy(AccessPattern pattern, long int stride);
+
+		/// Get the name of a pattern (i.e. for logs)
+		static const char* GetPatternName(AccessPattern pattern);
+
+		/// Get a snapshot of the counters
+		AccessPatternStats GetStats();
+
+		/// Get the last pattern changes (oldest first)
+		std::deque<AccessPatternSwitch> GetSwitches();
+
+		/// Reset the counters and the pattern changes (returns the snapshot before the reset)
+		AccessPatternStats ResetStats();
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 21:12
+#vNext
+=============================================================
+*/
+
+#endif
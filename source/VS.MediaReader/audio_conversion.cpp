@@ -0,0 +1,315 @@
+/*
+@file		audio_conversion.cpp
+@author		Webstar
+@date		2026-10-18 17:18
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VS_AUDIO_CONVERSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include "float_vector_operations.hpp"
+#include "audio_conversion.hpp"
+
+using namespace std;
+using namespace vs;
+
+namespace vs
+{
+	namespace helpers
+	{
+		/// Split interleaved samples (the channel count is known at compile time, so the inner loop is unrolled)
+		template <int Channels>
+		inline void DeinterleaveChannels(float* const* dest, const float* src, int start, int num_samples)
+		{
+			for (int sample = start; sample < num_samples; ++sample)
+			{
+				const float* frame = src + sample * Channels;
+				for (int channel = 0; channel < Channels; ++channel)
+					dest[channel][sample] = frame[channel];
+			}
+		}
+
+		/// Combine samples into interleaved samples (the channel count is known at compile time, so the inner loop is unrolled)
+		template <int Channels>
+		inline void InterleaveChannels(float* dest, const float* const* src, int start, int num_samples)
+		{
+			for (int sample = start; sample < num_samples; ++sample)
+			{
+				float* frame = dest + sample * Channels;
+				for (int channel = 0; channel < Channels; ++channel)
+					frame[channel] = src[channel][sample];
+			}
+		}
+
+		/// Split interleaved samples (any channel count)
+		inline void DeinterleaveChannels(float* const* dest, const float* src, int channels, int num_samples)
+		{
+			for (int channel = 0; channel < channels; ++channel)
+			{
+				float* channel_dest = dest[channel];
+				const float* channel_src = src + channel;
+				for (int sample = 0; sample < num_samples; ++sample, channel_src += channels)
+					channel_dest[sample] = *channel_src;
+			}
+		}
+
+		/// Combine samples into interleaved samples (any channel count)
+		inline void InterleaveChannels(float* dest, const float* const* src, int channels, int num_samples)
+		{
+			for (int channel = 0; channel < channels; ++channel)
+			{
+				const float* channel_src = src[channel];
+				float* channel_dest = dest + channel;
+				for (int sample = 0; sample < num_samples; ++sample, channel_dest += channels)
+					*channel_dest = channel_src[sample];
+			}
+		}
+	}
+}
+
+// Converts 16-bit integer samples to floats
+void AudioConversion::Int16ToFloat(float* dest, const int16_t* src, float multiplier, int num)
+{
+	int i = 0;
+
+#if VS_AUDIO_CONVERSION_SSE2
+	const __m128 mult = _mm_set1_ps(multiplier);
+	for (; i + 8 <= num; i += 8)
+	{
+		// Sign extend 8 samples to 32 bits (unpack each sample into the high half, then shift it back down)
+		const __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+		const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+
+		_mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), mult));
+		_mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), mult));
+	}
+#endif
+
+	for (; i < num; ++i)
+		dest[i] = (float)src[i] * multiplier;
+}
+
+// Converts 32-bit integer samples to floats
+void AudioConversion::Int32ToFloat(float* dest, const int32_t* src, float multiplier, int num)
+{
+	FloatVectorOperations::convertFixedToFloat(dest, (const int*)src, multiplier, num);
+}
+
+// Copies float samples, multiplying each one by the given multiplier
+void AudioConversion::FloatToFloat(float* dest, const float* src, float multiplier, int num)
+{
+	if (multiplier == 1.0f)
+		FloatVectorOperations::copy(dest, src, num);
+	else
+		FloatVectorOperations::copyWithMultiply(dest, src, multiplier, num);
+}
+
+// Converts double samples to floats
+void AudioConversion::DoubleToFloat(float* dest, const double* src, float multiplier, int num)
+{
+	int i = 0;
+
+#if VS_AUDIO_CONVERSION_SSE2
+	const __m128 mult = _mm_set1_ps(multiplier);
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+		const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+
+		_mm_storeu_ps(dest + i, _mm_mul_ps(_mm_movelh_ps(lo, hi), mult));
+	}
+#endif
+
+	for (; i < num; ++i)
+		dest[i] = (float)src[i] * multiplier;
+}
+
+// Splits interleaved samples into one buffer per channel
+void AudioConversion::Deinterleave(float* const* dest, const float* src, int channels, int num_samples)
+{
+	int sample = 0;
+
+	switch (channels)
+	{
+	case 1:
+		FloatVectorOperations::copy(dest[0], src, num_samples);
+		break;
+
+	case 2:
+#if VS_AUDIO_CONVERSION_SSE2
+		// L R L R L R L R -> L L L L / R R R R
+		for (; sample + 4 <= num_samples; sample += 4)
+		{
+			const __m128 a = _mm_loadu_ps(src + sample * 2);
+			const __m128 b = _mm_loadu_ps(src + sample * 2 + 4);
+
+			_mm_storeu_ps(dest[0] + sample, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(dest[1] + sample, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+		}
+#endif
+		helpers::DeinterleaveChannels<2>(dest, src, sample, num_samples);
+		break;
+
+	case 6:
+#if VS_AUDIO_CONVERSION_SSE2
+		// 4 samples of 6 channels are 6 vectors: the rows of channels 1-4 are transposed like a 4x4 block, and
+		// channels 5 and 6 are gathered from the pairs between them
+		for (; sample + 4 <= num_samples; sample += 4)
+		{
+			const float* frame = src + sample * 6;
+			const __m128 v0 = _mm_loadu_ps(frame), v1 = _mm_loadu_ps(frame + 4), v2 = _mm_loadu_ps(frame + 8);
+			const __m128 v3 = _mm_loadu_ps(frame + 12), v4 = _mm_loadu_ps(frame + 16), v5 = _mm_loadu_ps(frame + 20);
+
+			__m128 r0 = v0;
+			__m128 r1 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 0, 3, 2));
+			__m128 r2 = v3;
+			__m128 r3 = _mm_shuffle_ps(v4, v5, _MM_SHUFFLE(1, 0, 3, 2));
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			// Channels 5 and 6 of samples 1-2, and of samples 3-4
+			const __m128 t0 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(3, 2, 1, 0));
+			const __m128 t1 = _mm_shuffle_ps(v4, v5, _MM_SHUFFLE(3, 2, 1, 0));
+
+			_mm_storeu_ps(dest[0] + sample, r0);
+			_mm_storeu_ps(dest[1] + sample, r1);
+			_mm_storeu_ps(dest[2] + sample, r2);
+			_mm_storeu_ps(dest[3] + sample, r3);
+			_mm_storeu_ps(dest[4] + sample, _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(dest[5] + sample, _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 1, 3, 1)));
+		}
+#endif
+		helpers::DeinterleaveChannels<6>(dest, src, sample, num_samples);
+		break;
+
+	case 8:
+#if VS_AUDIO_CONVERSION_SSE2
+		// 4 samples of 8 channels are two 4x4 blocks (channels 1-4 and 5-8), which are transposed into the channels
+		for (; sample + 4 <= num_samples; sample += 4)
+		{
+			const float* frame = src + sample * 8;
+			__m128 a0 = _mm_loadu_ps(frame), a1 = _mm_loadu_ps(frame + 8), a2 = _mm_loadu_ps(frame + 16), a3 = _mm_loadu_ps(frame + 24);
+			__m128 b0 = _mm_loadu_ps(frame + 4), b1 = _mm_loadu_ps(frame + 12), b2 = _mm_loadu_ps(frame + 20), b3 = _mm_loadu_ps(frame + 28);
+
+			_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+			_MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+			_mm_storeu_ps(dest[0] + sample, a0);
+			_mm_storeu_ps(dest[1] + sample, a1);
+			_mm_storeu_ps(dest[2] + sample, a2);
+			_mm_storeu_ps(dest[3] + sample, a3);
+			_mm_storeu_ps(dest[4] + sample, b0);
+			_mm_storeu_ps(dest[5] + sample, b1);
+			_mm_storeu_ps(dest[6] + sample, b2);
+			_mm_storeu_ps(dest[7] + sample, b3);
+		}
+#endif
+		helpers::DeinterleaveChannels<8>(dest, src, sample, num_samples);
+		break;
+
+	default:
+		helpers::DeinterleaveChannels(dest, src, channels, num_samples);
+		break;
+	}
+}
+
+// Combines one buffer per channel into interleaved samples
+void AudioConversion::Interleave(float* dest, const float* const* src, int channels, int num_samples)
+{
+	int sample = 0;
+
+	switch (channels)
+	{
+	case 1:
+		FloatVectorOperations::copy(dest, src[0], num_samples);
+		break;
+
+	case 2:
+#if VS_AUDIO_CONVERSION_SSE2
+		// L L L L / R R R R -> L R L R L R L R
+		for (; sample + 4 <= num_samples; sample += 4)
+		{
+			const __m128 l = _mm_loadu_ps(src[0] + sample);
+			const __m128 r = _mm_loadu_ps(src[1] + sample);
+
+			_mm_storeu_ps(dest + sample * 2, _mm_unpacklo_ps(l, r));
+			_mm_storeu_ps(dest + sample * 2 + 4, _mm_unpackhi_ps(l, r));
+		}
+#endif
+		helpers::InterleaveChannels<2>(dest, src, sample, num_samples);
+		break;
+
+	case 6:
+#if VS_AUDIO_CONVERSION_SSE2
+		// The reverse of Deinterleave: channels 1-4 are transposed into rows, and channels 5 and 6 fill the pairs between them
+		for (; sample + 4 <= num_samples; sample += 4)
+		{
+			float* frame = dest + sample * 6;
+			__m128 r0 = _mm_loadu_ps(src[0] + sample), r1 = _mm_loadu_ps(src[1] + sample), r2 = _mm_loadu_ps(src[2] + sample), r3 = _mm_loadu_ps(src[3] + sample);
+			const __m128 c4 = _mm_loadu_ps(src[4] + sample), c5 = _mm_loadu_ps(src[5] + sample);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			// Channels 5 and 6 of samples 1-2, and of samples 3-4
+			const __m128 t0 = _mm_unpacklo_ps(c4, c5);
+			const __m128 t1 = _mm_unpackhi_ps(c4, c5);
+
+			_mm_storeu_ps(frame, r0);
+			_mm_storeu_ps(frame + 4, _mm_shuffle_ps(t0, r1, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm_storeu_ps(frame + 8, _mm_shuffle_ps(r1, t0, _MM_SHUFFLE(3, 2, 3, 2)));
+			_mm_storeu_ps(frame + 12, r2);
+			_mm_storeu_ps(frame + 16, _mm_shuffle_ps(t1, r3, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm_storeu_ps(frame + 20, _mm_shuffle_ps(r3, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+		}
+#endif
+		helpers::InterleaveChannels<6>(dest, src, sample, num_samples);
+		break;
+
+	case 8:
+#if VS_AUDIO_CONVERSION_SSE2
+		// Transpose 4 samples of channels 1-4 and 5-8 into two 4x4 blocks of 4 samples
+		for (; sample + 4 <= num_samples; sample += 4)
+		{
+			float* frame = dest + sample * 8;
+			__m128 a0 = _mm_loadu_ps(src[0] + sample), a1 = _mm_loadu_ps(src[1] + sample), a2 = _mm_loadu_ps(src[2] + sample), a3 = _mm_loadu_ps(src[3] + sample);
+			__m128 b0 = _mm_loadu_ps(src[4] + sample), b1 = _mm_loadu_ps(src[5] + sample), b2 = _mm_loadu_ps(src[6] + sample), b3 = _mm_loadu_ps(src[7] + sample);
+
+			_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+			_MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+			_mm_storeu_ps(frame, a0);
+			_mm_storeu_ps(frame + 4, b0);
+			_mm_storeu_ps(frame + 8, a1);
+			_mm_storeu_ps(frame + 12, b1);
+			_mm_storeu_ps(frame + 16, a2);
+			_mm_storeu_ps(frame + 20, b2);
+			_mm_storeu_ps(frame + 24, a3);
+			_mm_storeu_ps(frame + 28, b3);
+		}
+#endif
+		helpers::InterleaveChannels<8>(dest, src, sample, num_samples);
+		break;
+
+	default:
+		helpers::InterleaveChannels(dest, src, channels, num_samples);
+		break;
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 17:18
+#vNext
+=============================================================
+*/
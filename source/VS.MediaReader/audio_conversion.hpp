@@ -0,0 +1,59 @@
+#ifndef GUARD_audio_conversion_20261018171830_
+#define GUARD_audio_conversion_20261018171830_
+/*
+@file		audio_conversion.hpp
+@author		Webstar
+@date		2026-10-18 17:18
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstdint>
+
+namespace vs
+{
+	/// @brief A collection of conversions between the sample formats decoded by FFmpeg and float audio
+	/// @remark The conversions run 4 or 8 samples at a time (SSE2), and the transforms between interleaved and
+	/// planar samples are specialized for 1, 2, 6 and 8 channels (4 samples at a time, any other count uses a
+	/// generic loop).
+	class AudioConversion
+	{
+	public:
+		/// Converts 16-bit integer samples to floats, multiplying each one by the given multiplier (i.e. 1 / 32768)
+		static void Int16ToFloat(float* dest, const int16_t* src, float multiplier, int num);
+
+		/// Converts 32-bit integer samples to floats, multiplying each one by the given multiplier (i.e. 1 / 2147483648)
+		static void Int32ToFloat(float* dest, const int32_t* src, float multiplier, int num);
+
+		/// Copies float samples, multiplying each one by the given multiplier
+		static void FloatToFloat(float* dest, const float* src, float multiplier, int num);
+
+		/// Converts double samples to floats, multiplying each one by the given multiplier
+		static void DoubleToFloat(float* dest, const double* src, float multiplier, int num);
+
+		/// @brief Splits interleaved samples (channel 1, channel 2, channel 1, channel 2, etc...) into one buffer per channel
+		/// @param dest One buffer per channel, each with room for num_samples
+		/// @param src The interleaved samples (num_samples * channels values)
+		static void Deinterleave(float* const* dest, const float* src, int channels, int num_samples);
+
+		/// @brief Combines one buffer per channel into interleaved samples (channel 1, channel 2, channel 1, channel 2, etc...)
+		/// @param dest Room for num_samples * channels values
+		/// @param src One buffer per channel, each with num_samples
+		static void Interleave(float* dest, const float* const* src, int channels, int num_samples);
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 17:18
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,192 @@
+/*
+@file		buffer_pool.cpp
+@author		Webstar
+@date		2026-10-18 09:30
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+#include "buffer_pool.hpp"
+
+using namespace std;
+using namespace vs;
+
+// Constructor
+PixelBufferPool::PixelBufferPool(size_t buffer_size, int max_free_buffers)
+	: buffer_size(buffer_size), max_free_buffers(max_free_buffers)
+{
+}
+
+// Destructor
+PixelBufferPool::~PixelBufferPool()
+{
+	Clear();
+}
+
+// Allocate a new buffer (header + aligned pixel data)
+PixelBuffer* PixelBufferPool::Allocate(size_t size)
+{
+	// The header is padded, so the pixel data that follows it is also aligned
+	size_t header_size = (sizeof(PixelBuffer) + Alignment - 1) & ~(Alignment - 1);
+
+	void *allocation = std::malloc(header_size + size + Alignment);
+	if (allocation == NULL)
+		throw std::bad_alloc();
+
+	uintptr_t aligned = ((uintptr_t)allocation + Alignment - 1) & ~(uintptr_t)(Alignment - 1);
+
+	PixelBuffer *buffer = new ((void*)aligned) PixelBuffer();
+	buffer->allocation = allocation;
+	buffer->size = size;
+	buffer->data = (unsigned char*)aligned + header_size;
+
+	return buffer;
+}
+
+// Free a buffer (and its pixel data)
+void PixelBufferPool::Free(PixelBuffer *buffer)
+{
+	void *allocation = buffer->allocation;
+	buffer->~PixelBuffer();
+	std::free(allocation);
+}
+
+// Get a buffer from the pool (or allocate a new one, if the pool is empty)
+PixelBuffer* PixelBufferPool::Acquire()
+{
+	PixelBuffer *buffer = NULL;
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+
+		if (!free_buffers.empty())
+		{
+			buffer = free_buffers.back();
+			free_buffers.pop_back();
+		}
+	}
+
+	if (buffer == NULL)
+		buffer = Allocate(buffer_size);
+
+	// Keep the pool alive while this buffer is outstanding
+	buffer->pool = sharedFromThis();
+	buffer->references = 1;
+
+	return buffer;
+}
+
+// Allocate a buffer which is not owned by any pool
+PixelBuffer* PixelBufferPool::AcquireUnpooled(size_t size)
+{
+	PixelBuffer *buffer = Allocate(size);
+	buffer->references = 1;
+
+	return buffer;
+}
+
+// Add a reference to a buffer
+void PixelBufferPool::Retain(PixelBuffer *buffer)
+{
+	if (buffer)
+		buffer->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Drop a reference to a buffer (the last one sends it back to its pool, or frees it if it has no pool)
+void PixelBufferPool::Release(PixelBuffer *buffer)
+{
+	if (buffer == NULL)
+		return;
+
+	// Other views (image or audio) still use this buffer
+	if (buffer->references.fetch_sub(1, std::memory_order_acq_rel) > 1)
+		return;
+
+	// Buffers sitting in the pool must not keep the pool alive
+	QSharedPointer<PixelBufferPool> pool = buffer->pool;
+	buffer->pool.reset();
+
+	if (pool)
+		pool->Recycle(buffer);
+	else
+		Free(buffer);
+}
+
+// Put a released buffer back in the pool
+void PixelBufferPool::Recycle(PixelBuffer *buffer)
+{
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+
+		if (buffer->size == buffer_size && (int)free_buffers.size() < max_free_buffers)
+		{
+			free_buffers.push_back(buffer);
+			return;
+		}
+	}
+
+	// The pool is full (or the buffer is the wrong size)
+	Free(buffer);
+}
+
+// Get the size (in bytes) of the pixel data of each buffer
+size_t PixelBufferPool::GetBufferSize()
+{
+	std::lock_guard<std::mutex> lock(pool_mutex);
+
+	return buffer_size;
+}
+
+// Change the size of the buffers handed out by this pool
+void PixelBufferPool::SetBufferSize(size_t new_buffer_size)
+{
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+
+		if (new_buffer_size == buffer_size)
+			return;
+
+		buffer_size = new_buffer_size;
+	}
+
+	// Free the buffers of the old size
+	Clear();
+}
+
+// Count the released buffers sitting in the pool
+int PixelBufferPool::CountFree()
+{
+	std::lock_guard<std::mutex> lock(pool_mutex);
+
+	return free_buffers.size();
+}
+
+// Free all released buffers sitting in the pool
+void PixelBufferPool::Clear()
+{
+	std::vector<PixelBuffer*> buffers;
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+
+		buffers.swap(free_buffers);
+	}
+
+	for (size_t i = 0; i < buffers.size(); i++)
+		Free(buffers[i]);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 09:30
+#vNext
+=============================================================
+*/
@@ -0,0 +1,121 @@
+#ifndef GUARD_buffer_pool_20261018093012_
+#define GUARD_buffer_pool_20261018093012_
+/*
+@file		buffer_pool.hpp
+@author		Webstar
+@date		2026-10-18 09:30
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// QT
+#include <QSharedPointer>
+
+namespace vs
+{
+	class PixelBufferPool;
+
+	/// @brief A block of aligned pixel memory handed out by a PixelBufferPool.
+	/// @remark The header and the pixel data live in a single allocation. A pointer to this header
+	/// is used as the cleanup info of the QImage that wraps the pixels, so the buffer can find its
+	/// way back to the pool (see Frame::CleanUpBuffer). Frames also keep their audio channels in the
+	/// same block, so the buffer is reference counted: it is released once every view of it is gone.
+	struct PixelBuffer
+	{
+		QSharedPointer<PixelBufferPool> pool;	///< The pool this buffer returns to (NULL when not pooled, or while sitting in the pool)
+		std::atomic<int> references;			///< The number of outstanding references (the buffer is recycled when it drops to 0)
+		void *allocation;						///< The raw allocation (header + pixel data)
+		size_t size;							///< The size of the pixel data (in bytes)
+		unsigned char *data;					///< The aligned pixel data
+	};
+
+	/// @brief This class recycles pixel buffers of a fixed size.
+	/// @remark Readers decode a steady stream of frames with the same output format, so instead of
+	/// allocating (and zero filling) a new buffer for every frame, released buffers are kept in the pool
+	/// and handed out again. Outstanding buffers keep the pool alive, so frames can safely outlive their reader.
+	/// @code
+	/// QSharedPointer<PixelBufferPool> pool(new PixelBufferPool(width * height * 4, 8));
+	/// PixelBuffer *buffer = pool->Acquire();
+	/// // ... fill buffer->data ...
+	/// PixelBufferPool::Release(buffer); // back to the pool (once the last reference is dropped)
+	/// @endcode
+	class PixelBufferPool : public QEnableSharedFromThis<PixelBufferPool>
+	{
+	private:
+		std::mutex pool_mutex;
+
+		size_t buffer_size;							///< The size (in bytes) of the pixel data of each buffer
+		int max_free_buffers;						///< The maximum number of released buffers to keep around
+		std::vector<PixelBuffer*> free_buffers;		///< Released buffers, ready to be handed out again
+
+		/// Allocate a new buffer (header + aligned pixel data)
+		static PixelBuffer* Allocate(size_t size);
+
+		/// Free a buffer (and its pixel data)
+		static void Free(PixelBuffer *buffer);
+
+		/// Put a released buffer back in the pool (or free it, if the pool is full or the size has changed)
+		void Recycle(PixelBuffer *buffer);
+
+	public:
+		/// Alignment (in bytes) of the pixel data of every buffer
+		static const size_t Alignment = 64;
+
+		/// @brief Constructor
+		/// @param buffer_size The size (in bytes) of the pixel data of each buffer
+		/// @param max_free_buffers The maximum number of released buffers to keep around
+		PixelBufferPool(size_t buffer_size, int max_free_buffers);
+
+		/// Destructor
+		~PixelBufferPool();
+
+		/// @brief Get a buffer from the pool (or allocate a new one, if the pool is empty)
+		/// @remark The contents of the buffer are undefined, and the caller holds the only reference.
+		/// The pool must be owned by a QSharedPointer.
+		PixelBuffer* Acquire();
+
+		/// Allocate a buffer which is not owned by any pool (it is freed when released)
+		static PixelBuffer* AcquireUnpooled(size_t size);
+
+		/// Add a reference to a buffer (each reference needs a matching call to Release)
+		static void Retain(PixelBuffer *buffer);
+
+		/// Drop a reference to a buffer (the last one sends it back to its pool, or frees it if it has no pool)
+		static void Release(PixelBuffer *buffer);
+
+		/// Get the size (in bytes) of the pixel data of each buffer
+		size_t GetBufferSize();
+
+		/// @brief Change the size of the buffers handed out by this pool
+		/// @remark Released buffers of the old size are freed.
+		void SetBufferSize(size_t new_buffer_size);
+
+		/// Get the number of bytes per line of an image, padded so every line starts on an aligned address
+		static int GetAlignedStride(int width, int bytes_per_pixel) { return (int)((width * bytes_per_pixel + Alignment - 1) & ~(Alignment - 1)); }
+
+		/// Count the released buffers sitting in the pool
+		int CountFree();
+
+		/// Free all released buffers sitting in the pool
+		void Clear();
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 09:30
+#vNext
+=============================================================
+*/
+
+#endif
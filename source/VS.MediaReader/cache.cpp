@@ -14,13 +14,15 @@ using namespace vs;
 
 // Default constructor, no max frames
 FrameCache::FrameCache()
-	: max_bytes(0), needs_range_processing(false)
+	: max_bytes(0), needs_range_processing(false), resident_bytes(0), max_pinned_bytes(0), frame_bytes(0), shared_bytes(0),
+	stats(), total_residency(0.0), stats_started(std::chrono::steady_clock::now())
 {
 };
 
 // Constructor that sets the max frames to cache
 FrameCache::FrameCache(long long int max_bytes)
-	: max_bytes(max_bytes), needs_range_processing(false)
+	: max_bytes(max_bytes), needs_range_processing(false), resident_bytes(0), max_pinned_bytes(0), frame_bytes(0), shared_bytes(0),
+	stats(), total_residency(0.0), stats_started(std::chrono::steady_clock::now())
 {
 };
 
@@ -31,14 +33,16 @@ FrameCache::~FrameCache()
 	frames.clear();
 	frame_numbers.clear();
 	ordered_frame_numbers.clear();
+	entries.clear();
+	image_references.clear();
 }
 
 // Set maximum bytes to a different amount based on a ReaderInfo struct
 void FrameCache::SetMaxBytesFromInfo(long int number_of_frames, int width, int height, int sample_rate, int channels)
 {
 	// n frames X height X width X 4 colors of chars X audio channels X 4 byte floats
-	long long int bytes = number_of_frames * (height * width * 4 + (sample_rate * channels * 4));
-	SetMaxBytes(bytes);
+	frame_bytes = (long long int)height * width * 4 + (sample_rate * channels * 4);
+	SetMaxBytes(number_of_frames * frame_bytes);
 }
 
 
@@ -48,7 +52,7 @@ void FrameCache::CalculateRanges()
 	// Only calculate when something has changed
 	if (needs_range_processing)
 	{
-		//std::lock_guard<std::mutex> lock(cache_mutex);
+		std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
 		// Build up screen ranges as a data structure
 
@@ -61,14 +65,25 @@ void FrameCache::CalculateRanges()
 // Add a Frame to the cache
 void FrameCache::Add(QSharedPointer<Frame> frame)
 {
-	//std::lock_guard<std::mutex> lock(cache_mutex);
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
 	long int frame_number = frame->number;
+	long int frame_bytes = frame->GetBytes();
+	long int image_bytes = frame->GetImageBytes();
+	qint64 image_key = frame->GetImageKey();
 
 	// Freshen frame if it already exists
 	if (frames.count(frame_number))
 	{
 		MoveToFront(frame_number);
+
+		// The frame might have grown since it was added (i.e. more audio samples or an image)
+		CacheEntry &entry = entries[frame_number];
+		UntrackBytes(entry);
+		entry.bytes = frame_bytes;
+		entry.image_bytes = image_bytes;
+		entry.image_key = image_key;
+		TrackBytes(entry);
 	}
 	else
 	{
@@ -78,77 +93,208 @@ void FrameCache::Add(QSharedPointer<Frame> frame)
 		ordered_frame_numbers.push_back(frame_number);
 		needs_range_processing = true;
 
+		// Track frame
+		CacheEntry entry = { frame_bytes, image_bytes, image_key, std::chrono::steady_clock::now() };
+		entries[frame_number] = entry;
+		TrackBytes(entry);
+		stats.inserts++;
+
 		CleanUp();
 	}
+
+	// Update peak bytes
+	if (resident_bytes > stats.peak_bytes)
+		stats.peak_bytes = resident_bytes;
 }
 
 
 // Get a frame from the cache (or NULL shared_ptr if no frame is found)
 QSharedPointer<Frame> FrameCache::GetFrame(long int frame_number)
 {
-	//std::lock_guard<std::mutex> lock(cache_mutex);
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
 	if (frames.count(frame_number))
 	{
+		stats.hits++;
 		return frames[frame_number];
 	}
 	else
 	{
+		stats.misses++;
 		return QSharedPointer<Frame>();
 	}
 }
 
 
+// Check if a frame is in the cache (without counting a hit or a miss)
+bool FrameCache::Contains(long int frame_number)
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	return frames.count(frame_number) > 0;
+}
+
+
+// Get the cached frame closest to a frame number (or NULL shared_ptr if none is close enough)
+QSharedPointer<Frame> FrameCache::GetClosestFrame(long int frame_number, long int max_distance)
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	// The first frame at (or after) the frame number, and the one before it
+	std::map<long int, QSharedPointer<Frame>>::iterator after = frames.lower_bound(frame_number);
+	std::map<long int, QSharedPointer<Frame>>::iterator closest = frames.end();
+
+	if (after != frames.end() && after->first - frame_number <= max_distance)
+		closest = after;
+
+	if (after != frames.begin())
+	{
+		std::map<long int, QSharedPointer<Frame>>::iterator before = std::prev(after);
+		if (frame_number - before->first <= max_distance && (closest == frames.end() || frame_number - before->first <= closest->first - frame_number))
+			closest = before;
+	}
+
+	return closest != frames.end() ? closest->second : QSharedPointer<Frame>();
+}
+
+
 // Get the smallest frame number (or NULL shared_ptr if no frame is found)
 QSharedPointer<Frame> FrameCache::GetSmallestFrame()
 {
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
 	QSharedPointer<Frame> f;
 	long int smallest_frame = -1;
 
+	deque<long int>::iterator itr;	
+	for (itr = frame_numbers.begin(); itr != frame_numbers.end(); ++itr)
 	{
-		//std::lock_guard<std::mutex> lock(cache_mutex);
-
-		deque<long int>::iterator itr;	
-		for (itr = frame_numbers.begin(); itr != frame_numbers.end(); ++itr)
-		{
-			if (*itr < smallest_frame || smallest_frame == -1)
-				smallest_frame = *itr;
-		}
+		if (*itr < smallest_frame || smallest_frame == -1)
+			smallest_frame = *itr;
 	}
 	
-	// Return frame
-	f = GetFrame(smallest_frame);
+	// Return frame (this is an internal lookup, so it is not counted as a hit or miss)
+	if (frames.count(smallest_frame))
+		f = frames[smallest_frame];
 
 	return f;
 }
 
 
-// Gets the maximum bytes value
+// Gets the number of bytes used by all cached frames
 long long int FrameCache::GetBytes()
 {
-	//std::lock_guard<std::mutex> lock(cache_mutex);
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
-	long long int total_bytes = 0;
+	return resident_bytes;
+}
 
-	deque<long int>::reverse_iterator itr;
-	for (itr = frame_numbers.rbegin(); itr != frame_numbers.rend(); ++itr)
+// Get a snapshot of the cache statistics
+CacheStats FrameCache::GetStats()
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	CacheStats snapshot = stats;
+	snapshot.bytes = resident_bytes;
+	snapshot.shared_bytes = shared_bytes;
+	snapshot.frames = frames.size();
+
+	// Average residency of the evicted frames
+	long long int total_evictions = 0;
+	for (int reason = 0; reason < EVICTION_REASON_COUNT; reason++)
+		total_evictions += stats.evictions[reason];
+
+	snapshot.average_residency = total_evictions > 0 ? total_residency / total_evictions : 0.0;
+	snapshot.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - stats_started).count();
+
+	return snapshot;
+}
+
+// Get a snapshot of the cache statistics, and reset the counters
+CacheStats FrameCache::ResetStats()
+{
+	CacheStats snapshot = GetStats();
+
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	stats.hits = 0;
+	stats.misses = 0;
+	stats.inserts = 0;
+	for (int reason = 0; reason < EVICTION_REASON_COUNT; reason++)
+		stats.evictions[reason] = 0;
+	stats.bytes = 0;
+	stats.peak_bytes = resident_bytes;
+	stats.shared_bytes = 0;
+	stats.frames = 0;
+	stats.average_residency = 0.0;
+	stats.elapsed = 0.0;
+	total_residency = 0.0;
+	stats_started = std::chrono::steady_clock::now();
+
+	return snapshot;
+}
+
+// Count a frame as evicted for the given reason
+void FrameCache::TrackEviction(long int frame_number, CacheEvictionReason reason)
+{
+	map<long int, CacheEntry>::iterator entry = entries.find(frame_number);
+	if (entry != entries.end())
 	{
-		total_bytes += frames[*itr]->GetBytes();
+		UntrackBytes(entry->second);
+		total_residency += std::chrono::duration<double>(std::chrono::steady_clock::now() - entry->second.inserted).count();
+		stats.evictions[reason]++;
+		entries.erase(entry);
 	}
+}
 
-	return total_bytes;
+// Add the bytes of a cached frame to the resident bytes
+void FrameCache::TrackBytes(const CacheEntry &entry)
+{
+	resident_bytes += entry.bytes;
+
+	// Another cached frame already holds these pixels
+	if (entry.image_key != 0 && image_references[entry.image_key]++ > 0)
+	{
+		resident_bytes -= entry.image_bytes;
+		shared_bytes += entry.image_bytes;
+	}
+}
+
+// Remove the bytes of a cached frame from the resident bytes
+void FrameCache::UntrackBytes(const CacheEntry &entry)
+{
+	resident_bytes -= entry.bytes;
+
+	if (entry.image_key != 0)
+	{
+		map<qint64, int>::iterator references = image_references.find(entry.image_key);
+		if (references != image_references.end() && --references->second > 0)
+		{
+			// Other cached frames still hold these pixels (so they were only counted once)
+			resident_bytes += entry.image_bytes;
+			shared_bytes -= entry.image_bytes;
+		}
+		else if (references != image_references.end())
+			image_references.erase(references);
+	}
 }
 
 // Remove a specific frame
 void FrameCache::Remove(long int frame_number)
 {
-	Remove(frame_number, frame_number);
+	Remove(frame_number, frame_number, EVICTION_REMOVED);
 }
 
 // Remove range of frames
 void FrameCache::Remove(long int start_frame_number, long int end_frame_number)
 {
-	//std::lock_guard<std::mutex> lock(cache_mutex);
+	Remove(start_frame_number, end_frame_number, EVICTION_REMOVED);
+}
+
+// Remove range of frames, and count them as evicted for the given reason
+void FrameCache::Remove(long int start_frame_number, long int end_frame_number, CacheEvictionReason reason)
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
 	// Loop through frame numbers
 	deque<long int>::iterator itr;
@@ -170,6 +316,7 @@ void FrameCache::Remove(long int start_frame_number, long int end_frame_number)
 		if (*itr_ordered >= start_frame_number && *itr_ordered <= end_frame_number)
 		{
 			// erase frame number
+			TrackEviction(*itr_ordered, reason);
 			frames.erase(*itr_ordered);
 			itr_ordered = ordered_frame_numbers.erase(itr_ordered);
 		}
@@ -185,7 +332,7 @@ void FrameCache::Remove(long int start_frame_number, long int end_frame_number)
 // Move frame to front of queue (so it lasts longer)
 void FrameCache::MoveToFront(long int frame_number)
 {
-	//std::lock_guard<std::mutex> lock(cache_mutex);
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
 	// Does frame exists in cache?
 	if (frames.count(frame_number))
@@ -207,18 +354,141 @@ void FrameCache::MoveToFront(long int frame_number)
 // Clear the cache of all frames
 void FrameCache::Clear()
 {
-	//std::lock_guard<std::mutex> lock(cache_mutex);
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	// Track all frames as cleared
+	vector<long int>::iterator itr;
+	for (itr = ordered_frame_numbers.begin(); itr != ordered_frame_numbers.end(); ++itr)
+		TrackEviction(*itr, EVICTION_CLEARED);
 
 	frames.clear();
 	frame_numbers.clear();
 	ordered_frame_numbers.clear();
+	entries.clear();
+	image_references.clear();
+	resident_bytes = 0;
+	shared_bytes = 0;
 	needs_range_processing = true;
 }
 
+// Pin a range of frames
+long int FrameCache::Pin(long int start_frame_number, long int end_frame_number)
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	if (start_frame_number > end_frame_number)
+		return start_frame_number - 1;
+
+	// Cut the range short, so the pinned frames fit in the max pinned bytes (overlapping ranges count twice)
+	if (max_pinned_bytes > 0 && frame_bytes > 0)
+	{
+		long long int pinned_frames = 0;
+		multimap<long int, long int>::iterator itr;
+		for (itr = pinned_ranges.begin(); itr != pinned_ranges.end(); ++itr)
+			pinned_frames += itr->second - itr->first + 1;
+
+		long long int free_frames = max_pinned_bytes / frame_bytes - pinned_frames;
+		if (free_frames <= 0)
+			return start_frame_number - 1;
+
+		if (end_frame_number - start_frame_number + 1 > free_frames)
+			end_frame_number = start_frame_number + (long int)free_frames - 1;
+	}
+
+	pinned_ranges.insert(make_pair(start_frame_number, end_frame_number));
+	return end_frame_number;
+}
+
+// Unpin the frames of a range
+void FrameCache::Unpin(long int start_frame_number, long int end_frame_number)
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	if (start_frame_number > end_frame_number)
+		return;
+
+	// Each frame of the range loses one pin: the first range pinning a frame is trimmed, and the frames it didn't
+	// pin are left for the next ranges (so the ranges overlapping twice keep one of their pins)
+	vector<pair<long int, long int>> releasing(1, make_pair(start_frame_number, end_frame_number));
+	multimap<long int, long int> trimmed_ranges;
+	multimap<long int, long int>::iterator itr;
+	for (itr = pinned_ranges.begin(); itr != pinned_ranges.end(); ++itr)
+	{
+		long int kept_start = itr->first;
+		vector<pair<long int, long int>> still_releasing;
+		vector<pair<long int, long int>>::iterator released;
+		for (released = releasing.begin(); released != releasing.end(); ++released)
+		{
+			long int overlap_start = std::max(itr->first, released->first);
+			long int overlap_end = std::min(itr->second, released->second);
+			if (overlap_start > overlap_end)
+			{
+				still_releasing.push_back(*released);
+				continue;
+			}
+
+			// Keep the part of the range before the overlap (the releasing ranges are in order)
+			if (kept_start < overlap_start)
+				trimmed_ranges.insert(make_pair(kept_start, overlap_start - 1));
+			kept_start = overlap_end + 1;
+
+			// The parts of the released range outside this range still need to lose a pin
+			if (released->first < overlap_start)
+				still_releasing.push_back(make_pair(released->first, overlap_start - 1));
+			if (released->second > overlap_end)
+				still_releasing.push_back(make_pair(overlap_end + 1, released->second));
+		}
+
+		if (kept_start <= itr->second)
+			trimmed_ranges.insert(make_pair(kept_start, itr->second));
+
+		releasing.swap(still_releasing);
+	}
+
+	pinned_ranges.swap(trimmed_ranges);
+}
+
+// Remove the frames of a range which aren't pinned anymore
+void FrameCache::RemoveUnpinned(long int start_frame_number, long int end_frame_number)
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	vector<long int> unpinned_frames;
+	vector<long int>::iterator itr;
+	for (itr = ordered_frame_numbers.begin(); itr != ordered_frame_numbers.end(); ++itr)
+		if (*itr >= start_frame_number && *itr <= end_frame_number && !IsPinned(*itr))
+			unpinned_frames.push_back(*itr);
+
+	for (itr = unpinned_frames.begin(); itr != unpinned_frames.end(); ++itr)
+		Remove(*itr);
+}
+
+// Check if a frame is in a pinned range
+bool FrameCache::IsPinned(long int frame_number)
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	// Only the ranges starting at (or before) the frame can contain it
+	multimap<long int, long int>::iterator itr;
+	for (itr = pinned_ranges.begin(); itr != pinned_ranges.end() && itr->first <= frame_number; ++itr)
+		if (itr->second >= frame_number)
+			return true;
+
+	return false;
+}
+
+// Get the pinned ranges
+vector<pair<long int, long int>> FrameCache::GetPinnedRanges()
+{
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+
+	return vector<pair<long int, long int>>(pinned_ranges.begin(), pinned_ranges.end());
+}
+
 // Count the frames in the queue
 long int FrameCache::Count()
 {
-	//std::lock_guard<std::mutex> lock(cache_mutex);
+	std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
 	return frames.size();
 }
@@ -229,12 +499,17 @@ void FrameCache::CleanUp()
 	// Do we auto clean up?
 	if (max_bytes > 0)
 	{
-		//std::lock_guard<std::mutex> lock(cache_mutex);
+		std::lock_guard<std::recursive_mutex> lock(cache_mutex);
 
-		while (GetBytes() > max_bytes && frame_numbers.size() > 20)
+		// Purge the oldest frames first (skipping the pinned ones)
+		size_t index = frame_numbers.size();
+		while (GetBytes() > max_bytes && frame_numbers.size() > 20 && index > 0)
 		{
-			long int frame_to_remove = frame_numbers.back();
-			Remove(frame_to_remove);
+			long int frame_to_remove = frame_numbers[--index];
+			if (IsPinned(frame_to_remove))
+				continue;
+
+			Remove(frame_to_remove, frame_to_remove, EVICTION_CAPACITY);
 		}
 	}
 }
@@ -15,6 +15,8 @@
 #include <vector>
 #include <deque>
 #include <mutex>
+#include <chrono>
+#include <algorithm>
 
 #include "frame.hpp"
 
@@ -22,6 +24,31 @@ using namespace vs;
 
 namespace vs
 {
+	/// @brief The reason a frame was evicted from a FrameCache
+	enum CacheEvictionReason
+	{
+		EVICTION_CAPACITY = 0,		///< The cache exceeded its max bytes, and the oldest frame was purged
+		EVICTION_REMOVED,			///< The frame was explicitly removed (i.e. moved to another cache)
+		EVICTION_CLEARED,			///< The whole cache was cleared (i.e. after a seek or close)
+		EVICTION_REASON_COUNT
+	};
+
+	/// @brief This struct holds a snapshot of the counters tracked by a FrameCache.
+	/// @remark Use these numbers to size each cache from real data instead of guesses.
+	struct CacheStats
+	{
+		long long int hits;									///< Number of GetFrame() calls that found the frame
+		long long int misses;								///< Number of GetFrame() calls that did not find the frame
+		long long int inserts;								///< Number of new frames added to the cache
+		long long int evictions[EVICTION_REASON_COUNT];		///< Number of frames evicted, indexed by CacheEvictionReason
+		long long int bytes;								///< Number of bytes currently resident in the cache
+		long long int peak_bytes;							///< Largest number of bytes resident since the last reset
+		long long int shared_bytes;							///< Number of image bytes shared between cached frames (only counted once in bytes)
+		long int frames;									///< Number of frames currently resident in the cache
+		double average_residency;							///< Average time (in seconds) an evicted frame stayed in the cache
+		double elapsed;										///< Time (in seconds) since the counters were last reset
+	};
+
 	/// @brief This class is a memory-based cache manager for Frame objects.
 	/// @remark It is used by readers to cache recently accessed frames. Due to the
 	/// high cost of decoding streams, once a frame is decoded, converted to RGB, and a Frame object is created,
@@ -29,7 +56,7 @@ namespace vs
 	/// is required.  You can set the max number of bytes to cache.
 	class FrameCache {
 	private:
-		std::mutex cache_mutex;
+		std::recursive_mutex cache_mutex;						///< Guards everything below (recursive, since the public methods call each other)
 
 		long long int max_bytes;
 
@@ -40,8 +67,40 @@ namespace vs
 		std::vector<long int> ordered_frame_numbers;			///< Ordered list of frame numbers used by cache
 		std::map<long int, long int> frame_ranges;				///< This map holds the ranges of frames, useful for quickly displaying the contents of the cache
 
+		/// Bookkeeping for a single cached frame (used by the statistics)
+		struct CacheEntry
+		{
+			long int bytes;										///< Size of the frame the last time it was added
+			long int image_bytes;								///< Size of the frame's image (included in bytes)
+			qint64 image_key;									///< Key of the frame's image pixels (0 if there is no image)
+			std::chrono::steady_clock::time_point inserted;		///< When the frame entered the cache
+		};
+
+		std::map<long int, CacheEntry> entries;					///< This map holds the bookkeeping of each cached frame
+		std::map<qint64, int> image_references;					///< This map holds the number of cached frames sharing each image
+		long long int resident_bytes;							///< Sum of the bytes of all cached frames (shared images are only counted once)
+		std::multimap<long int, long int> pinned_ranges;		///< The ranges of frames which are never purged (start frame, end frame)
+		long long int max_pinned_bytes;							///< The most bytes the pinned ranges can hold (0 for no limit)
+		long long int frame_bytes;								///< The bytes of a frame (see SetMaxBytesFromInfo, 0 if unknown)
+		long long int shared_bytes;								///< Sum of the image bytes which are not counted, since another frame shares them
+		CacheStats stats;										///< Counters since the last reset
+		double total_residency;									///< Sum of the residency time (in seconds) of all evicted frames
+		std::chrono::steady_clock::time_point stats_started;	///< When the counters were last reset
+
 		void CleanUp();
 
+		/// Remove a range of frames, and count them as evicted for the given reason
+		void Remove(long int start_frame_number, long int end_frame_number, CacheEvictionReason reason);
+
+		/// Count a frame as evicted for the given reason
+		void TrackEviction(long int frame_number, CacheEvictionReason reason);
+
+		/// Add the bytes of a cached frame to the resident bytes (the image is only counted for the first frame using it)
+		void TrackBytes(const CacheEntry &entry);
+
+		/// Remove the bytes of a cached frame from the resident bytes (the image is only removed with the last frame using it)
+		void UntrackBytes(const CacheEntry &entry);
+
 		void CalculateRanges();
 
 	public:
@@ -65,13 +124,30 @@ namespace vs
 		/// Count the frames in the queue
 		long int Count();
 
+		/// @brief Check if a frame is in the cache (without counting a hit or a miss)
+		/// @param frame_number The frame number of the cached frame
+		bool Contains(long int frame_number);
+
 		/// @brief Get a frame from the cache
 		/// @param frame_number The frame number of the cached frame
 		QSharedPointer<Frame> GetFrame(long int frame_number);
 
-		/// Gets the maximum bytes value
+		/// @brief Get the cached frame closest to a frame number (without counting a hit or a miss)
+		/// @param frame_number The frame number to look around
+		/// @param max_distance The furthest a frame can be from frame_number (NULL shared_ptr if there is none)
+		QSharedPointer<Frame> GetClosestFrame(long int frame_number, long int max_distance);
+
+		/// @brief Gets the number of bytes used by all cached frames (as of the last time each frame was added)
+		/// @remark Frames sharing the same image (i.e. duplicate or missing frames) only count its pixels once.
 		long long int GetBytes();
 
+		/// Get a snapshot of the cache statistics
+		CacheStats GetStats();
+
+		/// @brief Get a snapshot of the cache statistics, and reset the counters
+		/// @remark The bytes and frames currently resident are not reset, and the peak restarts from the current bytes.
+		CacheStats ResetStats();
+
 		/// Get the smallest frame number
 		QSharedPointer<Frame> GetSmallestFrame();
 
@@ -88,6 +164,34 @@ namespace vs
 		/// @param end_frame_number The ending frame number of the cached frame
 		void Remove(long int start_frame_number, long int end_frame_number);
 
+		/// @brief Pin a range of frames, so they are never purged to make room (they can still be removed explicitly)
+		/// @remark The frames of the range don't need to be cached yet: they are pinned when they are added. Pinned
+		/// frames can take the cache over its max bytes, by up to the max pinned bytes (see SetMaxPinnedBytes): a
+		/// range which doesn't fit is cut short (the size of a frame is known from SetMaxBytesFromInfo).
+		/// @returns The last frame pinned (start_frame_number - 1 if none of the range fits)
+		/// @param start_frame_number The first frame of the range
+		/// @param end_frame_number The last frame of the range
+		long int Pin(long int start_frame_number, long int end_frame_number);
+
+		/// @brief Unpin the frames of a range: each frame loses one pin (the pinned ranges overlapping it are trimmed)
+		/// @remark The pins are counted per frame, so a frame pinned by two overlapping ranges stays pinned until
+		/// both ranges are unpinned.
+		/// @param start_frame_number The first frame of the range
+		/// @param end_frame_number The last frame of the range
+		void Unpin(long int start_frame_number, long int end_frame_number);
+
+		/// @brief Remove the frames of a range which aren't pinned (anymore)
+		/// @param start_frame_number The first frame of the range
+		/// @param end_frame_number The last frame of the range
+		void RemoveUnpinned(long int start_frame_number, long int end_frame_number);
+
+		/// @brief Check if a frame is in a pinned range
+		/// @param frame_number The frame number
+		bool IsPinned(long int frame_number);
+
+		/// Get the pinned ranges (start frame, end frame), in the order of their start frames
+		std::vector<std::pair<long int, long int>> GetPinnedRanges();
+
 		/// @brief Set maximum bytes to a different amount based on a ReaderInfo struct
 		/// @param number_of_frames The maximum number of frames to hold in cache
 		/// @param width The width of the frame's image
@@ -98,6 +202,10 @@ namespace vs
 
 		long long int GetMaxBytes() { return max_bytes; };
 		void SetMaxBytes(long long int number_of_bytes) { max_bytes = number_of_bytes; };
+
+		/// Get the most bytes the pinned ranges can hold, on top of the max bytes (0 for no limit)
+		long long int GetMaxPinnedBytes() { return max_pinned_bytes; };
+		void SetMaxPinnedBytes(long long int number_of_bytes) { max_pinned_bytes = number_of_bytes; };
 	};
 }
 
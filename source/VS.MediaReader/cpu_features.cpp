@@ -0,0 +1,111 @@
+/*
+@file		cpu_features.cpp
+@author		Webstar
+@date		2026-10-18 16:02
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+#include "cpu_features.hpp"
+
+#if VS_CPU_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+using namespace std;
+using namespace vs;
+
+namespace vs
+{
+	namespace helpers
+	{
+#if VS_CPU_X86
+		/// Execute cpuid (registers are returned in the order eax, ebx, ecx, edx)
+		inline void CpuId(int leaf, int subleaf, int registers[4])
+		{
+#if defined(_MSC_VER)
+			__cpuidex(registers, leaf, subleaf);
+#else
+			unsigned int a, b, c, d;
+			__cpuid_count(leaf, subleaf, a, b, c, d);
+			registers[0] = (int)a; registers[1] = (int)b; registers[2] = (int)c; registers[3] = (int)d;
+#endif
+		}
+
+		/// Read the extended control register (which register states the OS saves on a context switch)
+		inline unsigned long long ReadXCR0()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			unsigned int a, d;
+			__asm__ volatile("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+			return ((unsigned long long)d << 32) | a;
+#endif
+		}
+#endif
+	}
+}
+
+// Get the features of the CPU this process is running on
+const CpuFeatures& CpuFeatures::Get()
+{
+	static const CpuFeatures features = Detect();
+	return features;
+}
+
+// Query the CPU (cpuid) and the OS (xgetbv)
+CpuFeatures CpuFeatures::Detect()
+{
+	CpuFeatures features = CpuFeatures();
+
+#if VS_CPU_X86
+	int registers[4] = { 0, 0, 0, 0 };
+	helpers::CpuId(0, 0, registers);
+	int max_leaf = registers[0];
+
+	if (max_leaf < 1)
+		return features;
+
+	helpers::CpuId(1, 0, registers);
+	features.has_sse2 = (registers[3] & (1 << 26)) != 0;
+	features.has_sse41 = (registers[2] & (1 << 19)) != 0;
+	bool has_osxsave = (registers[2] & (1 << 27)) != 0;
+	bool has_avx = (registers[2] & (1 << 28)) != 0;
+	bool has_fma = (registers[2] & (1 << 12)) != 0;
+
+	// The wider registers are only usable if the OS saves them (XMM + YMM, and opmask + ZMM for AVX-512)
+	unsigned long long xcr0 = has_osxsave ? helpers::ReadXCR0() : 0;
+	bool os_saves_ymm = (xcr0 & 0x06) == 0x06;
+	bool os_saves_zmm = (xcr0 & 0xE6) == 0xE6;
+
+	features.has_avx = has_avx && os_saves_ymm;
+	features.has_fma = has_fma && features.has_avx;
+
+	if (max_leaf >= 7)
+	{
+		helpers::CpuId(7, 0, registers);
+		features.has_avx2 = features.has_avx && (registers[1] & (1 << 5)) != 0;
+		features.has_avx512f = os_saves_zmm && (registers[1] & (1 << 16)) != 0;
+		features.has_avx512bw = features.has_avx512f && (registers[1] & (1 << 30)) != 0;
+	}
+#endif
+
+	return features;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:02
+#vNext
+=============================================================
+*/
@@ -0,0 +1,50 @@
+#ifndef GUARD_cpu_features_20261018160240_
+#define GUARD_cpu_features_20261018160240_
+/*
+@file		cpu_features.hpp
+@author		Webstar
+@date		2026-10-18 16:02
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define VS_CPU_X86 1
+#endif
+
+namespace vs
+{
+	/// @brief This struct describes the instruction sets supported by the CPU (and enabled by the OS)
+	/// @remark The features are detected once, the first time Get() is called.
+	struct CpuFeatures
+	{
+		bool has_sse2;		///< SSE2 (always present on x64)
+		bool has_sse41;		///< SSE4.1
+		bool has_avx;		///< AVX (and the OS saves the YMM registers)
+		bool has_avx2;		///< AVX2 (and the OS saves the YMM registers)
+		bool has_fma;		///< FMA3
+		bool has_avx512f;	///< AVX-512 Foundation (and the OS saves the ZMM registers)
+		bool has_avx512bw;	///< AVX-512 Byte and Word
+
+		/// Get the features of the CPU this process is running on
+		static const CpuFeatures& Get();
+
+	private:
+		/// Query the CPU (cpuid) and the OS (xgetbv)
+		static CpuFeatures Detect();
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:02
+#vNext
+=============================================================
+*/
+
+#endif
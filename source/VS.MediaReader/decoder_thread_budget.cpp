@@ -0,0 +1,82 @@
+/*
+@file		decoder_thread_budget.cpp
+@author		Webstar
+@date		2026-10-18 19:02
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <algorithm>
+#include <thread>
+
+#include "decoder_thread_budget.hpp"
+
+using namespace std;
+using namespace vs;
+
+// Constructor
+DecoderThreadBudget::DecoderThreadBudget(int total_threads)
+	: total_threads(std::max(1, total_threads)), threads_in_use(0), total_workload(0)
+{
+}
+
+// Get the budget shared by all readers
+DecoderThreadBudget& DecoderThreadBudget::Global()
+{
+	static DecoderThreadBudget budget((int)std::thread::hardware_concurrency());
+	return budget;
+}
+
+// Get the number of threads for a new codec
+int DecoderThreadBudget::Acquire(int64_t workload)
+{
+	std::lock_guard<std::mutex> lock(budget_mutex);
+
+	workload = std::max<int64_t>(workload, 1);
+	total_workload += workload;
+
+	// The threads the workload can use
+	int64_t wanted = (workload + WorkloadPerThread - 1) / WorkloadPerThread;
+
+	// The share of the budget for this workload (compared with the other open codecs)
+	int64_t share = (int64_t)total_threads * workload / total_workload;
+
+	// What's left of the budget (the open codecs keep their threads until they are closed)
+	int64_t available = total_threads - threads_in_use;
+
+	// Never more than its share, nor more than what's left (only the one thread every codec gets can go over)
+	int threads = (int)std::max<int64_t>(1, std::min(wanted, std::min(share, available)));
+
+	threads_in_use += threads;
+	return threads;
+}
+
+// Give back the threads of a codec
+void DecoderThreadBudget::Release(int64_t workload, int threads)
+{
+	std::lock_guard<std::mutex> lock(budget_mutex);
+
+	total_workload = std::max<int64_t>(0, total_workload - std::max<int64_t>(workload, 1));
+	threads_in_use = std::max(0, threads_in_use - threads);
+}
+
+// Get the number of threads currently given to the open codecs
+int DecoderThreadBudget::GetThreadsInUse()
+{
+	std::lock_guard<std::mutex> lock(budget_mutex);
+
+	return threads_in_use;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 19:02
+#vNext
+=============================================================
+*/
@@ -0,0 +1,75 @@
+#ifndef GUARD_decoder_thread_budget_20261018190215_
+#define GUARD_decoder_thread_budget_20261018190215_
+/*
+@file		decoder_thread_budget.hpp
+@author		Webstar
+@date		2026-10-18 19:02
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstdint>
+#include <mutex>
+
+namespace vs
+{
+	/// @brief This class shares a process-wide budget of decoder threads between the open codecs
+	/// @remark Each codec context used to get one thread per core, so 20 readers on a 32 core machine ran 1280
+	/// decoder threads. Instead, each codec asks for a share of the budget (one thread per core) based on its
+	/// workload (pixels per second), and gives it back when it is closed. A codec never gets more than its workload
+	/// can use, nor more than what's left of the budget, but it always gets at least one thread (so the threads in
+	/// use only go over the budget by the codecs which got a single thread).
+	/// @code
+	/// int threads = DecoderThreadBudget::Global().Acquire(width * height * fps);
+	/// // ... decode ...
+	/// DecoderThreadBudget::Global().Release(width * height * fps, threads);
+	/// @endcode
+	class DecoderThreadBudget
+	{
+	private:
+		std::mutex budget_mutex;
+
+		int total_threads;			///< The number of threads shared by all codecs
+		int threads_in_use;			///< The number of threads given to the open codecs
+		int64_t total_workload;		///< The sum of the workloads of the open codecs
+
+	public:
+		/// The workload one decoder thread can keep up with (pixels per second, roughly 1080p at 7.5 fps)
+		static const int64_t WorkloadPerThread = 1920 * 1080 * 15 / 2;
+
+		/// @brief Constructor
+		/// @param total_threads The number of threads shared by all codecs
+		DecoderThreadBudget(int total_threads);
+
+		/// Get the budget shared by all readers (one thread per core)
+		static DecoderThreadBudget& Global();
+
+		/// @brief Get the number of threads for a new codec
+		/// @param workload The work done by the codec (pixels per second for video)
+		int Acquire(int64_t workload);
+
+		/// Give back the threads of a codec (with the same workload it was acquired with)
+		void Release(int64_t workload, int threads);
+
+		/// Get the number of threads currently given to the open codecs
+		int GetThreadsInUse();
+
+		/// Get the number of threads shared by all codecs
+		int GetTotalThreads() { return total_threads; }
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 19:02
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef GUARD_float_vector_kernels_20261018161105_
+#define GUARD_float_vector_kernels_20261018161105_
+/*
+@file		float_vector_kernels.hpp
+@author		Webstar
+@date		2026-10-18 16:11
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+#include "cpu_features.hpp"
+
+namespace vs
+{
+	/// @brief The kernels of FloatVectorOperations for one sample type
+	/// @remark The names follow the operands of each operation (i.e. add_src1_src2 is dest = src1 + src2).
+	template <typename Type>
+	struct VectorKernels
+	{
+		void (*fill)(Type* dest, Type valueToFill, int num);
+		void (*copy_with_multiply)(Type* dest, const Type* src, Type multiplier, int num);
+		void (*add_value)(Type* dest, Type amount, int num);
+		void (*add_src_value)(Type* dest, const Type* src, Type amount, int num);
+		void (*add_src)(Type* dest, const Type* src, int num);
+		void (*add_src1_src2)(Type* dest, const Type* src1, const Type* src2, int num);
+		void (*subtract_src)(Type* dest, const Type* src, int num);
+		void (*subtract_src1_src2)(Type* dest, const Type* src1, const Type* src2, int num);
+		void (*add_with_multiply_value)(Type* dest, const Type* src, Type multiplier, int num);
+		void (*add_with_multiply_src1_src2)(Type* dest, const Type* src1, const Type* src2, int num);
+		void (*subtract_with_multiply_value)(Type* dest, const Type* src, Type multiplier, int num);
+		void (*subtract_with_multiply_src1_src2)(Type* dest, const Type* src1, const Type* src2, int num);
+		void (*multiply_src)(Type* dest, const Type* src, int num);
+		void (*multiply_src1_src2)(Type* dest, const Type* src1, const Type* src2, int num);
+		void (*multiply_value)(Type* dest, Type multiplier, int num);
+		void (*multiply_src_value)(Type* dest, const Type* src, Type multiplier, int num);
+		void (*abs)(Type* dest, const Type* src, int num);
+		void (*min_value)(Type* dest, const Type* src, Type comp, int num);
+		void (*min_src1_src2)(Type* dest, const Type* src1, const Type* src2, int num);
+		void (*max_value)(Type* dest, const Type* src, Type comp, int num);
+		void (*max_src1_src2)(Type* dest, const Type* src1, const Type* src2, int num);
+		void (*clip)(Type* dest, const Type* src, Type low, Type high, int num);
+		Type (*find_minimum)(const Type* src, int num);
+		Type (*find_maximum)(const Type* src, int num);
+		void (*find_min_and_max)(const Type* src, int num, Type& lowest, Type& highest);
+	};
+
+	/// @brief A table with every kernel of FloatVectorOperations, compiled for one instruction set
+	/// @remark Each instruction set lives in its own translation unit (float_vector_kernels_*.cpp), so only that file
+	/// is compiled with the wider instructions, and FloatVectorOperations picks a table at runtime (see CpuFeatures).
+	struct FloatVectorKernels
+	{
+		VectorKernels<float> f;
+		VectorKernels<double> d;
+		void (*convert_fixed_to_float)(float* dest, const int* src, float multiplier, int num);
+	};
+
+	namespace scalar
+	{
+		/// Fill the table with the plain C++ kernels (the reference implementation)
+		void GetKernels(FloatVectorKernels &kernels);
+	}
+
+#if VS_CPU_X86
+	namespace sse2
+	{
+		/// Fill the table with the SSE2 kernels (4 floats / 2 doubles at a time)
+		void GetKernels(FloatVectorKernels &kernels);
+	}
+
+	namespace avx2
+	{
+		/// Fill the table with the AVX2 kernels (8 floats / 4 doubles at a time)
+		void GetKernels(FloatVectorKernels &kernels);
+	}
+
+	namespace avx512
+	{
+		/// Fill the table with the AVX-512 kernels (16 floats / 8 doubles at a time)
+		void GetKernels(FloatVectorKernels &kernels);
+	}
+#endif
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:11
+#vNext
+=============================================================
+*/
+
+#endif
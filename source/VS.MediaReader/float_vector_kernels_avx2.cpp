@@ -0,0 +1,87 @@
+/*
+@file		float_vector_kernels_avx2.cpp
+@author		Webstar
+@date		2026-10-18 16:20
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// This file is compiled with /arch:AVX2 (see the project settings), and its kernels are only called on CPUs with AVX2
+// The results match the scalar kernels bit for bit (see float_vector_kernels_impl.hpp, which turns off the contraction
+// of multiplies and adds into FMA instructions)
+
+#include "cpu_features.hpp"
+
+#if VS_CPU_X86
+
+// STD
+#include <cstring>
+#include <immintrin.h>
+
+namespace vs
+{
+	namespace avx2
+	{
+		/// AVX2 operations on 8 floats
+		struct BasicOps32
+		{
+			typedef float Type;
+			typedef __m256 ParallelType;
+			enum { numParallel = 8 };
+
+			static inline ParallelType load1(Type v)  { return _mm256_set1_ps(v); }
+			static inline ParallelType loadU(const Type* v)  { return _mm256_loadu_ps(v); }
+			static inline ParallelType loadInt(const int* v)  { return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*) v)); }
+			static inline void storeU(Type* dest, ParallelType a)  { _mm256_storeu_ps(dest, a); }
+			static inline ParallelType add(ParallelType a, ParallelType b)  { return _mm256_add_ps(a, b); }
+			static inline ParallelType sub(ParallelType a, ParallelType b)  { return _mm256_sub_ps(a, b); }
+			static inline ParallelType mul(ParallelType a, ParallelType b)  { return _mm256_mul_ps(a, b); }
+			static inline ParallelType min(ParallelType a, ParallelType b)  { return _mm256_min_ps(b, a); }
+			static inline ParallelType max(ParallelType a, ParallelType b)  { return _mm256_max_ps(b, a); }
+			static inline ParallelType bit_and(ParallelType a, ParallelType b)  { return _mm256_and_ps(a, b); }
+		};
+
+		/// AVX2 operations on 4 doubles
+		struct BasicOps64
+		{
+			typedef double Type;
+			typedef __m256d ParallelType;
+			enum { numParallel = 4 };
+
+			static inline ParallelType load1(Type v)  { return _mm256_set1_pd(v); }
+			static inline ParallelType loadU(const Type* v)  { return _mm256_loadu_pd(v); }
+			static inline void storeU(Type* dest, ParallelType a)  { _mm256_storeu_pd(dest, a); }
+			static inline ParallelType add(ParallelType a, ParallelType b)  { return _mm256_add_pd(a, b); }
+			static inline ParallelType sub(ParallelType a, ParallelType b)  { return _mm256_sub_pd(a, b); }
+			static inline ParallelType mul(ParallelType a, ParallelType b)  { return _mm256_mul_pd(a, b); }
+			static inline ParallelType min(ParallelType a, ParallelType b)  { return _mm256_min_pd(b, a); }
+			static inline ParallelType max(ParallelType a, ParallelType b)  { return _mm256_max_pd(b, a); }
+			static inline ParallelType bit_and(ParallelType a, ParallelType b)  { return _mm256_and_pd(a, b); }
+		};
+
+		template <int typeSize> struct ModeType;
+		template <> struct ModeType<4> { typedef BasicOps32 Mode; };
+		template <> struct ModeType<8> { typedef BasicOps64 Mode; };
+	}
+}
+
+#define VS_FLOAT_VECTOR_NAMESPACE avx2
+
+#include "float_vector_kernels_impl.hpp"
+
+#endif
+
+using namespace std;
+using namespace vs;
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:20
+#vNext
+=============================================================
+*/
@@ -0,0 +1,88 @@
+/*
+@file		float_vector_kernels_avx512.cpp
+@author		Webstar
+@date		2026-10-18 16:20
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// Visual C++ 15.0 has no /arch:AVX512 option, but accepts the AVX-512 intrinsics without it. The kernels
+// of this file are only called on CPUs with AVX-512F (the bitwise and is done on integers, which only needs AVX-512F)
+// The results match the scalar kernels bit for bit (see float_vector_kernels_impl.hpp, which turns off the contraction
+// of multiplies and adds into FMA instructions)
+
+#include "cpu_features.hpp"
+
+#if VS_CPU_X86
+
+// STD
+#include <cstring>
+#include <immintrin.h>
+
+namespace vs
+{
+	namespace avx512
+	{
+		/// AVX-512 operations on 16 floats
+		struct BasicOps32
+		{
+			typedef float Type;
+			typedef __m512 ParallelType;
+			enum { numParallel = 16 };
+
+			static inline ParallelType load1(Type v)  { return _mm512_set1_ps(v); }
+			static inline ParallelType loadU(const Type* v)  { return _mm512_loadu_ps(v); }
+			static inline ParallelType loadInt(const int* v)  { return _mm512_cvtepi32_ps(_mm512_loadu_si512((const void*) v)); }
+			static inline void storeU(Type* dest, ParallelType a)  { _mm512_storeu_ps(dest, a); }
+			static inline ParallelType add(ParallelType a, ParallelType b)  { return _mm512_add_ps(a, b); }
+			static inline ParallelType sub(ParallelType a, ParallelType b)  { return _mm512_sub_ps(a, b); }
+			static inline ParallelType mul(ParallelType a, ParallelType b)  { return _mm512_mul_ps(a, b); }
+			static inline ParallelType min(ParallelType a, ParallelType b)  { return _mm512_min_ps(b, a); }
+			static inline ParallelType max(ParallelType a, ParallelType b)  { return _mm512_max_ps(b, a); }
+			static inline ParallelType bit_and(ParallelType a, ParallelType b)  { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+		};
+
+		/// AVX-512 operations on 8 doubles
+		struct BasicOps64
+		{
+			typedef double Type;
+			typedef __m512d ParallelType;
+			enum { numParallel = 8 };
+
+			static inline ParallelType load1(Type v)  { return _mm512_set1_pd(v); }
+			static inline ParallelType loadU(const Type* v)  { return _mm512_loadu_pd(v); }
+			static inline void storeU(Type* dest, ParallelType a)  { _mm512_storeu_pd(dest, a); }
+			static inline ParallelType add(ParallelType a, ParallelType b)  { return _mm512_add_pd(a, b); }
+			static inline ParallelType sub(ParallelType a, ParallelType b)  { return _mm512_sub_pd(a, b); }
+			static inline ParallelType mul(ParallelType a, ParallelType b)  { return _mm512_mul_pd(a, b); }
+			static inline ParallelType min(ParallelType a, ParallelType b)  { return _mm512_min_pd(b, a); }
+			static inline ParallelType max(ParallelType a, ParallelType b)  { return _mm512_max_pd(b, a); }
+			static inline ParallelType bit_and(ParallelType a, ParallelType b)  { return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b))); }
+		};
+
+		template <int typeSize> struct ModeType;
+		template <> struct ModeType<4> { typedef BasicOps32 Mode; };
+		template <> struct ModeType<8> { typedef BasicOps64 Mode; };
+	}
+}
+
+#define VS_FLOAT_VECTOR_NAMESPACE avx512
+
+#include "float_vector_kernels_impl.hpp"
+
+#endif
+
+using namespace std;
+using namespace vs;
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:20
+#vNext
+=============================================================
+*/
@@ -0,0 +1,633 @@
+#ifndef GUARD_float_vector_kernels_impl_20261018161420_
+#define GUARD_float_vector_kernels_impl_20261018161420_
+/*
+@file		float_vector_kernels_impl.hpp
+@author		Webstar
+@date		2026-10-18 16:14
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// The kernels of FloatVectorOperations, written once and compiled for each instruction set.
+// Each float_vector_kernels_*.cpp file defines VS_FLOAT_VECTOR_NAMESPACE (and, unless it defines
+// VS_FLOAT_VECTOR_SCALAR, a ModeType<sizeof(Type)>::Mode with the intrinsics of its instruction set)
+// before including this file, which adds the kernels and a GetKernels() function to that namespace.
+// The scalar loop of every operation is the reference, and also handles the values left over after the vector loop.
+//
+// Nothing here may call the inline functions or templates of float_vector_operations.hpp: every kernel file would
+// emit its own copy of them, and the linker keeps only one, which could be the copy built with /arch:AVX2 (then
+// called on CPUs without AVX2). The helpers below are file-local (an anonymous namespace) for that reason.
+//
+// The scalar loops must not be contracted into fused multiply-adds (the AVX2 file is built with /arch:AVX2, which lets
+// Visual C++ 15.0 fuse them even with /fp:precise), or the values left over would differ from the scalar kernels.
+
+// STD
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "float_vector_kernels.hpp"
+
+#if defined(_MSC_VER)
+#pragma fp_contract (off)
+#endif
+
+#if !defined(VS_FLOAT_VECTOR_NAMESPACE)
+#error "Define VS_FLOAT_VECTOR_NAMESPACE before including float_vector_kernels_impl.hpp"
+#endif
+
+#define VS_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+#define VS_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+#define VS_INCREMENT_DEST             dest += Mode::numParallel;
+
+#if VS_FLOAT_VECTOR_SCALAR
+
+#define VS_PERFORM_VEC_OP_DEST(normalOp, vecOp, locals, setupOp) \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#define VS_PERFORM_VEC_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#define VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#define VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#else
+
+// Run the vector op over as many values as fit in whole registers, then the scalar op over the rest
+#define VS_PERFORM_VEC_OP_DEST(normalOp, vecOp, locals, setupOp) \
+        { \
+            typedef ModeType<sizeof (*dest)>::Mode Mode; \
+            setupOp \
+            const int numLongOps = num / Mode::numParallel; \
+            VS_VEC_LOOP(vecOp, dummy, Mode::loadU, Mode::storeU, locals, VS_INCREMENT_DEST) \
+            num -= numLongOps * Mode::numParallel; \
+        } \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#define VS_PERFORM_VEC_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        { \
+            typedef ModeType<sizeof (*dest)>::Mode Mode; \
+            setupOp \
+            const int numLongOps = num / Mode::numParallel; \
+            VS_VEC_LOOP(vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+            num -= numLongOps * Mode::numParallel; \
+        } \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#define VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        { \
+            typedef ModeType<sizeof (*dest)>::Mode Mode; \
+            setupOp \
+            const int numLongOps = num / Mode::numParallel; \
+            VS_VEC_LOOP_TWO_SOURCES(vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+            num -= numLongOps * Mode::numParallel; \
+        } \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#define VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        { \
+            typedef ModeType<sizeof (*dest)>::Mode Mode; \
+            setupOp \
+            const int numLongOps = num / Mode::numParallel; \
+            VS_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD(vecOp, Mode::loadU, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+            num -= numLongOps * Mode::numParallel; \
+        } \
+        for (int i = 0; i < num; ++i) normalOp;
+
+#endif
+
+//==============================================================================
+#define VS_VEC_LOOP(vecOp, srcLoad, dstLoad, dstStore, locals, increment) \
+        for (int i = 0; i < numLongOps; ++i) \
+        { \
+            locals (srcLoad, dstLoad); \
+            dstStore (dest, vecOp); \
+            increment; \
+        }
+
+#define VS_VEC_LOOP_TWO_SOURCES(vecOp, src1Load, src2Load, dstStore, locals, increment) \
+        for (int i = 0; i < numLongOps; ++i) \
+        { \
+            locals (src1Load, src2Load); \
+            dstStore (dest, vecOp); \
+            increment; \
+        }
+
+#define VS_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD(vecOp, src1Load, src2Load, dstLoad, dstStore, locals, increment) \
+        for (int i = 0; i < numLongOps; ++i) \
+        { \
+            locals (src1Load, src2Load, dstLoad); \
+            dstStore (dest, vecOp); \
+            increment; \
+        }
+
+#define VS_LOAD_NONE(srcLoad, dstLoad)
+#define VS_LOAD_DEST(srcLoad, dstLoad)                        const Mode::ParallelType d = dstLoad (dest);
+#define VS_LOAD_SRC(srcLoad, dstLoad)                         const Mode::ParallelType s = srcLoad (src);
+#define VS_LOAD_SRC1_SRC2(src1Load, src2Load)                 const Mode::ParallelType s1 = src1Load (src1), s2 = src2Load (src2);
+#define VS_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const Mode::ParallelType d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
+#define VS_LOAD_SRC_DEST(srcLoad, dstLoad)                    const Mode::ParallelType d = dstLoad (dest), s = srcLoad (src);
+
+namespace vs
+{
+	namespace VS_FLOAT_VECTOR_NAMESPACE
+	{
+		namespace helpers
+		{
+			union signMask32 { float  f; uint32_t i; };
+			union signMask64 { double d; uint64_t i; };
+		}
+
+		namespace
+		{
+			template <typename Type>
+			inline Type localMin(const Type a, const Type b) { return (b < a) ? b : a; }
+
+			template <typename Type>
+			inline Type localMax(const Type a, const Type b) { return (a < b) ? b : a; }
+
+			// Scan an array for its minimum and maximum (the comparisons of the scalar loops of FloatVectorOperations)
+			template <typename Type>
+			void localFindMinAndMax(const Type* values, int num, Type& lowest, Type& highest)
+			{
+				if (num <= 0)
+				{
+					lowest = Type();
+					highest = Type();
+					return;
+				}
+
+				Type mn = values[0];
+				Type mx = mn;
+
+				for (int i = 1; i < num; ++i)
+				{
+					const Type v = values[i];
+					if (mx < v)  mx = v;
+					if (v < mn)  mn = v;
+				}
+
+				lowest = mn;
+				highest = mx;
+			}
+		}
+
+		static void fill(float* dest, float valueToFill, int num)
+		{
+			VS_PERFORM_VEC_OP_DEST(dest[i] = valueToFill, val, VS_LOAD_NONE,
+				const Mode::ParallelType val = Mode::load1(valueToFill);)
+		}
+
+		static void fill(double* dest, double valueToFill, int num)
+		{
+			VS_PERFORM_VEC_OP_DEST(dest[i] = valueToFill, val, VS_LOAD_NONE,
+				const Mode::ParallelType val = Mode::load1(valueToFill);)
+		}
+
+		static void copyWithMultiply(float* dest, const float* src, float multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void copyWithMultiply(double* dest, const double* src, double multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void add(float* dest, float amount, int num)
+		{
+			VS_PERFORM_VEC_OP_DEST(dest[i] += amount, Mode::add(d, amountToAdd), VS_LOAD_DEST,
+				const Mode::ParallelType amountToAdd = Mode::load1(amount);)
+		}
+
+		static void add(double* dest, double amount, int num)
+		{
+			VS_PERFORM_VEC_OP_DEST(dest[i] += amount, Mode::add(d, amountToAdd), VS_LOAD_DEST,
+				const Mode::ParallelType amountToAdd = Mode::load1(amount);)
+		}
+
+		static void add(float* dest, const float* src, float amount, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] + amount, Mode::add(am, s),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType am = Mode::load1(amount);)
+		}
+
+		static void add(double* dest, const double* src, double amount, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] + amount, Mode::add(am, s),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType am = Mode::load1(amount);)
+		}
+
+		static void add(float* dest, const float* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i], Mode::add(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+		}
+
+		static void add(double* dest, const double* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i], Mode::add(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+		}
+
+		static void add(float* dest, const float* src1, const float* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] + src2[i], Mode::add(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void add(double* dest, const double* src1, const double* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] + src2[i], Mode::add(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void subtract(float* dest, const float* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i], Mode::sub(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+		}
+
+		static void subtract(double* dest, const double* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i], Mode::sub(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+		}
+
+		static void subtract(float* dest, const float* src1, const float* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] - src2[i], Mode::sub(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void subtract(double* dest, const double* src1, const double* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] - src2[i], Mode::sub(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void addWithMultiply(float* dest, const float* src, float multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i] * multiplier, Mode::add(d, Mode::mul(mult, s)),
+				VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void addWithMultiply(double* dest, const double* src, double multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i] * multiplier, Mode::add(d, Mode::mul(mult, s)),
+				VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void addWithMultiply(float* dest, const float* src1, const float* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] += src1[i] * src2[i], Mode::add(d, Mode::mul(s1, s2)),
+				VS_LOAD_SRC1_SRC2_DEST,
+				VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void addWithMultiply(double* dest, const double* src1, const double* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] += src1[i] * src2[i], Mode::add(d, Mode::mul(s1, s2)),
+				VS_LOAD_SRC1_SRC2_DEST,
+				VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void subtractWithMultiply(float* dest, const float* src, float multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i] * multiplier, Mode::sub(d, Mode::mul(mult, s)),
+				VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void subtractWithMultiply(double* dest, const double* src, double multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i] * multiplier, Mode::sub(d, Mode::mul(mult, s)),
+				VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void subtractWithMultiply(float* dest, const float* src1, const float* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] -= src1[i] * src2[i], Mode::sub(d, Mode::mul(s1, s2)),
+				VS_LOAD_SRC1_SRC2_DEST,
+				VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void subtractWithMultiply(double* dest, const double* src1, const double* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] -= src1[i] * src2[i], Mode::sub(d, Mode::mul(s1, s2)),
+				VS_LOAD_SRC1_SRC2_DEST,
+				VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void multiply(float* dest, const float* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] *= src[i], Mode::mul(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+		}
+
+		static void multiply(double* dest, const double* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] *= src[i], Mode::mul(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+		}
+
+		static void multiply(float* dest, const float* src1, const float* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] * src2[i], Mode::mul(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void multiply(double* dest, const double* src1, const double* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] * src2[i], Mode::mul(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void multiply(float* dest, float multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_DEST(dest[i] *= multiplier, Mode::mul(d, mult), VS_LOAD_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void multiply(double* dest, double multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_DEST(dest[i] *= multiplier, Mode::mul(d, mult), VS_LOAD_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void multiply(float* dest, const float* src, float multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void multiply(double* dest, const double* src, double multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void abs(float* dest, const float* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = fabsf(src[i]), Mode::bit_and(s, mask),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				helpers::signMask32 signMask; signMask.i = 0x7fffffffUL;
+				const Mode::ParallelType mask = Mode::load1(signMask.f);)
+		}
+
+		static void abs(double* dest, const double* src, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = fabs(src[i]), Mode::bit_and(s, mask),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				helpers::signMask64 signMask; signMask.i = 0x7fffffffffffffffULL;
+				const Mode::ParallelType mask = Mode::load1(signMask.d);)
+		}
+
+		static void convertFixedToFloat(float* dest, const int* src, float multiplier, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = (float)src[i] * multiplier,
+				Mode::mul(mult, Mode::loadInt(src)),
+				VS_LOAD_NONE, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType mult = Mode::load1(multiplier);)
+		}
+
+		static void min(float* dest, const float* src, float comp, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = localMin(src[i], comp), Mode::min(s, cmp),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType cmp = Mode::load1(comp);)
+		}
+
+		static void min(double* dest, const double* src, double comp, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = localMin(src[i], comp), Mode::min(s, cmp),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType cmp = Mode::load1(comp);)
+		}
+
+		static void min(float* dest, const float* src1, const float* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = localMin(src1[i], src2[i]), Mode::min(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void min(double* dest, const double* src1, const double* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = localMin(src1[i], src2[i]), Mode::min(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void max(float* dest, const float* src, float comp, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = localMax(src[i], comp), Mode::max(s, cmp),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType cmp = Mode::load1(comp);)
+		}
+
+		static void max(double* dest, const double* src, double comp, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = localMax(src[i], comp), Mode::max(s, cmp),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType cmp = Mode::load1(comp);)
+		}
+
+		static void max(float* dest, const float* src1, const float* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = localMax(src1[i], src2[i]), Mode::max(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void max(double* dest, const double* src1, const double* src2, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = localMax(src1[i], src2[i]), Mode::max(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+		}
+
+		static void clip(float* dest, const float* src, float low, float high, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = localMax(localMin(src[i], high), low), Mode::max(Mode::min(s, hi), lo),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType lo = Mode::load1(low); const Mode::ParallelType hi = Mode::load1(high);)
+		}
+
+		static void clip(double* dest, const double* src, double low, double high, int num)
+		{
+			VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = localMax(localMin(src[i], high), low), Mode::max(Mode::min(s, hi), lo),
+				VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
+				const Mode::ParallelType lo = Mode::load1(low); const Mode::ParallelType hi = Mode::load1(high);)
+		}
+
+
+#if VS_FLOAT_VECTOR_SCALAR
+		static float findMinimum(const float* src, int num)
+		{
+			float lowest, highest;
+			localFindMinAndMax(src, num, lowest, highest);
+			return lowest;
+		}
+
+		static double findMinimum(const double* src, int num)
+		{
+			double lowest, highest;
+			localFindMinAndMax(src, num, lowest, highest);
+			return lowest;
+		}
+
+		static float findMaximum(const float* src, int num)
+		{
+			float lowest, highest;
+			localFindMinAndMax(src, num, lowest, highest);
+			return highest;
+		}
+
+		static double findMaximum(const double* src, int num)
+		{
+			double lowest, highest;
+			localFindMinAndMax(src, num, lowest, highest);
+			return highest;
+		}
+
+		static void findMinAndMax(const float* src, int num, float& lowest, float& highest)
+		{
+			localFindMinAndMax(src, num, lowest, highest);
+		}
+
+		static void findMinAndMax(const double* src, int num, double& lowest, double& highest)
+		{
+			localFindMinAndMax(src, num, lowest, highest);
+		}
+#else
+		// Keep a running minimum / maximum per lane, then reduce the lanes and the values left over.
+		// Mode::min(a, b) and Mode::max(a, b) only pick b when it is strictly smaller / larger (like the scalar loops).
+		template <class Mode>
+		static void findMinAndMax(const typename Mode::Type* src, int num, typename Mode::Type& lowest, typename Mode::Type& highest, bool find_lowest, bool find_highest)
+		{
+			typedef typename Mode::Type Type;
+			typedef typename Mode::ParallelType ParallelType;
+
+			if (num < Mode::numParallel * 2)
+			{
+				localFindMinAndMax(src, num, lowest, highest);
+				return;
+			}
+
+			ParallelType mn = Mode::loadU(src);
+			ParallelType mx = mn;
+
+			int i = Mode::numParallel;
+			for (; i + Mode::numParallel <= num; i += Mode::numParallel)
+			{
+				const ParallelType v = Mode::loadU(src + i);
+				if (find_lowest)  mn = Mode::min(mn, v);
+				if (find_highest) mx = Mode::max(mx, v);
+			}
+
+			// Reduce the lanes
+			Type lanes[Mode::numParallel];
+			Type lo, hi, unused;
+			Mode::storeU(lanes, mn);
+			localFindMinAndMax(lanes, (int)Mode::numParallel, lo, unused);
+			Mode::storeU(lanes, mx);
+			localFindMinAndMax(lanes, (int)Mode::numParallel, unused, hi);
+
+			for (; i < num; ++i)
+			{
+				if (src[i] < lo)  lo = src[i];
+				if (hi < src[i])  hi = src[i];
+			}
+
+			lowest = lo;
+			highest = hi;
+		}
+
+		static float findMinimum(const float* src, int num)
+		{
+			float lowest, highest;
+			findMinAndMax<ModeType<sizeof(float)>::Mode>(src, num, lowest, highest, true, false);
+			return lowest;
+		}
+
+		static double findMinimum(const double* src, int num)
+		{
+			double lowest, highest;
+			findMinAndMax<ModeType<sizeof(double)>::Mode>(src, num, lowest, highest, true, false);
+			return lowest;
+		}
+
+		static float findMaximum(const float* src, int num)
+		{
+			float lowest, highest;
+			findMinAndMax<ModeType<sizeof(float)>::Mode>(src, num, lowest, highest, false, true);
+			return highest;
+		}
+
+		static double findMaximum(const double* src, int num)
+		{
+			double lowest, highest;
+			findMinAndMax<ModeType<sizeof(double)>::Mode>(src, num, lowest, highest, false, true);
+			return highest;
+		}
+
+		static void findMinAndMax(const float* src, int num, float& lowest, float& highest)
+		{
+			findMinAndMax<ModeType<sizeof(float)>::Mode>(src, num, lowest, highest, true, true);
+		}
+
+		static void findMinAndMax(const double* src, int num, double& lowest, double& highest)
+		{
+			findMinAndMax<ModeType<sizeof(double)>::Mode>(src, num, lowest, highest, true, true);
+		}
+#endif
+
+		// Fill a table with the kernels of one sample type
+		template <typename Type>
+		static void GetTypedKernels(VectorKernels<Type> &kernels)
+		{
+			kernels.fill = &fill;
+			kernels.copy_with_multiply = &copyWithMultiply;
+			kernels.add_value = &add;
+			kernels.add_src_value = &add;
+			kernels.add_src = &add;
+			kernels.add_src1_src2 = &add;
+			kernels.subtract_src = &subtract;
+			kernels.subtract_src1_src2 = &subtract;
+			kernels.add_with_multiply_value = &addWithMultiply;
+			kernels.add_with_multiply_src1_src2 = &addWithMultiply;
+			kernels.subtract_with_multiply_value = &subtractWithMultiply;
+			kernels.subtract_with_multiply_src1_src2 = &subtractWithMultiply;
+			kernels.multiply_src = &multiply;
+			kernels.multiply_src1_src2 = &multiply;
+			kernels.multiply_value = &multiply;
+			kernels.multiply_src_value = &multiply;
+			kernels.abs = &abs;
+			kernels.min_value = &min;
+			kernels.min_src1_src2 = &min;
+			kernels.max_value = &max;
+			kernels.max_src1_src2 = &max;
+			kernels.clip = &clip;
+			kernels.find_minimum = &findMinimum;
+			kernels.find_maximum = &findMaximum;
+			kernels.find_min_and_max = &findMinAndMax;
+		}
+
+		// Fill the table with the kernels of this instruction set
+		void GetKernels(FloatVectorKernels &kernels)
+		{
+			GetTypedKernels(kernels.f);
+			GetTypedKernels(kernels.d);
+			kernels.convert_fixed_to_float = &convertFixedToFloat;
+		}
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:14
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,28 @@
+/*
+@file		float_vector_kernels_scalar.cpp
+@author		Webstar
+@date		2026-10-18 16:20
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// The reference kernels (plain C++ loops, used on CPUs without SSE2 and to check the other instruction sets)
+#define VS_FLOAT_VECTOR_SCALAR 1
+#define VS_FLOAT_VECTOR_NAMESPACE scalar
+
+#include "float_vector_kernels_impl.hpp"
+
+using namespace std;
+using namespace vs;
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:20
+#vNext
+=============================================================
+*/
@@ -0,0 +1,83 @@
+/*
+@file		float_vector_kernels_sse2.cpp
+@author		Webstar
+@date		2026-10-18 16:20
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+#include "cpu_features.hpp"
+
+#if VS_CPU_X86
+
+// STD
+#include <cstring>
+#include <emmintrin.h>
+
+namespace vs
+{
+	namespace sse2
+	{
+		/// SSE2 operations on 4 floats
+		struct BasicOps32
+		{
+			typedef float Type;
+			typedef __m128 ParallelType;
+			enum { numParallel = 4 };
+
+			static inline ParallelType load1(Type v)  { return _mm_set1_ps(v); }
+			static inline ParallelType loadU(const Type* v)  { return _mm_loadu_ps(v); }
+			static inline ParallelType loadInt(const int* v)  { return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) v)); }
+			static inline void storeU(Type* dest, ParallelType a)  { _mm_storeu_ps(dest, a); }
+			static inline ParallelType add(ParallelType a, ParallelType b)  { return _mm_add_ps(a, b); }
+			static inline ParallelType sub(ParallelType a, ParallelType b)  { return _mm_sub_ps(a, b); }
+			static inline ParallelType mul(ParallelType a, ParallelType b)  { return _mm_mul_ps(a, b); }
+			static inline ParallelType min(ParallelType a, ParallelType b)  { return _mm_min_ps(b, a); }
+			static inline ParallelType max(ParallelType a, ParallelType b)  { return _mm_max_ps(b, a); }
+			static inline ParallelType bit_and(ParallelType a, ParallelType b)  { return _mm_and_ps(a, b); }
+		};
+
+		/// SSE2 operations on 2 doubles
+		struct BasicOps64
+		{
+			typedef double Type;
+			typedef __m128d ParallelType;
+			enum { numParallel = 2 };
+
+			static inline ParallelType load1(Type v)  { return _mm_set1_pd(v); }
+			static inline ParallelType loadU(const Type* v)  { return _mm_loadu_pd(v); }
+			static inline void storeU(Type* dest, ParallelType a)  { _mm_storeu_pd(dest, a); }
+			static inline ParallelType add(ParallelType a, ParallelType b)  { return _mm_add_pd(a, b); }
+			static inline ParallelType sub(ParallelType a, ParallelType b)  { return _mm_sub_pd(a, b); }
+			static inline ParallelType mul(ParallelType a, ParallelType b)  { return _mm_mul_pd(a, b); }
+			static inline ParallelType min(ParallelType a, ParallelType b)  { return _mm_min_pd(b, a); }
+			static inline ParallelType max(ParallelType a, ParallelType b)  { return _mm_max_pd(b, a); }
+			static inline ParallelType bit_and(ParallelType a, ParallelType b)  { return _mm_and_pd(a, b); }
+		};
+
+		template <int typeSize> struct ModeType;
+		template <> struct ModeType<4> { typedef BasicOps32 Mode; };
+		template <> struct ModeType<8> { typedef BasicOps64 Mode; };
+	}
+}
+
+#define VS_FLOAT_VECTOR_NAMESPACE sse2
+
+#include "float_vector_kernels_impl.hpp"
+
+#endif
+
+using namespace std;
+using namespace vs;
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 16:20
+#vNext
+=============================================================
+*/
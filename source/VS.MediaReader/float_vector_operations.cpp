@@ -9,9 +9,12 @@
 
 
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
+#include <atomic>
 
 #include "float_vector_operations.hpp"
+#include "float_vector_kernels.hpp"
 
 using namespace vs;
 using namespace std;
@@ -20,80 +23,100 @@ namespace vs
 {
 	namespace helpers
 	{
-#define VS_INCREMENT_SRC_DEST         dest += (16 / sizeof (*dest)); src += (16 / sizeof (*dest));
-#define VS_INCREMENT_SRC1_SRC2_DEST   dest += (16 / sizeof (*dest)); src1 += (16 / sizeof (*dest)); src2 += (16 / sizeof (*dest));
-#define VS_INCREMENT_DEST             dest += (16 / sizeof (*dest));
-
-#define VS_PERFORM_VEC_OP_DEST(normalOp, vecOp, locals, setupOp) \
-        for (int i = 0; i < num; ++i) normalOp;
-
-#define VS_PERFORM_VEC_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
-        for (int i = 0; i < num; ++i) normalOp;
-
-#define VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
-        for (int i = 0; i < num; ++i) normalOp;
-
-#define VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
-        for (int i = 0; i < num; ++i) normalOp;
-
-		//==============================================================================
-#define VS_VEC_LOOP(vecOp, srcLoad, dstLoad, dstStore, locals, increment) \
-        for (int i = 0; i < numLongOps; ++i) \
-        { \
-            locals (srcLoad, dstLoad); \
-            dstStore (dest, vecOp); \
-            increment; \
-        }
-
-#define VS_VEC_LOOP_TWO_SOURCES(vecOp, src1Load, src2Load, dstStore, locals, increment) \
-        for (int i = 0; i < numLongOps; ++i) \
-        { \
-            locals (src1Load, src2Load); \
-            dstStore (dest, vecOp); \
-            increment; \
-        }
-
-#define VS_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD(vecOp, src1Load, src2Load, dstLoad, dstStore, locals, increment) \
-        for (int i = 0; i < numLongOps; ++i) \
-        { \
-            locals (src1Load, src2Load, dstLoad); \
-            dstStore (dest, vecOp); \
-            increment; \
-        }
-
-#define VS_LOAD_NONE(srcLoad, dstLoad)
-#define VS_LOAD_DEST(srcLoad, dstLoad)                        const Mode::ParallelType d = dstLoad (dest);
-#define VS_LOAD_SRC(srcLoad, dstLoad)                         const Mode::ParallelType s = srcLoad (src);
-#define VS_LOAD_SRC1_SRC2(src1Load, src2Load)                 const Mode::ParallelType s1 = src1Load (src1), s2 = src2Load (src2);
-#define VS_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const Mode::ParallelType d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
-#define VS_LOAD_SRC_DEST(srcLoad, dstLoad)                    const Mode::ParallelType d = dstLoad (dest), s = srcLoad (src);
-
-		union signMask32 { float  f; uint32_t i; };
-		union signMask64 { double d; uint64_t i; };
+		/// The kernel tables of every instruction set (built once)
+		struct KernelSets
+		{
+			FloatVectorKernels kernels[VECTOR_INSTRUCTION_SET_COUNT];
+			bool supported[VECTOR_INSTRUCTION_SET_COUNT];
+			VectorInstructionSet best;
+
+			KernelSets()
+			{
+				for (int set = 0; set < VECTOR_INSTRUCTION_SET_COUNT; set++)
+				{
+					scalar::GetKernels(kernels[set]);
+					supported[set] = false;
+				}
+
+				supported[VECTOR_SCALAR] = true;
+				best = VECTOR_SCALAR;
+
+#if VS_CPU_X86
+				const CpuFeatures &cpu = CpuFeatures::Get();
+
+				sse2::GetKernels(kernels[VECTOR_SSE2]);
+				avx2::GetKernels(kernels[VECTOR_AVX2]);
+				avx512::GetKernels(kernels[VECTOR_AVX512]);
+
+				supported[VECTOR_SSE2] = cpu.has_sse2;
+				supported[VECTOR_AVX2] = cpu.has_avx2;
+				supported[VECTOR_AVX512] = cpu.has_avx512f;
+
+				// Pick the widest instruction set
+				for (int set = VECTOR_SSE2; set < VECTOR_INSTRUCTION_SET_COUNT; set++)
+				{
+					if (supported[set])
+						best = (VectorInstructionSet)set;
+				}
+#endif
+			}
+		};
+
+		static KernelSets& GetKernelSets()
+		{
+			static KernelSets sets;
+			return sets;
+		}
+
+		static std::atomic<int> active_instruction_set(-1);
+
+		/// Get the kernels of the active instruction set (the widest one supported, unless another one was set)
+		static inline const FloatVectorKernels& Kernels()
+		{
+			KernelSets &sets = GetKernelSets();
+
+			int set = active_instruction_set.load(std::memory_order_relaxed);
+			if (set < 0)
+				set = sets.best;
+
+			return sets.kernels[set];
+		}
 	}
 }
 
 //==============================================================================
-void  FloatVectorOperations::clear(float* dest, int num) 
+VectorInstructionSet FloatVectorOperations::getInstructionSet()
 {
-	zeromem(dest, (size_t)num * sizeof(float));
+	int set = helpers::active_instruction_set.load(std::memory_order_relaxed);
+	return set < 0 ? helpers::GetKernelSets().best : (VectorInstructionSet)set;
 }
 
-void  FloatVectorOperations::clear(double* dest, int num) 
+bool FloatVectorOperations::setInstructionSet(VectorInstructionSet instructionSet)
 {
-	zeromem(dest, (size_t)num * sizeof(double));
+	if (!isInstructionSetSupported(instructionSet))
+		return false;
+
+	helpers::active_instruction_set.store(instructionSet, std::memory_order_relaxed);
+	return true;
 }
 
-void  FloatVectorOperations::fill(float* dest, float valueToFill, int num) 
+bool FloatVectorOperations::isInstructionSetSupported(VectorInstructionSet instructionSet)
 {
-	VS_PERFORM_VEC_OP_DEST(dest[i] = valueToFill, val, VS_LOAD_NONE,
-		const Mode::ParallelType val = Mode::load1(valueToFill);)
+	if (instructionSet < VECTOR_SCALAR || instructionSet >= VECTOR_INSTRUCTION_SET_COUNT)
+		return false;
+
+	return helpers::GetKernelSets().supported[instructionSet];
 }
 
-void  FloatVectorOperations::fill(double* dest, double valueToFill, int num) 
+//==============================================================================
+void  FloatVectorOperations::clear(float* dest, int num) 
+{
+	zeromem(dest, (size_t)num * sizeof(float));
+}
+
+void  FloatVectorOperations::clear(double* dest, int num) 
 {
-	VS_PERFORM_VEC_OP_DEST(dest[i] = valueToFill, val, VS_LOAD_NONE,
-		const Mode::ParallelType val = Mode::load1(valueToFill);)
+	zeromem(dest, (size_t)num * sizeof(double));
 }
 
 void  FloatVectorOperations::copy(float* dest, const float* src, int num) 
@@ -106,186 +129,164 @@ void  FloatVectorOperations::copy(double* dest, const double* src, int num)
 	memcpy(dest, src, (size_t)num * sizeof(double));
 }
 
+void  FloatVectorOperations::fill(float* dest, float valueToFill, int num) 
+{
+	helpers::Kernels().f.fill(dest, valueToFill, num);
+}
+
+void  FloatVectorOperations::fill(double* dest, double valueToFill, int num) 
+{
+	helpers::Kernels().d.fill(dest, valueToFill, num);
+}
+
 void  FloatVectorOperations::copyWithMultiply(float* dest, const float* src, float multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().f.copy_with_multiply(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::copyWithMultiply(double* dest, const double* src, double multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().d.copy_with_multiply(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::add(float* dest, float amount, int num) 
 {
-	VS_PERFORM_VEC_OP_DEST(dest[i] += amount, Mode::add(d, amountToAdd), VS_LOAD_DEST,
-		const Mode::ParallelType amountToAdd = Mode::load1(amount);)
+	helpers::Kernels().f.add_value(dest, amount, num);
 }
 
 void  FloatVectorOperations::add(double* dest, double amount, int num) 
 {
-	VS_PERFORM_VEC_OP_DEST(dest[i] += amount, Mode::add(d, amountToAdd), VS_LOAD_DEST,
-		const Mode::ParallelType amountToAdd = Mode::load1(amount);)
+	helpers::Kernels().d.add_value(dest, amount, num);
 }
 
 void  FloatVectorOperations::add(float* dest, const float* src, float amount, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] + amount, Mode::add(am, s),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType am = Mode::load1(amount);)
+	helpers::Kernels().f.add_src_value(dest, src, amount, num);
 }
 
 void  FloatVectorOperations::add(double* dest, const double* src, double amount, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] + amount, Mode::add(am, s),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType am = Mode::load1(amount);)
+	helpers::Kernels().d.add_src_value(dest, src, amount, num);
 }
 
 void  FloatVectorOperations::add(float* dest, const float* src, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i], Mode::add(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+	helpers::Kernels().f.add_src(dest, src, num);
 }
 
 void  FloatVectorOperations::add(double* dest, const double* src, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i], Mode::add(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+	helpers::Kernels().d.add_src(dest, src, num);
 }
 
 void  FloatVectorOperations::add(float* dest, const float* src1, const float* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] + src2[i], Mode::add(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().f.add_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::add(double* dest, const double* src1, const double* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] + src2[i], Mode::add(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().d.add_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::subtract(float* dest, const float* src, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i], Mode::sub(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+	helpers::Kernels().f.subtract_src(dest, src, num);
 }
 
 void  FloatVectorOperations::subtract(double* dest, const double* src, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i], Mode::sub(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+	helpers::Kernels().d.subtract_src(dest, src, num);
 }
 
 void  FloatVectorOperations::subtract(float* dest, const float* src1, const float* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] - src2[i], Mode::sub(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().f.subtract_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::subtract(double* dest, const double* src1, const double* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] - src2[i], Mode::sub(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().d.subtract_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::addWithMultiply(float* dest, const float* src, float multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i] * multiplier, Mode::add(d, Mode::mul(mult, s)),
-		VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().f.add_with_multiply_value(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::addWithMultiply(double* dest, const double* src, double multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] += src[i] * multiplier, Mode::add(d, Mode::mul(mult, s)),
-		VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().d.add_with_multiply_value(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::addWithMultiply(float* dest, const float* src1, const float* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] += src1[i] * src2[i], Mode::add(d, Mode::mul(s1, s2)),
-		VS_LOAD_SRC1_SRC2_DEST,
-		VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().f.add_with_multiply_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::addWithMultiply(double* dest, const double* src1, const double* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] += src1[i] * src2[i], Mode::add(d, Mode::mul(s1, s2)),
-		VS_LOAD_SRC1_SRC2_DEST,
-		VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().d.add_with_multiply_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::subtractWithMultiply(float* dest, const float* src, float multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i] * multiplier, Mode::sub(d, Mode::mul(mult, s)),
-		VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().f.subtract_with_multiply_value(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::subtractWithMultiply(double* dest, const double* src, double multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] -= src[i] * multiplier, Mode::sub(d, Mode::mul(mult, s)),
-		VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().d.subtract_with_multiply_value(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::subtractWithMultiply(float* dest, const float* src1, const float* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] -= src1[i] * src2[i], Mode::sub(d, Mode::mul(s1, s2)),
-		VS_LOAD_SRC1_SRC2_DEST,
-		VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().f.subtract_with_multiply_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::subtractWithMultiply(double* dest, const double* src1, const double* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(dest[i] -= src1[i] * src2[i], Mode::sub(d, Mode::mul(s1, s2)),
-		VS_LOAD_SRC1_SRC2_DEST,
-		VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().d.subtract_with_multiply_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::multiply(float* dest, const float* src, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] *= src[i], Mode::mul(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+	helpers::Kernels().f.multiply_src(dest, src, num);
 }
 
 void  FloatVectorOperations::multiply(double* dest, const double* src, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] *= src[i], Mode::mul(d, s), VS_LOAD_SRC_DEST, VS_INCREMENT_SRC_DEST, )
+	helpers::Kernels().d.multiply_src(dest, src, num);
 }
 
 void  FloatVectorOperations::multiply(float* dest, const float* src1, const float* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] * src2[i], Mode::mul(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().f.multiply_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::multiply(double* dest, const double* src1, const double* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = src1[i] * src2[i], Mode::mul(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().d.multiply_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::multiply(float* dest, float multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_DEST(dest[i] *= multiplier, Mode::mul(d, mult), VS_LOAD_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().f.multiply_value(dest, multiplier, num);
 }
 
 void  FloatVectorOperations::multiply(double* dest, double multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_DEST(dest[i] *= multiplier, Mode::mul(d, mult), VS_LOAD_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().d.multiply_value(dest, multiplier, num);
 }
 
 void  FloatVectorOperations::multiply(float* dest, const float* src, float multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().f.multiply_src_value(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::multiply(double* dest, const double* src, double multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = src[i] * multiplier, Mode::mul(mult, s),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().d.multiply_src_value(dest, src, multiplier, num);
 }
 
 void FloatVectorOperations::negate(float* dest, const float* src, int num) 
@@ -295,114 +296,102 @@ void FloatVectorOperations::negate(float* dest, const float* src, int num)
 
 void FloatVectorOperations::negate(double* dest, const double* src, int num) 
 {
-	copyWithMultiply(dest, src, -1.0f, num);
+	copyWithMultiply(dest, src, -1.0, num);
 }
 
-void FloatVectorOperations::abs(float* dest, const float* src, int num) 
+void  FloatVectorOperations::abs(float* dest, const float* src, int num) 
 {
-	helpers::signMask32 signMask;
-	signMask.i = 0x7fffffffUL;
-
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = fabsf(src[i]), Mode::bit_and(s, mask),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mask = Mode::load1(signMask.f);)
+	helpers::Kernels().f.abs(dest, src, num);
 }
 
-void FloatVectorOperations::abs(double* dest, const double* src, int num) 
+void  FloatVectorOperations::abs(double* dest, const double* src, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = fabs(src[i]), Mode::bit_and(s, mask),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mask = Mode::load1(signMask.d);)
+	helpers::Kernels().d.abs(dest, src, num);
 }
 
 void  FloatVectorOperations::convertFixedToFloat(float* dest, const int* src, float multiplier, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = (float)src[i] * multiplier,
-		Mode::mul(mult, _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) src))),
-		VS_LOAD_NONE, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType mult = Mode::load1(multiplier);)
+	helpers::Kernels().convert_fixed_to_float(dest, src, multiplier, num);
 }
 
 void  FloatVectorOperations::min(float* dest, const float* src, float comp, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = typed_min(src[i], comp), Mode::min(s, cmp),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType cmp = Mode::load1(comp);)
+	helpers::Kernels().f.min_value(dest, src, comp, num);
 }
 
 void  FloatVectorOperations::min(double* dest, const double* src, double comp, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = typed_min(src[i], comp), Mode::min(s, cmp),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType cmp = Mode::load1(comp);)
+	helpers::Kernels().d.min_value(dest, src, comp, num);
 }
 
 void  FloatVectorOperations::min(float* dest, const float* src1, const float* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = typed_min(src1[i], src2[i]), Mode::min(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().f.min_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::min(double* dest, const double* src1, const double* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = typed_min(src1[i], src2[i]), Mode::min(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().d.min_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::max(float* dest, const float* src, float comp, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = typed_max(src[i], comp), Mode::max(s, cmp),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType cmp = Mode::load1(comp);)
+	helpers::Kernels().f.max_value(dest, src, comp, num);
 }
 
 void  FloatVectorOperations::max(double* dest, const double* src, double comp, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = typed_max(src[i], comp), Mode::max(s, cmp),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType cmp = Mode::load1(comp);)
+	helpers::Kernels().d.max_value(dest, src, comp, num);
 }
 
 void  FloatVectorOperations::max(float* dest, const float* src1, const float* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = typed_max(src1[i], src2[i]), Mode::max(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().f.max_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::max(double* dest, const double* src1, const double* src2, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC1_SRC2_DEST(dest[i] = typed_max(src1[i], src2[i]), Mode::max(s1, s2), VS_LOAD_SRC1_SRC2, VS_INCREMENT_SRC1_SRC2_DEST, )
+	helpers::Kernels().d.max_src1_src2(dest, src1, src2, num);
 }
 
 void  FloatVectorOperations::clip(float* dest, const float* src, float low, float high, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = typed_max(typed_min(src[i], high), low), Mode::max(Mode::min(s, hi), lo),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType lo = Mode::load1(low); const Mode::ParallelType hi = Mode::load1(high);)
+	helpers::Kernels().f.clip(dest, src, low, high, num);
 }
 
 void  FloatVectorOperations::clip(double* dest, const double* src, double low, double high, int num) 
 {
-	VS_PERFORM_VEC_OP_SRC_DEST(dest[i] = typed_max(typed_min(src[i], high), low), Mode::max(Mode::min(s, hi), lo),
-		VS_LOAD_SRC, VS_INCREMENT_SRC_DEST,
-		const Mode::ParallelType lo = Mode::load1(low); const Mode::ParallelType hi = Mode::load1(high);)
+	helpers::Kernels().d.clip(dest, src, low, high, num);
 }
 
 float  FloatVectorOperations::findMinimum(const float* src, int num) 
 {
-	return vs::findMinimum(src, num);
+	return helpers::Kernels().f.find_minimum(src, num);
 }
 
 double  FloatVectorOperations::findMinimum(const double* src, int num) 
 {
-	return vs::findMinimum(src, num);
+	return helpers::Kernels().d.find_minimum(src, num);
 }
 
 float  FloatVectorOperations::findMaximum(const float* src, int num) 
 {
-	return vs::findMaximum(src, num);
+	return helpers::Kernels().f.find_maximum(src, num);
 }
 
 double  FloatVectorOperations::findMaximum(const double* src, int num) 
 {
-	return vs::findMaximum(src, num);
+	return helpers::Kernels().d.find_maximum(src, num);
+}
+
+void  FloatVectorOperations::findMinAndMax(const float* src, int num, float& lowest, float& highest) 
+{
+	helpers::Kernels().f.find_min_and_max(src, num, lowest, highest);
+}
+
+void  FloatVectorOperations::findMinAndMax(const double* src, int num, double& lowest, double& highest) 
+{
+	helpers::Kernels().d.find_min_and_max(src, num, lowest, highest);
 }
 
 /*
@@ -114,10 +114,32 @@ namespace vs
 		return N;
 	}
 
+	/// @brief The instruction sets FloatVectorOperations can run on
+	enum VectorInstructionSet
+	{
+		VECTOR_SCALAR = 0,		///< Plain C++ loops (the reference implementation)
+		VECTOR_SSE2,			///< SSE2 (4 floats / 2 doubles at a time)
+		VECTOR_AVX2,			///< AVX2 (8 floats / 4 doubles at a time)
+		VECTOR_AVX512,			///< AVX-512 (16 floats / 8 doubles at a time)
+		VECTOR_INSTRUCTION_SET_COUNT
+	};
+
 	/// @brief A collection of simple vector operations on arrays of floats
+	/// @remark Each operation has a kernel for every instruction set, and the widest one supported by the CPU
+	/// is picked the first time an operation is called (see setInstructionSet to force another one).
 	class FloatVectorOperations
 	{
 	public:
+		/// Get the instruction set the operations currently run on
+		static VectorInstructionSet getInstructionSet();
+
+		/// @brief Run the operations on another instruction set (i.e. to compare against the scalar reference)
+		/// @remark Returns false (and changes nothing) if the CPU doesn't support the instruction set.
+		static bool setInstructionSet(VectorInstructionSet instructionSet);
+
+		/// Check if the CPU supports an instruction set
+		static bool isInstructionSetSupported(VectorInstructionSet instructionSet);
+
 		/// Clears a vector of floats
 		static void  clear(float* dest, int numValues) ;
 
@@ -272,10 +294,10 @@ namespace vs
 		static void  clip(double* dest, const double* src, double low, double high, int num) ;
 
 		/// Finds the miniumum and maximum values in the given array
-		// static Range<float>  findMinAndMax(const float* src, int numValues) ;
+		static void  findMinAndMax(const float* src, int numValues, float& lowest, float& highest) ;
 
 		/// Finds the miniumum and maximum values in the given array
-		// static Range<double>  findMinAndMax(const double* src, int numValues) ;
+		static void  findMinAndMax(const double* src, int numValues, double& lowest, double& highest) ;
 
 		/// Finds the miniumum value in the given array
 		static float  findMinimum(const float* src, int numValues) ;
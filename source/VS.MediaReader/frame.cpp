@@ -13,6 +13,7 @@
 #include <fstream>
 
 #include "frame.hpp"
+#include "audio_conversion.hpp"
 
 #include <QFile>
 
@@ -21,7 +22,8 @@ using namespace vs;
 
 // Constructor - blank frame (300x200 blank image, 48kHz audio silence)
 Frame::Frame() : number(1),  pixel_ratio(1, 1), channels(2), width(1), height(1),
-channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false)
+channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false),
+	storage(NULL), storage_width(0), storage_height(0), storage_bytes_per_line(0), storage_image(false)
 {
 	// Init the image magic and audio buffer
 	audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer(channels, 0));
@@ -31,7 +33,8 @@ channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data
 // Constructor - image only (48kHz audio silence)
 Frame::Frame(long int number, int width, int height, string color)
 	: number(number), pixel_ratio(1, 1), channels(2), width(width), height(height),
-	channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false)
+	channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false),
+	storage(NULL), storage_width(0), storage_height(0), storage_bytes_per_line(0), storage_image(false)
 {
 	// Init the image magic and audio buffer
 	audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer(channels, 0));
@@ -41,7 +44,8 @@ Frame::Frame(long int number, int width, int height, string color)
 // Constructor - audio only (300x200 blank image)
 Frame::Frame(long int number, int samples, int channels) :
 	number(number),  pixel_ratio(1, 1), channels(channels), width(1), height(1),
-	channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false)
+	channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false),
+	storage(NULL), storage_width(0), storage_height(0), storage_bytes_per_line(0), storage_image(false)
 {
 	// Init the image magic and audio buffer
 	audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer(channels, 0));
@@ -51,15 +55,27 @@ Frame::Frame(long int number, int samples, int channels) :
 // Constructor - image & audio
 Frame::Frame(long int number, int width, int height, string color, int samples, int channels)
 	: number(number),  pixel_ratio(1, 1), channels(channels), width(width), height(height),
-	channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false)
+	channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false),
+	storage(NULL), storage_width(0), storage_height(0), storage_bytes_per_line(0), storage_image(false)
 {
 	// Init the image magic and audio buffer
 	audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer(channels, 0));
 	audio->clear();
 };
 
-// Copy constructor
+// Constructor - image & audio, laid out in a single buffer
+Frame::Frame(long int number, int width, int height, int bytes_per_line, int samples, int channels, PixelBuffer *storage)
+	: number(number), pixel_ratio(1, 1), channels(channels), width(width), height(height),
+	channel_layout(LAYOUT_STEREO), sample_rate(44100), qbuffer(NULL), has_audio_data(false), has_image_data(false),
+	storage(storage), storage_width(width), storage_height(height), storage_bytes_per_line(bytes_per_line), storage_image(false)
+{
+	// Point the audio buffer at the storage
+	AttachStorage(samples);
+};
+
+// Copy constructor (copies never share the storage of the other frame)
 Frame::Frame(const Frame &other)
+	: storage(NULL), storage_width(0), storage_height(0), storage_bytes_per_line(0), storage_image(false)
 {
 	// copy pointers and data
 	DeepCopy(other);
@@ -81,17 +97,49 @@ int Frame::constrain(int color_value)
 void Frame::DeepCopy(const Frame& other)
 {
 	number = other.number;
-	image = QSharedPointer<QImage>(new QImage(*(other.image)));
-	audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer(*(other.audio)));
+	width = other.width;
+	height = other.height;
+
+	// Share the pixels of the other frame (QImage is copy-on-write, so they are only copied if either image is modified)
+	if (other.image)
+		image = QSharedPointer<QImage>::create(*(other.image));
+
+	// Forget the storage of this frame (the old audio buffer held its reference, and the old image holds its own),
+	// so GetStoragePixels can't write into a buffer which may be back in the pool
+	storage = NULL;
+	storage_width = 0;
+	storage_height = 0;
+	storage_bytes_per_line = 0;
+	storage_image = false;
 	pixel_ratio = Fraction(other.pixel_ratio.num, other.pixel_ratio.den);
 	channels = other.channels;
+
+	// Make a copy of the samples (copying the buffer would just share the storage of the other frame, without a reference),
+	// laid out in a storage of its own with no image plane, since the pixels are shared
+	int samples = other.audio->getNumSamples();
+	if (other.audio->getNumChannels() == channels && channels > 0 && samples > 0)
+	{
+		storage = PixelBufferPool::AcquireUnpooled(GetStorageSize(0, 0, samples, channels));
+		AttachStorage(samples);
+	}
+
+	if (storage)
+	{
+		for (int channel = 0; channel < channels; channel++)
+			audio->copyFrom(channel, 0, *(other.audio), channel, 0, samples);
+	}
+	else
+	{
+		audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer());
+		audio->makeCopyOf(*(other.audio));
+	}
 	channel_layout = other.channel_layout;
-	has_audio_data = other.has_image_data;
+	has_audio_data = other.has_audio_data;
 	has_image_data = other.has_image_data;
 	sample_rate = other.sample_rate;
 
 	if (other.wave_image)
-		wave_image = QSharedPointer<QImage>(new QImage(*(other.wave_image)));
+		wave_image = QSharedPointer<QImage>::create(*(other.wave_image));
 }
 
 // Descructor
@@ -100,6 +148,73 @@ Frame::~Frame() {
 	image.reset();
 }
 
+// Point the audio buffer at the audio channels of the storage
+void Frame::AttachStorage(int samples)
+{
+	// The channel pointers are kept inside the audio buffer (no allocation), which has room for 31 channels
+	if (storage == NULL || channels >= 32 || GetStorageSize(storage_bytes_per_line, storage_height, samples, channels) > storage->size)
+	{
+		// No room, so release the storage and fall back to a separate audio buffer
+		PixelBufferPool::Release(storage);
+		storage = NULL;
+
+		audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer(channels, 0));
+		audio->clear();
+		return;
+	}
+
+	// The audio channels follow the image plane (each channel starts on an aligned address)
+	size_t plane_bytes = ((size_t)storage_bytes_per_line * storage_height + PixelBufferPool::Alignment - 1) & ~(PixelBufferPool::Alignment - 1);
+	size_t channel_bytes = ((size_t)samples * sizeof(float) + PixelBufferPool::Alignment - 1) & ~(PixelBufferPool::Alignment - 1);
+
+	float *channel_data[32];
+	for (int channel = 0; channel < channels; channel++)
+		channel_data[channel] = (float*)(storage->data + plane_bytes + channel * channel_bytes);
+
+	// The audio buffer owns the reference taken by the constructor (the storage is released when the buffer is deleted)
+	PixelBuffer *audio_storage = storage;
+	audio = QSharedPointer<AudioSampleBuffer>(new AudioSampleBuffer(channel_data, channels, samples), [audio_storage](AudioSampleBuffer *buffer) {
+		delete buffer;
+		PixelBufferPool::Release(audio_storage);
+	});
+
+	// Recycled storage holds old samples
+	audio->clear();
+}
+
+// Calculate the size (in bytes) of the storage of a frame (image plane, followed by the audio channels)
+size_t Frame::GetStorageSize(int bytes_per_line, int height, int samples, int channels)
+{
+	size_t plane_bytes = ((size_t)bytes_per_line * height + PixelBufferPool::Alignment - 1) & ~(PixelBufferPool::Alignment - 1);
+	size_t channel_bytes = ((size_t)samples * sizeof(float) + PixelBufferPool::Alignment - 1) & ~(PixelBufferPool::Alignment - 1);
+
+	return plane_bytes + channel_bytes * channels;
+}
+
+// Get the image plane of the storage, to write the pixels in place
+unsigned char* Frame::GetStoragePixels(int plane_width, int plane_height, int &bytes_per_line)
+{
+	// The plane can only be handed out once (an image might already be wrapping it)
+	if (storage == NULL || storage_image || storage_bytes_per_line == 0 || plane_width != storage_width || plane_height != storage_height)
+		return NULL;
+
+	bytes_per_line = storage_bytes_per_line;
+	return storage->data;
+}
+
+// Add (or replace) pixel data to the frame, using the pixels written to the image plane of the storage
+void Frame::AddStorageImage(QImage::Format format_type)
+{
+	if (storage == NULL || storage_image)
+		return;
+
+	// The image holds its own reference to the storage
+	PixelBufferPool::Retain(storage);
+	storage_image = true;
+
+	AddImage(storage_width, storage_height, storage_bytes_per_line, format_type, storage);
+}
+
 // Get an audio waveform image
 QSharedPointer<QImage> Frame::GetWaveform(int width, int height, int Red, int Green, int Blue, int Alpha)
 {
@@ -220,6 +335,24 @@ long int Frame::GetBytes()
 	return total_bytes;
 }
 
+// Get the size in bytes of this frame's image (rough estimate)
+long int Frame::GetImageBytes()
+{
+	if (image)
+		return width * height * sizeof(char) * 4;
+	else
+		return 0;
+}
+
+// Get a key identifying the pixels of this frame's image
+qint64 Frame::GetImageKey()
+{
+	if (image)
+		return image->cacheKey();
+	else
+		return 0;
+}
+
 
 // Get pixel data (as packets)
 const unsigned char* Frame::GetPixels()
@@ -231,15 +364,15 @@ const unsigned char* Frame::GetPixels()
 		AddColor(width, height, "#000000");
 	}
 
-	// Return array of pixel packets
-	return image->bits();
+	// Return array of pixel packets (read only, so shared pixels are not detached)
+	return image->constBits();
 }
 
 // Get pixel data (for only a single scan-line)
 const unsigned char* Frame::GetPixels(int row)
 {
-	// Return array of pixel packets
-	return image->scanLine(row);
+	// Return array of pixel packets (read only, so shared pixels are not detached)
+	return image->constScanLine(row);
 }
 
 // Set Picture Type
@@ -337,7 +470,7 @@ QSharedPointer<QImage> Frame::GetImage()
 void Frame::AddColor(int new_width, int new_height, string color)
 {
 	// Create new image object, and fill with pixel data
-	//std::lock_guard<std::mutex> lock(adding_image_mutex);
+	std::lock_guard<std::recursive_mutex> lock(adding_image_mutex);
 
 	image = QSharedPointer<QImage>(new QImage(new_width, new_height, QImage::Format_RGBA8888));
 
@@ -351,23 +484,45 @@ void Frame::AddColor(int new_width, int new_height, string color)
 }
 
 // Add (or replace) pixel data to the frame
-void Frame::AddImage(int new_width, int new_height, int bytes_per_pixel, QImage::Format format_type, const unsigned char *pixels_)
+void Frame::AddImage(int new_width, int new_height, int bytes_per_pixel, QImage::Format format_type, const unsigned char *pixels_, QSharedPointer<PixelBufferPool> pool)
 {
-	// Create new buffer
-	//std::lock_guard<std::mutex> lock(adding_image_mutex);
+	// Get a buffer (recycled from the pool when possible, no need to zero fill it since it's overwritten below)
+	std::lock_guard<std::recursive_mutex> lock(adding_image_mutex);
+
+	size_t buffer_size = (size_t)new_width * new_height * bytes_per_pixel;
+	PixelBuffer *buffer = NULL;
+	if (pool && pool->GetBufferSize() == buffer_size)
+		buffer = pool->Acquire();
+	else
+		buffer = PixelBufferPool::AcquireUnpooled(buffer_size);
 
-	int buffer_size = new_width * new_height * bytes_per_pixel;
-	qbuffer = new unsigned char[buffer_size]();
+	qbuffer = buffer->data;
 
 	// Copy buffer data
 	memcpy((unsigned char*)qbuffer, pixels_, buffer_size);
 
-	// Create new image object, and fill with pixel data
-	image = QSharedPointer<QImage>(new QImage(qbuffer, new_width, new_height, new_width * bytes_per_pixel, format_type, (QImageCleanupFunction)&vs::Frame::CleanUpBuffer, (void*)qbuffer));
+	// Create new image object, and fill with pixel data (the buffer is released when the image is deleted)
+	image = QSharedPointer<QImage>(new QImage(qbuffer, new_width, new_height, new_width * bytes_per_pixel, format_type, (QImageCleanupFunction)&vs::Frame::CleanUpBuffer, (void*)buffer));
 
 	// Always convert to RGBA8888 (if different)
 	if (image->format() != QImage::Format_RGBA8888)
-		image->convertToFormat(QImage::Format_RGBA8888);
+		image = QSharedPointer<QImage>::create(image->convertToFormat(QImage::Format_RGBA8888));
+
+	// Update height and width
+	width = image->width();
+	height = image->height();
+	has_image_data = true;
+}
+
+// Add (or replace) pixel data to the frame, taking ownership of the buffer (no copy)
+void Frame::AddImage(int new_width, int new_height, int bytes_per_line, QImage::Format format_type, PixelBuffer *buffer)
+{
+	std::lock_guard<std::recursive_mutex> lock(adding_image_mutex);
+
+	qbuffer = buffer->data;
+
+	// Create new image object, wrapping the pixel data (the buffer is released when the image is deleted)
+	image = QSharedPointer<QImage>::create(buffer->data, new_width, new_height, bytes_per_line, format_type, (QImageCleanupFunction)&vs::Frame::CleanUpBuffer, (void*)buffer);
 
 	// Update height and width
 	width = image->width();
@@ -383,14 +538,14 @@ void Frame::AddImage(QSharedPointer<QImage> new_image)
 		return;
 
 	// assign image data
-	//std::lock_guard<std::mutex> lock(adding_image_mutex);
+	std::lock_guard<std::recursive_mutex> lock(adding_image_mutex);
 
 	image = new_image;
 
 	// Always convert to RGBA8888 (if different)
 	if (image->format() != QImage::Format_RGBA8888)
 	{
-		image->convertToFormat(QImage::Format_RGBA8888);
+		image = QSharedPointer<QImage>::create(image->convertToFormat(QImage::Format_RGBA8888));
 	}
 
 	// Update height and width
@@ -404,9 +559,8 @@ void Frame::CleanUpBuffer(void *info)
 {
 	if (info)
 	{
-		// Remove buffer since QImage tells us to
-		unsigned char* ptr_to_qbuffer = (unsigned char*)info;
-		delete[] ptr_to_qbuffer;
+		// Release buffer since QImage tells us to (back to its pool, if it has one)
+		PixelBufferPool::Release((PixelBuffer*)info);
 	}
 }
 
@@ -414,7 +568,7 @@ void Frame::CleanUpBuffer(void *info)
 // Get number of audio channels
 int Frame::GetAudioChannelsCount()
 {
-	//std::lock_guard<std::mutex> lock(adding_audio_mutex);
+	std::lock_guard<std::recursive_mutex> lock(adding_audio_mutex);
 
 	if (audio)
 		return audio->getNumChannels();
@@ -425,7 +579,7 @@ int Frame::GetAudioChannelsCount()
 // Get number of audio samples
 int Frame::GetAudioSamplesCount()
 {
-	//std::lock_guard<std::mutex> lock(adding_audio_mutex);
+	std::lock_guard<std::recursive_mutex> lock(adding_audio_mutex);
 
 	if (audio)
 		return audio->getNumSamples();
@@ -434,7 +588,7 @@ int Frame::GetAudioSamplesCount()
 }
 
 void Frame::AddAudio(bool replaceSamples, int destChannel, int destStartSample, const float* source, int numSamples, float gainToApplyToSource = 1.0f) {
-	//std::lock_guard<std::mutex> lock(adding_audio_mutex);
+	std::lock_guard<std::recursive_mutex> lock(adding_audio_mutex);
 
 	{
 		// Extend audio container to hold more (or less) samples and channels.. if needed
@@ -470,7 +624,7 @@ QSharedPointer<AudioSampleBuffer> Frame::GetAudioBuffer()
 // Add audio silence
 void Frame::AddAudioSilence(int numSamples)
 {
-	//std::lock_guard<std::mutex> lock(adding_audio_mutex);
+	std::lock_guard<std::recursive_mutex> lock(adding_audio_mutex);
 
 	// Resize audio container
 	audio->setSize(channels, numSamples, false, true, false);
@@ -502,7 +656,7 @@ float* Frame::GetAudioSamples(int channel)
 // Resize audio container to hold more (or less) samples and channels
 void Frame::ResizeAudio(int channels, int length, int rate, ChannelLayout layout)
 {
-	//std::lock_guard<std::mutex> lock(adding_audio_mutex);
+	std::lock_guard<std::recursive_mutex> lock(adding_audio_mutex);
 
 	// Resize audio buffer
 	audio->setSize(channels, length, true, true, false);
@@ -513,62 +667,42 @@ void Frame::ResizeAudio(int channels, int length, int rate, ChannelLayout layout
 // Get a planar array of sample data
 float* Frame::GetPlanarAudioSamples()
 {
-	float *output = NULL;
-	AudioSampleBuffer *buffer(audio.get());
-	int num_of_channels = audio->getNumChannels();
-	int num_of_samples = audio->getNumSamples();
-
-	// INTERLEAVE all samples together (channel 1 + channel 2 + channel 1 + channel 2, etc...)
-	output = new float[num_of_channels * num_of_samples];
-	int position = 0;
-
-	// Loop through samples in each channel (combining them)
-	for (int channel = 0; channel < num_of_channels; channel++)
-	{
-		for (int sample = 0; sample < num_of_samples; sample++)
-		{
-			// Add sample to output array
-			output[position] = buffer->getReadPointer(channel)[sample];
-
-			// increment position
-			position++;
-		}
-	}
+	// Channel 1 (all samples) + channel 2 (all samples), etc...
+	float *output = new float[audio->getNumChannels() * audio->getNumSamples()];
+	GetPlanarAudioSamples(output);
 
 	// return combined array
 	return output;
 }
 
-
-// Get an array of sample data (all channels interleaved together)
-float* Frame::GetInterleavedAudioSamples()
+// Copy the sample data (planar) into a caller provided buffer
+void Frame::GetPlanarAudioSamples(float *output)
 {
-	float *output = NULL;
-	AudioSampleBuffer *buffer(audio.get());
 	int num_of_channels = audio->getNumChannels();
 	int num_of_samples = audio->getNumSamples();
 
-	// INTERLEAVE all samples together (channel 1 + channel 2 + channel 1 + channel 2, etc...)
-	output = new float[num_of_channels * num_of_samples];
-	int position = 0;
-
-	// Loop through samples in each channel (combining them)
-	for (int sample = 0; sample < num_of_samples; sample++)
-	{
-		for (int channel = 0; channel < num_of_channels; channel++)
-		{
-			// Add sample to output array
-			output[position] = buffer->getReadPointer(channel)[sample];
+	// Copy each channel after the previous one
+	for (int channel = 0; channel < num_of_channels; channel++)
+		FloatVectorOperations::copy(output + channel * num_of_samples, audio->getReadPointer(channel), num_of_samples);
+}
 
-			// increment position
-			position++;
-		}
-	}
 
+// Get an array of sample data (all channels interleaved together)
+float* Frame::GetInterleavedAudioSamples()
+{
+	// INTERLEAVE all samples together (channel 1 + channel 2 + channel 1 + channel 2, etc...)
+	float *output = new float[audio->getNumChannels() * audio->getNumSamples()];
+	GetInterleavedAudioSamples(output);
 
 	// return combined array
 	return output;
 }
+
+// Copy the sample data (all channels interleaved together) into a caller provided buffer
+void Frame::GetInterleavedAudioSamples(float *output)
+{
+	AudioConversion::Interleave(output, audio->getArrayOfReadPointers(), audio->getNumChannels(), audio->getNumSamples());
+}
 /*
 =============================================================
 Copyright Venatio Studios 2019
@@ -25,6 +25,7 @@
 #include "common.hpp"
 #include "utilities.hpp"
 #include "audio_buffer.hpp"
+#include "buffer_pool.hpp"
 
 using namespace vs;
 
@@ -69,8 +70,8 @@ namespace vs
 	///  @endcode
 	class Frame {
 	private:
-		std::mutex adding_image_mutex;
-		std::mutex adding_audio_mutex;
+		std::recursive_mutex adding_image_mutex;
+		std::recursive_mutex adding_audio_mutex;
 
 		// Image Data
 		QSharedPointer<QImage> image;
@@ -86,10 +87,20 @@ namespace vs
 		int height;
 		int sample_rate;
 		QSharedPointer<QImage> wave_image;
+
+		// Storage (a single buffer holding the image plane, followed by the audio channels)
+		PixelBuffer *storage;
+		int storage_width;
+		int storage_height;
+		int storage_bytes_per_line;
+		bool storage_image;
 		
 		/// Constrain a color value from 0 to 255
 		int constrain(int color_value);
 
+		/// Point the audio buffer at the audio channels of the storage (or allocate it, if the storage is too small)
+		void AttachStorage(int samples);
+
 
 		/// Display the wave form
 		void DisplayWaveform();
@@ -110,7 +121,16 @@ namespace vs
 		/// Constructor - image & audio
 		Frame(long int number, int width, int height, string color, int samples, int channels);
 
-		/// Copy constructor
+		/// @brief Constructor - image & audio, laid out in a single buffer
+		/// @remark The frame takes ownership of the storage (see GetStorageSize for its layout). The audio buffer
+		/// refers to the channels inside the storage, and the pixels can be written in place (see GetStoragePixels).
+		/// Only the image and the audio are laid out in the storage: audio growing past its room (see AddAudio and
+		/// ResizeAudio), more than 31 channels, and the waveform image get allocations of their own.
+		/// @param bytes_per_line The stride of the image plane (0 when the storage holds no image plane)
+		Frame(long int number, int width, int height, int bytes_per_line, int samples, int channels, PixelBuffer *storage);
+
+		/// @brief Copy constructor
+		/// @remark The copy shares the pixels of the other frame, and lays its audio out in a storage of its own.
 		Frame(const Frame &other);
 
 		/// Destructor
@@ -119,10 +139,20 @@ namespace vs
 		/// Add (or replace) pixel data to the frame (based on a solid color)
 		void AddColor(int new_width, int new_height, string color);
 
-		/// Add (or replace) pixel data to the frame
-		void AddImage(int new_width, int new_height, int bytes_per_pixel, QImage::Format format_type, const unsigned char *pixels_);
+		/// @brief Add (or replace) pixel data to the frame
+		/// @remark The pixels are copied into a buffer from the pool (if any), which is returned to the pool
+		/// once the last reference to the image is dropped.
+		void AddImage(int new_width, int new_height, int bytes_per_pixel, QImage::Format format_type, const unsigned char *pixels_, QSharedPointer<PixelBufferPool> pool = QSharedPointer<PixelBufferPool>());
 
-		/// Add (or replace) pixel data to the frame
+		/// @brief Add (or replace) pixel data to the frame, taking ownership of the buffer (no copy)
+		/// @remark The buffer is released (back to its pool, if any) once the last reference to the image is dropped.
+		/// @param bytes_per_line The stride of the pixel data, which can be padded for alignment
+		/// @param buffer A buffer from PixelBufferPool (never NULL, since failed allocations throw)
+		void AddImage(int new_width, int new_height, int bytes_per_line, QImage::Format format_type, PixelBuffer *buffer);
+
+		/// @brief Add (or replace) pixel data to the frame
+		/// @remark To share the pixels of another frame, pass a copy of its image (QImage copies share the pixels
+		/// until one of them is modified).
 		void AddImage(QSharedPointer<QImage> new_image);
 
 		/// @brief Channel Layout of audio samples.
@@ -133,13 +163,24 @@ namespace vs
 		/// Set the channel layout of audio samples (i.e. mono, stereo, 5 point surround, etc...)
 		void ChannelsLayout(ChannelLayout new_channel_layout) { channel_layout = new_channel_layout; };
 
-		/// Clean up buffer after QImage is deleted
+		/// Clean up buffer after QImage is deleted (info is the PixelBuffer, which goes back to its pool)
 		static void CleanUpBuffer(void *info);
 
+		/// Calculate the size (in bytes) of the storage of a frame (image plane, followed by the audio channels)
+		static size_t GetStorageSize(int bytes_per_line, int height, int samples, int channels);
+
+		/// @brief Get the image plane of the storage, to write the pixels in place
+		/// @remark Returns NULL if the frame has no storage, the plane is a different size, or the plane is already in use.
+		unsigned char* GetStoragePixels(int plane_width, int plane_height, int &bytes_per_line);
+
+		/// Add (or replace) pixel data to the frame, using the pixels written to the image plane of the storage
+		void AddStorageImage(QImage::Format format_type);
+
 		/// Clear the waveform image (and deallocate it's memory)
 		void ClearWaveform();
 
-		/// Copy data and pointers from another Frame instance
+		/// @brief Copy data and pointers from another Frame instance
+		/// @remark The pixels are shared with the other frame, and only copied once either image is modified (copy-on-write).
 		void DeepCopy(const Frame& other);
 
 		/// Calculate the # of samples per video frame (for the current frame number)
@@ -168,12 +209,20 @@ namespace vs
 		/// Get an array of sample data
 		float* GetAudioSamples(int channel);
 
-		/// Get an array of sample data (all channels interleaved together)
+		/// Get an array of sample data (all channels interleaved together). The caller deletes the array (delete[]).
 		float* GetInterleavedAudioSamples();
 
-		/// Get a planar array of sample data
+		/// @brief Copy the sample data (all channels interleaved together) into a caller provided buffer
+		/// @param output Room for GetAudioChannelsCount() * GetAudioSamplesCount() samples
+		void GetInterleavedAudioSamples(float *output);
+
+		/// Get a planar array of sample data. The caller deletes the array (delete[]).
 		float* GetPlanarAudioSamples();
 
+		/// @brief Copy the sample data (planar, one channel after the other) into a caller provided buffer
+		/// @param output Room for GetAudioChannelsCount() * GetAudioSamplesCount() samples
+		void GetPlanarAudioSamples(float *output);
+
 		/// Resize audio container to hold more (or less) samples and channels
 		void ResizeAudio(int channels, int length, int sample_rate, ChannelLayout channel_layout);
 
@@ -186,13 +235,23 @@ namespace vs
 		/// Get the size in bytes of this frame (rough estimate)
 		long int GetBytes();
 
-		/// Get pointer to Qt QImage image object
+		/// Get the size in bytes of this frame's image (rough estimate, included in GetBytes)
+		long int GetImageBytes();
+
+		/// @brief Get a key identifying the pixels of this frame's image (0 if there is no image)
+		/// @remark Frames sharing the same pixels (see DeepCopy) have the same key, until one of them is modified.
+		qint64 GetImageKey();
+
+		/// @brief Get pointer to Qt QImage image object
+		/// @remark The pixels can be shared with other frames. Read them with constBits() / constScanLine(): the non-const
+		/// accessors (bits(), scanLine(), QPainter, etc...) give this image a private copy of the pixels first.
 		QSharedPointer<QImage> GetImage();
 
 		/// Set Pixel Aspect Ratio
 		Fraction GetPixelRatio() { return pixel_ratio; };
 
-		/// Get pixel data (as packets)
+		/// @brief Get pixel data (as packets)
+		/// @remark Lines can be padded for alignment, use GetImage()->bytesPerLine() to step between lines.
 		const unsigned char* GetPixels();
 
 		/// Get pixel data (for only a single scan-line)
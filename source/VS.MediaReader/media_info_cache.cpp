@@ -0,0 +1,385 @@
+/*
+@file		media_info_cache.cpp
+@author		Webstar
+@date		2026-10-18 22:20
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <vector>
+
+// QT
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "media_info_cache.hpp"
+
+using namespace std;
+using namespace vs;
+
+namespace vs
+{
+	namespace helpers
+	{
+		/// Write a fraction
+		inline void WriteFraction(QDataStream &stream, const Fraction &fraction)
+		{
+			stream << (qint32)fraction.num << (qint32)fraction.den;
+		}
+
+		/// Read a fraction
+		inline void ReadFraction(QDataStream &stream, Fraction &fraction)
+		{
+			qint32 num, den;
+			stream >> num >> den;
+			fraction.num = num;
+			fraction.den = den;
+		}
+
+		/// Write a string
+		inline void WriteString(QDataStream &stream, const string &text)
+		{
+			stream << QString::fromStdString(text);
+		}
+
+		/// Read a string
+		inline void ReadString(QDataStream &stream, string &text)
+		{
+			QString value;
+			stream >> value;
+			text = value.toStdString();
+		}
+	}
+
+	QDataStream& operator<<(QDataStream &stream, const StreamParameters &parameters)
+	{
+		stream << (qint32)parameters.index << (qint32)parameters.codec_type << (qint32)parameters.codec_id << parameters.codec_tag
+			<< parameters.bit_rate << (qint32)parameters.format << (qint32)parameters.bits_per_coded_sample
+			<< (qint32)parameters.bits_per_raw_sample << (qint32)parameters.profile << (qint32)parameters.level
+			<< (qint32)parameters.width << (qint32)parameters.height;
+		helpers::WriteFraction(stream, parameters.sample_aspect_ratio);
+		stream << (qint32)parameters.field_order << (qint32)parameters.color_range << (qint32)parameters.color_primaries
+			<< (qint32)parameters.color_trc << (qint32)parameters.color_space << (qint32)parameters.chroma_location
+			<< (qint32)parameters.video_delay << parameters.channel_layout << (qint32)parameters.channels
+			<< (qint32)parameters.sample_rate << (qint32)parameters.block_align << (qint32)parameters.frame_size
+			<< (qint32)parameters.initial_padding << (qint32)parameters.trailing_padding << (qint32)parameters.seek_preroll
+			<< parameters.extradata;
+		helpers::WriteFraction(stream, parameters.time_base);
+		helpers::WriteFraction(stream, parameters.avg_frame_rate);
+		helpers::WriteFraction(stream, parameters.r_frame_rate);
+		stream << parameters.start_time << parameters.duration;
+
+		return stream;
+	}
+
+	QDataStream& operator>>(QDataStream &stream, StreamParameters &parameters)
+	{
+		qint32 index, codec_type, codec_id, format, bits_per_coded_sample, bits_per_raw_sample, profile, level, width, height;
+		stream >> index >> codec_type >> codec_id >> parameters.codec_tag >> parameters.bit_rate >> format >> bits_per_coded_sample
+			>> bits_per_raw_sample >> profile >> level >> width >> height;
+		helpers::ReadFraction(stream, parameters.sample_aspect_ratio);
+
+		qint32 field_order, color_range, color_primaries, color_trc, color_space, chroma_location, video_delay, channels, sample_rate,
+			block_align, frame_size, initial_padding, trailing_padding, seek_preroll;
+		stream >> field_order >> color_range >> color_primaries >> color_trc >> color_space >> chroma_location >> video_delay
+			>> parameters.channel_layout >> channels >> sample_rate >> block_align >> frame_size >> initial_padding
+			>> trailing_padding >> seek_preroll >> parameters.extradata;
+		helpers::ReadFraction(stream, parameters.time_base);
+		helpers::ReadFraction(stream, parameters.avg_frame_rate);
+		helpers::ReadFraction(stream, parameters.r_frame_rate);
+		stream >> parameters.start_time >> parameters.duration;
+
+		parameters.index = index;
+		parameters.codec_type = codec_type;
+		parameters.codec_id = codec_id;
+		parameters.format = format;
+		parameters.bits_per_coded_sample = bits_per_coded_sample;
+		parameters.bits_per_raw_sample = bits_per_raw_sample;
+		parameters.profile = profile;
+		parameters.level = level;
+		parameters.width = width;
+		parameters.height = height;
+		parameters.field_order = field_order;
+		parameters.color_range = color_range;
+		parameters.color_primaries = color_primaries;
+		parameters.color_trc = color_trc;
+		parameters.color_space = color_space;
+		parameters.chroma_location = chroma_location;
+		parameters.video_delay = video_delay;
+		parameters.channels = channels;
+		parameters.sample_rate = sample_rate;
+		parameters.block_align = block_align;
+		parameters.frame_size = frame_size;
+		parameters.initial_padding = initial_padding;
+		parameters.trailing_padding = trailing_padding;
+		parameters.seek_preroll = seek_preroll;
+
+		return stream;
+	}
+
+	QDataStream& operator<<(QDataStream &stream, const MediaInfoSnapshot &snapshot)
+	{
+		const MediaInfo &info = snapshot.info;
+
+		stream << info.has_video << info.has_audio << info.has_single_image << info.duration << (qint64)info.file_size
+			<< (qint32)info.height << (qint32)info.width << (qint32)info.pixel_format;
+		helpers::WriteFraction(stream, info.fps);
+		stream << (qint32)info.video_bit_rate;
+		helpers::WriteFraction(stream, info.pixel_ratio);
+		helpers::WriteFraction(stream, info.display_ratio);
+		helpers::WriteString(stream, info.vcodec);
+		stream << (qint64)info.video_length << (qint32)info.video_stream_index;
+		helpers::WriteFraction(stream, info.video_timebase);
+		stream << info.interlaced_frame << info.top_field_first;
+		helpers::WriteString(stream, info.acodec);
+		stream << (qint32)info.audio_bit_rate << (qint32)info.sample_rate << (qint32)info.channels << (qint64)info.channel_layout
+			<< (qint32)info.audio_stream_index;
+		helpers::WriteFraction(stream, info.audio_timebase);
+
+		stream << snapshot.is_duration_known << snapshot.video_pts_offset << snapshot.audio_pts_offset << (qint32)snapshot.stream_count
+			<< snapshot.video << snapshot.audio;
+
+		return stream;
+	}
+
+	QDataStream& operator>>(QDataStream &stream, MediaInfoSnapshot &snapshot)
+	{
+		MediaInfo &info = snapshot.info;
+
+		qint64 file_size, video_length, channel_layout;
+		qint32 height, width, pixel_format, video_bit_rate, video_stream_index, audio_bit_rate, sample_rate, channels, audio_stream_index, stream_count;
+
+		stream >> info.has_video >> info.has_audio >> info.has_single_image >> info.duration >> file_size >> height >> width >> pixel_format;
+		helpers::ReadFraction(stream, info.fps);
+		stream >> video_bit_rate;
+		helpers::ReadFraction(stream, info.pixel_ratio);
+		helpers::ReadFraction(stream, info.display_ratio);
+		helpers::ReadString(stream, info.vcodec);
+		stream >> video_length >> video_stream_index;
+		helpers::ReadFraction(stream, info.video_timebase);
+		stream >> info.interlaced_frame >> info.top_field_first;
+		helpers::ReadString(stream, info.acodec);
+		stream >> audio_bit_rate >> sample_rate >> channels >> channel_layout >> audio_stream_index;
+		helpers::ReadFraction(stream, info.audio_timebase);
+
+		stream >> snapshot.is_duration_known >> snapshot.video_pts_offset >> snapshot.audio_pts_offset >> stream_count
+			>> snapshot.video >> snapshot.audio;
+
+		info.file_size = file_size;
+		info.height = height;
+		info.width = width;
+		info.pixel_format = pixel_format;
+		info.video_bit_rate = video_bit_rate;
+		info.video_length = (long int)video_length;
+		info.video_stream_index = video_stream_index;
+		info.audio_bit_rate = audio_bit_rate;
+		info.sample_rate = sample_rate;
+		info.channels = channels;
+		info.channel_layout = (ChannelLayout)channel_layout;
+		info.audio_stream_index = audio_stream_index;
+		snapshot.stream_count = stream_count;
+
+		return stream;
+	}
+}
+
+const int MediaInfoCache::DefaultMaxSnapshots;
+
+MediaInfoCache::MediaInfoCache()
+	: max_snapshots(DefaultMaxSnapshots)
+{
+}
+
+// Get the cache shared by all readers
+MediaInfoCache& MediaInfoCache::Global()
+{
+	static MediaInfoCache cache;
+	return cache;
+}
+
+// Add (or replace) a snapshot, as the most recently used one
+void MediaInfoCache::Insert(const QString &key, const MediaInfoSnapshot &snapshot)
+{
+	QHash<QString, CacheEntry>::iterator itr = snapshots.find(key);
+	if (itr != snapshots.end())
+	{
+		itr->snapshot = snapshot;
+		recency.splice(recency.begin(), recency, itr->recency);
+	}
+	else
+	{
+		recency.push_front(key);
+		CacheEntry entry = { snapshot, recency.begin() };
+		snapshots.insert(key, entry);
+	}
+
+	// Remove the least recently used snapshots
+	while (max_snapshots > 0 && snapshots.size() > max_snapshots)
+	{
+		snapshots.remove(recency.back());
+		recency.pop_back();
+	}
+}
+
+// Get the key of a file
+QString MediaInfoCache::GetFileKey(const std::string &path)
+{
+	QFileInfo file(QString::fromStdString(path));
+	if (!file.isFile())
+		return QString();
+
+	// A modified (or replaced) file gets a new key
+	return QString("%1|%2|%3").arg(file.canonicalFilePath()).arg(file.size()).arg(file.lastModified().toMSecsSinceEpoch());
+}
+
+// Find the snapshot of a file
+bool MediaInfoCache::Find(const QString &key, MediaInfoSnapshot &snapshot)
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+
+	QHash<QString, CacheEntry>::iterator itr = snapshots.find(key);
+	if (itr == snapshots.end())
+		return false;
+
+	// Keep the snapshots in use the longest
+	recency.splice(recency.begin(), recency, itr->recency);
+
+	snapshot = itr->snapshot;
+	return true;
+}
+
+// Add (or replace) the snapshot of a file
+void MediaInfoCache::Store(const QString &key, const MediaInfoSnapshot &snapshot)
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+
+	Insert(key, snapshot);
+}
+
+// Remove the snapshot of a file
+void MediaInfoCache::Remove(const QString &key)
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+
+	QHash<QString, CacheEntry>::iterator itr = snapshots.find(key);
+	if (itr == snapshots.end())
+		return;
+
+	recency.erase(itr->recency);
+	snapshots.erase(itr);
+}
+
+// Remove every snapshot
+void MediaInfoCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+
+	snapshots.clear();
+	recency.clear();
+}
+
+// Count the snapshots
+int MediaInfoCache::Count()
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+
+	return snapshots.size();
+}
+
+// Get the most snapshots kept
+int MediaInfoCache::GetMaxSnapshots()
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+
+	return max_snapshots;
+}
+
+// Set the most snapshots kept
+void MediaInfoCache::SetMaxSnapshots(int count)
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+
+	max_snapshots = count;
+	while (max_snapshots > 0 && snapshots.size() > max_snapshots)
+	{
+		snapshots.remove(recency.back());
+		recency.pop_back();
+	}
+}
+
+// Write every snapshot to a file
+bool MediaInfoCache::Save(const QString &file_path)
+{
+	// Write a new file, and replace the old one once it's complete
+	QSaveFile file(file_path);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << FileMagic << FileVersion;
+
+	{
+		std::lock_guard<std::mutex> lock(cache_mutex);
+
+		// The least recently used first (so Load() keeps the order)
+		stream << (qint32)snapshots.size();
+		for (std::list<QString>::reverse_iterator itr = recency.rbegin(); itr != recency.rend(); ++itr)
+			stream << *itr << snapshots.value(*itr).snapshot;
+	}
+
+	return stream.status() == QDataStream::Ok && file.commit();
+}
+
+// Add the snapshots of a file written by Save()
+bool MediaInfoCache::Load(const QString &file_path)
+{
+	QFile file(file_path);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	quint32 magic, version;
+	stream >> magic >> version;
+	if (magic != FileMagic || version != FileVersion)
+		return false;
+
+	// Read everything first (a truncated file adds nothing)
+	qint32 count;
+	stream >> count;
+
+	std::vector<std::pair<QString, MediaInfoSnapshot>> loaded;
+	for (qint32 index = 0; index < count && stream.status() == QDataStream::Ok; index++)
+	{
+		QString key;
+		MediaInfoSnapshot snapshot;
+		stream >> key >> snapshot;
+		loaded.push_back(std::make_pair(key, snapshot));
+	}
+
+	if (stream.status() != QDataStream::Ok)
+		return false;
+
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	for (size_t index = 0; index < loaded.size(); index++)
+		Insert(loaded[index].first, loaded[index].second);
+
+	return true;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 22:20
+#vNext
+=============================================================
+*/
@@ -0,0 +1,167 @@
+#ifndef GUARD_media_info_cache_20261018222040_
+#define GUARD_media_info_cache_20261018222040_
+/*
+@file		media_info_cache.hpp
+@author		Webstar
+@date		2026-10-18 22:20
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <list>
+#include <mutex>
+#include <string>
+
+// QT
+#include <QByteArray>
+#include <QDataStream>
+#include <QHash>
+#include <QString>
+
+#include "common.hpp"
+
+namespace vs
+{
+	/// @brief The parameters of a stream, as probed by avformat_find_stream_info (every field of AVCodecParameters)
+	struct StreamParameters
+	{
+		int index;						///< The index of the stream (-1 if there is no such stream)
+		int codec_type;
+		int codec_id;
+		quint32 codec_tag;
+		qint64 bit_rate;
+		int format;						///< The pixel format or sample format
+		int bits_per_coded_sample;
+		int bits_per_raw_sample;
+		int profile;
+		int level;
+		int width;
+		int height;
+		Fraction sample_aspect_ratio;
+		int field_order;
+		int color_range;
+		int color_primaries;
+		int color_trc;
+		int color_space;
+		int chroma_location;
+		int video_delay;				///< The frames of delay of the decoder (i.e. for B-frames, see has_b_frames)
+		quint64 channel_layout;
+		int channels;
+		int sample_rate;
+		int block_align;
+		int frame_size;
+		int initial_padding;
+		int trailing_padding;
+		int seek_preroll;
+		QByteArray extradata;
+		Fraction time_base;				///< The time base of the stream (the snapshot is only used if it matches)
+		Fraction avg_frame_rate;
+		Fraction r_frame_rate;
+		qint64 start_time;
+		qint64 duration;
+	};
+
+	/// @brief Everything FFmpegReader::Open() learns about a file by probing and decoding its first packets
+	struct MediaInfoSnapshot
+	{
+		MediaInfo info;
+		bool is_duration_known;
+		qint64 video_pts_offset;		///< 99999 if it wasn't known yet
+		qint64 audio_pts_offset;		///< 99999 if it wasn't known yet
+		int stream_count;				///< The number of streams of the file (the snapshot is only used if it matches)
+		StreamParameters video;
+		StreamParameters audio;
+	};
+
+	/// @brief This class keeps the snapshots of the files opened before, so opening them again skips the probing
+	/// @remark The snapshots are keyed by the identity of the file (its path, size and modification time), so a
+	/// modified file is probed again. Save the cache with a project, and load it before opening the project,
+	/// so its clips open without probing (and without decoding their first frame to find the PTS offsets).
+	/// The cache keeps the most recently used snapshots, up to its max snapshots (4096 by default).
+	/// @code
+	/// MediaInfoCache::Global().Load(project_path + ".mediainfo");
+	/// // ... open the readers of the project ...
+	/// MediaInfoCache::Global().Save(project_path + ".mediainfo");
+	/// @endcode
+	class MediaInfoCache
+	{
+	private:
+		/// A snapshot, and its place in the recency list
+		struct CacheEntry
+		{
+			MediaInfoSnapshot snapshot;
+			std::list<QString>::iterator recency;
+		};
+
+		std::mutex cache_mutex;
+		QHash<QString, CacheEntry> snapshots;
+		std::list<QString> recency;		///< The keys of the snapshots, the most recently used first
+		int max_snapshots;
+
+		/// Add (or replace) a snapshot, as the most recently used one, and remove the least recently used ones over the limit
+		void Insert(const QString &key, const MediaInfoSnapshot &snapshot);
+
+	public:
+		/// Identifies the files written by Save() (and their version)
+		static const quint32 FileMagic = 0x56534D49;
+		static const quint32 FileVersion = 3;
+
+		/// The max snapshots of a new cache
+		static const int DefaultMaxSnapshots = 4096;
+
+		MediaInfoCache();
+
+		/// Get the cache shared by all readers
+		static MediaInfoCache& Global();
+
+		/// Get the key of a file (empty if it isn't a local file, i.e. a URL)
+		static QString GetFileKey(const std::string &path);
+
+		/// Find the snapshot of a file
+		bool Find(const QString &key, MediaInfoSnapshot &snapshot);
+
+		/// Add (or replace) the snapshot of a file
+		void Store(const QString &key, const MediaInfoSnapshot &snapshot);
+
+		/// Remove the snapshot of a file
+		void Remove(const QString &key);
+
+		/// Remove every snapshot
+		void Clear();
+
+		/// Count the snapshots
+		int Count();
+
+		/// Get the most snapshots kept (the least recently used ones are removed first)
+		int GetMaxSnapshots();
+
+		/// Set the most snapshots kept (0 for no limit)
+		void SetMaxSnapshots(int count);
+
+		/// Write every snapshot to a file (returns false if it can't be written)
+		bool Save(const QString &file_path);
+
+		/// Add the snapshots of a file written by Save() (returns false if it can't be read, or is from another version)
+		bool Load(const QString &file_path);
+	};
+
+	QDataStream& operator<<(QDataStream &stream, const StreamParameters &parameters);
+	QDataStream& operator>>(QDataStream &stream, StreamParameters &parameters);
+	QDataStream& operator<<(QDataStream &stream, const MediaInfoSnapshot &snapshot);
+	QDataStream& operator>>(QDataStream &stream, MediaInfoSnapshot &snapshot);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 22:20
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,248 @@
+/*
+@file		multi_cursor_reader.cpp
+@author		Webstar
+@date		2026-10-18 20:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <algorithm>
+
+#include "multi_cursor_reader.hpp"
+
+using namespace std;
+using namespace vs;
+using namespace vs::exceptions;
+
+// Constructor
+MultiCursorReader::MultiCursorReader(string path, int max_cursors)
+	: path(path), max_cursors(std::max(1, max_cursors)), is_open(false), use_counter(0), opening_count(0)
+{
+	// The defaults of FFmpegReader
+	FFmpegReader defaults(path);
+	enable_seek = defaults.enable_seek;
+	enable_frame_dedup = defaults.enable_frame_dedup;
+	enable_yuv_converter = defaults.enable_yuv_converter;
+	enable_prefetch = defaults.enable_prefetch;
+	max_pinned_bytes = defaults.max_pinned_bytes;
+	probe_size = defaults.probe_size;
+	analyze_duration = defaults.analyze_duration;
+	enable_video = defaults.enable_video;
+	enable_audio = defaults.enable_audio;
+	low_latency_open = defaults.low_latency_open;
+	info_cache = defaults.info_cache;
+	scrub_refine_delay = defaults.scrub_refine_delay;
+}
+
+// Constructor
+MultiCursorReader::MultiCursorReader(QString path, int max_cursors)
+	: MultiCursorReader(path.toStdString(), max_cursors)  // Delegate Constructor
+{
+}
+
+// Destructor
+MultiCursorReader::~MultiCursorReader()
+{
+	Close();
+}
+
+// Open File
+void MultiCursorReader::Open()
+{
+	std::lock_guard<std::mutex> lock(cursors_mutex);
+
+	if (is_open)
+		return;
+
+	// The first cursor also provides the details of the file
+	QSharedPointer<FFmpegReader> reader = OpenCursor();
+	info = reader->info;
+
+	Cursor cursor = { reader, use_counter++ };
+	cursors.push_back(cursor);
+	is_open = true;
+}
+
+// Close File (and every cursor)
+void MultiCursorReader::Close()
+{
+	std::lock_guard<std::mutex> lock(cursors_mutex);
+
+	for (size_t i = 0; i < cursors.size(); i++)
+		cursors[i].reader->Close();
+
+	cursors.clear();
+	is_open = false;
+}
+
+// Get the number of open cursors
+int MultiCursorReader::GetCursorCount()
+{
+	std::lock_guard<std::mutex> lock(cursors_mutex);
+
+	return (int)cursors.size();
+}
+
+// Get the number of video frames decoded by the open cursors
+long long int MultiCursorReader::GetDecodedVideoFrames()
+{
+	std::lock_guard<std::mutex> lock(cursors_mutex);
+
+	long long int decoded = 0;
+	for (size_t i = 0; i < cursors.size(); i++)
+		decoded += cursors[i].reader->GetDecodedVideoFrames();
+
+	return decoded;
+}
+
+// Create and open a new cursor
+QSharedPointer<FFmpegReader> MultiCursorReader::OpenCursor()
+{
+	QSharedPointer<FFmpegReader> reader(new FFmpegReader(path));
+	reader->enable_seek = enable_seek;
+	reader->enable_frame_dedup = enable_frame_dedup;
+	reader->enable_yuv_converter = enable_yuv_converter;
+	reader->enable_prefetch = enable_prefetch;
+	reader->max_pinned_bytes = max_pinned_bytes;
+	reader->probe_size = probe_size;
+	reader->analyze_duration = analyze_duration;
+	reader->enable_video = enable_video;
+	reader->enable_audio = enable_audio;
+	reader->low_latency_open = low_latency_open;
+	reader->info_cache = info_cache;
+	reader->scrub_refine_delay = scrub_refine_delay;
+	reader->Open();
+
+	return reader;
+}
+
+// Pick an open cursor for a frame (called with the lock held)
+int MultiCursorReader::PickCursor(long int requested_frame)
+{
+	int best = -1;
+
+	// A cursor which already has the frame
+	for (size_t i = 0; i < cursors.size() && best < 0; i++)
+	{
+		if (cursors[i].reader->GetCache()->Contains(requested_frame))
+			best = (int)i;
+	}
+
+	// The cursor closest behind the frame (which can reach it by decoding forward)
+	int closest = -1;
+	long int closest_distance = 0;
+	for (size_t i = 0; i < cursors.size() && best < 0; i++)
+	{
+		if (!cursors[i].reader->CanWalkTo(requested_frame))
+			continue;
+
+		long int distance = requested_frame - cursors[i].reader->GetPosition();
+		if (closest < 0 || distance < closest_distance)
+		{
+			closest = (int)i;
+			closest_distance = distance;
+		}
+	}
+	if (best < 0)
+		best = closest;
+
+	// A cursor which hasn't decoded anything yet (i.e. the cursor opened by Open()), since it has nothing to lose
+	for (size_t i = 0; i < cursors.size() && best < 0; i++)
+	{
+		if (cursors[i].reader->GetPosition() == 0)
+			best = (int)i;
+	}
+
+	// Open another cursor for this region (if there is room for it)
+	if (best < 0 && (int)cursors.size() + opening_count < max_cursors)
+		return -1;
+
+	// Recycle the least recently used cursor (it seeks to the frame)
+	if (best < 0)
+	{
+		best = 0;
+		for (size_t i = 1; i < cursors.size(); i++)
+		{
+			if (cursors[i].last_used < cursors[best].last_used)
+				best = (int)i;
+		}
+	}
+
+	return best;
+}
+
+// Pick the cursor for a frame (and mark it as used)
+QSharedPointer<FFmpegReader> MultiCursorReader::GetCursor(long int requested_frame)
+{
+	{
+		std::lock_guard<std::mutex> lock(cursors_mutex);
+
+		if (!is_open)
+			throw ReaderClosed("The MultiCursorReader is closed.  Call Open() before calling this method.", path);
+
+		int best = PickCursor(requested_frame);
+		if (best >= 0)
+		{
+			cursors[best].last_used = use_counter++;
+			return cursors[best].reader;
+		}
+
+		// Keep the room of the new cursor, while it opens
+		opening_count++;
+	}
+
+	// Open the new cursor outside the lock (probing the file can take a while, and the other cursors keep working)
+	QSharedPointer<FFmpegReader> reader;
+	try
+	{
+		reader = OpenCursor();
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(cursors_mutex);
+		opening_count--;
+		throw;
+	}
+
+	std::lock_guard<std::mutex> lock(cursors_mutex);
+	opening_count--;
+
+	// Closed while the cursor was opening
+	if (!is_open)
+	{
+		reader->Close();
+		throw ReaderClosed("The MultiCursorReader is closed.  Call Open() before calling this method.", path);
+	}
+
+	Cursor cursor = { reader, use_counter++ };
+	cursors.push_back(cursor);
+	return reader;
+}
+
+// Get a shared pointer to a Frame object for a specific frame number
+QSharedPointer<Frame> MultiCursorReader::GetFrame(long int requested_frame)
+{
+	return GetFrame(requested_frame, REQUEST_PLAYHEAD);
+}
+
+// Get a shared pointer to a Frame object, with a priority class and a deadline
+QSharedPointer<Frame> MultiCursorReader::GetFrame(long int requested_frame, RequestPriority priority, RequestScheduler::Clock::time_point deadline)
+{
+	// The cursor is decoded outside the lock (each cursor is thread-safe), so other cursors can work in parallel
+	QSharedPointer<FFmpegReader> cursor = GetCursor(requested_frame);
+
+	return cursor->GetFrame(requested_frame, priority, deadline);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 20:10
+#vNext
+=============================================================
+*/
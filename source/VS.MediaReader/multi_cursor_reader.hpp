@@ -0,0 +1,135 @@
+#ifndef GUARD_multi_cursor_reader_20261018201020_
+#define GUARD_multi_cursor_reader_20261018201020_
+/*
+@file		multi_cursor_reader.hpp
+@author		Webstar
+@date		2026-10-18 20:10
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <mutex>
+#include <string>
+#include <vector>
+
+// QT
+#include <QSharedPointer>
+#include <QtCore/QString>
+
+#include "reader.hpp"
+
+namespace vs
+{
+	/// @brief This class reads a file with several independent decoders (cursors), each positioned in a different region
+	/// @remark An FFmpegReader has a single demuxer and decoder, so alternating between two distant regions of a file
+	/// (A/B compare, ping-pong loops, multicam cuts) seeks on every jump, and throws away the decoder state. This reader
+	/// keeps up to K cursors (each one an FFmpegReader on the same file). A request goes to the cursor which already
+	/// has the frame cached, or to the cursor that can reach it by decoding forward the soonest. When no cursor is
+	/// close, a cursor which hasn't decoded anything yet seeks to the frame, then a new cursor is opened (up to K),
+	/// and then the least recently used cursor seeks to the frame. Jumping back and forth between K regions then costs
+	/// the same as sequential decoding.
+	/// @code
+	/// MultiCursorReader r("video.mp4", 2);
+	/// r.Open();										// opens cursor 1
+	/// QSharedPointer<Frame> a = r.GetFrame(100);		// cursor 1 (it hasn't decoded anything yet)
+	/// QSharedPointer<Frame> b = r.GetFrame(5000);		// opens cursor 2
+	/// QSharedPointer<Frame> a2 = r.GetFrame(101);		// cursor 1 again (no seek)
+	/// @endcode
+	class MultiCursorReader
+	{
+	private:
+		/// A decoder positioned somewhere in the file
+		struct Cursor
+		{
+			QSharedPointer<FFmpegReader> reader;
+			unsigned long long last_used;		///< When the cursor was last used (a counter, for LRU)
+		};
+
+		std::mutex cursors_mutex;
+
+		string path;
+		int max_cursors;
+		bool is_open;
+		unsigned long long use_counter;
+		std::vector<Cursor> cursors;
+		int opening_count;						///< The cursors being opened (outside the lock), which count against max_cursors
+
+		/// Pick the cursor for a frame (and mark it as used), opening a new cursor outside the lock if needed
+		QSharedPointer<FFmpegReader> GetCursor(long int requested_frame);
+
+		/// Pick an open cursor for a frame (-1 if a new cursor should be opened for it)
+		int PickCursor(long int requested_frame);
+
+		/// Create and open a new cursor
+		QSharedPointer<FFmpegReader> OpenCursor();
+
+	public:
+		/// @brief Constructor
+		/// @param max_cursors The maximum number of cursors (independent decoders) to keep open
+		MultiCursorReader(string path, int max_cursors = 2);
+
+		/// Constructor
+		MultiCursorReader(QString path, int max_cursors = 2);
+
+		/// Destructor
+		~MultiCursorReader();
+
+		/// @name Settings of the cursors
+		/// @remark Each cursor is opened with these settings (see the members of FFmpegReader with the same names, and
+		/// their defaults). Set them before Open(): the cursors opened later use the values of that time.
+		/// @{
+		bool enable_seek;
+		bool enable_frame_dedup;
+		bool enable_yuv_converter;
+		bool enable_prefetch;
+		long long int max_pinned_bytes;
+		int64_t probe_size;
+		int64_t analyze_duration;
+		bool enable_video;
+		bool enable_audio;
+		bool low_latency_open;
+		MediaInfoCache *info_cache;
+		int scrub_refine_delay;
+		/// @}
+
+		/// returns details of the media file.
+		MediaInfo info;
+
+		/// Open File (the first cursor is opened right away, the others on demand)
+		void Open();
+
+		/// Close File (and every cursor)
+		void Close();
+
+		/// Determine if reader is open or closed
+		bool IsOpen() { return is_open; }
+
+		/// Get the number of open cursors
+		int GetCursorCount();
+
+		/// Get the number of video frames decoded by the open cursors (see FFmpegReader::GetDecodedVideoFrames)
+		long long int GetDecodedVideoFrames();
+
+		/// @brief Get a shared pointer to a Frame object for a specific frame number (see FFmpegReader::GetFrame)
+		/// @param requested_frame	The frame number that is requested.
+		QSharedPointer<Frame> GetFrame(long int requested_frame);
+
+		/// @brief Get a shared pointer to a Frame object, with a priority class and a deadline (see FFmpegReader::GetFrame)
+		QSharedPointer<Frame> GetFrame(long int requested_frame, RequestPriority priority, RequestScheduler::Clock::time_point deadline = RequestScheduler::NoDeadline());
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 20:10
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,125 @@
+/*
+@file		pixel_operations.cpp
+@author		Webstar
+@date		2026-10-18 14:15
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VS_PIXEL_OPERATIONS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include "pixel_operations.hpp"
+
+using namespace std;
+using namespace vs;
+
+namespace vs
+{
+	namespace helpers
+	{
+		const uint64_t hash_prime = 0x9E3779B97F4A7C15ULL;
+
+		/// Mix a 64-bit word into a hash lane
+		inline uint64_t HashWord(uint64_t lane, uint64_t word)
+		{
+			lane ^= word;
+			lane *= hash_prime;
+			return lane ^ (lane >> 29);
+		}
+
+		/// Read 8 bytes (which can be unaligned)
+		inline uint64_t ReadWord(const unsigned char* data)
+		{
+			uint64_t word;
+			memcpy(&word, data, sizeof(word));
+			return word;
+		}
+	}
+}
+
+// Calculates a fast 64-bit hash of an image
+uint64_t PixelOperations::Hash(const unsigned char* pixels, int line_bytes, int height, int bytes_per_line)
+{
+	// Four independent lanes, so the multiplies of consecutive words don't wait on each other
+	uint64_t lanes[4] = { helpers::hash_prime, helpers::hash_prime << 1, helpers::hash_prime << 2, helpers::hash_prime << 3 };
+
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* line = pixels + (size_t)y * bytes_per_line;
+		int x = 0;
+
+		for (; x + 32 <= line_bytes; x += 32)
+		{
+			lanes[0] = helpers::HashWord(lanes[0], helpers::ReadWord(line + x));
+			lanes[1] = helpers::HashWord(lanes[1], helpers::ReadWord(line + x + 8));
+			lanes[2] = helpers::HashWord(lanes[2], helpers::ReadWord(line + x + 16));
+			lanes[3] = helpers::HashWord(lanes[3], helpers::ReadWord(line + x + 24));
+		}
+
+		// Remaining bytes of the line
+		for (; x < line_bytes; ++x)
+			lanes[0] = helpers::HashWord(lanes[0], line[x]);
+	}
+
+	uint64_t hash = helpers::HashWord(lanes[0], lanes[1]);
+	hash = helpers::HashWord(hash, lanes[2]);
+	hash = helpers::HashWord(hash, lanes[3]);
+	return helpers::HashWord(hash, ((uint64_t)line_bytes << 32) | (uint32_t)height);
+}
+
+// Compares the pixels of two images
+bool PixelOperations::Equal(const unsigned char* pixels1, int bytes_per_line1, const unsigned char* pixels2, int bytes_per_line2, int line_bytes, int height)
+{
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* line1 = pixels1 + (size_t)y * bytes_per_line1;
+		const unsigned char* line2 = pixels2 + (size_t)y * bytes_per_line2;
+		int x = 0;
+
+#if VS_PIXEL_OPERATIONS_SSE2
+		// Compare 64 bytes at a time (any difference leaves a zero bit in the mask)
+		for (; x + 64 <= line_bytes; x += 64)
+		{
+			__m128i eq0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(line1 + x)), _mm_loadu_si128((const __m128i*)(line2 + x)));
+			__m128i eq1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(line1 + x + 16)), _mm_loadu_si128((const __m128i*)(line2 + x + 16)));
+			__m128i eq2 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(line1 + x + 32)), _mm_loadu_si128((const __m128i*)(line2 + x + 32)));
+			__m128i eq3 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(line1 + x + 48)), _mm_loadu_si128((const __m128i*)(line2 + x + 48)));
+
+			__m128i eq = _mm_and_si128(_mm_and_si128(eq0, eq1), _mm_and_si128(eq2, eq3));
+			if (_mm_movemask_epi8(eq) != 0xFFFF)
+				return false;
+		}
+
+		for (; x + 16 <= line_bytes; x += 16)
+		{
+			__m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(line1 + x)), _mm_loadu_si128((const __m128i*)(line2 + x)));
+			if (_mm_movemask_epi8(eq) != 0xFFFF)
+				return false;
+		}
+#endif
+
+		// Remaining bytes of the line
+		if (x < line_bytes && memcmp(line1 + x, line2 + x, line_bytes - x) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 14:15
+#vNext
+=============================================================
+*/
@@ -0,0 +1,46 @@
+#ifndef GUARD_pixel_operations_20261018141520_
+#define GUARD_pixel_operations_20261018141520_
+/*
+@file		pixel_operations.hpp
+@author		Webstar
+@date		2026-10-18 14:15
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstdint>
+
+namespace vs
+{
+	/// @brief A collection of simple operations on images (i.e. planes of pixels with padded lines)
+	class PixelOperations
+	{
+	public:
+		/// @brief Calculates a fast 64-bit hash of an image
+		/// @remark The hash is not cryptographic, so equal hashes need to be confirmed with Equal().
+		/// @param pixels The first line of the image
+		/// @param line_bytes The number of bytes of pixel data in each line (the padding is ignored)
+		/// @param height The number of lines
+		/// @param bytes_per_line The stride between lines
+		static uint64_t Hash(const unsigned char* pixels, int line_bytes, int height, int bytes_per_line);
+
+		/// @brief Compares the pixels of two images (using SSE2 when available)
+		/// @param line_bytes The number of bytes of pixel data in each line (the padding is ignored)
+		static bool Equal(const unsigned char* pixels1, int bytes_per_line1, const unsigned char* pixels2, int bytes_per_line2, int line_bytes, int height);
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 14:15
+#vNext
+=============================================================
+*/
+
+#endif
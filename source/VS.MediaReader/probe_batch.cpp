@@ -0,0 +1,117 @@
+/*
+@file		probe_batch.cpp
+@author		Webstar
+@date		2026-10-18 22:45
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+#include "probe_batch.hpp"
+#include "reader.hpp"
+
+using namespace std;
+using namespace vs;
+
+// Constructor
+ProbeBatch::ProbeBatch(int max_threads)
+	: max_threads(max(max_threads, 1)), running(0), generation(0), pending(0)
+{
+}
+
+// Destructor
+ProbeBatch::~ProbeBatch()
+{
+	Cancel();
+	Wait();
+}
+
+void ProbeBatch::Probe(const vector<string> &paths, Callback callback, int64_t probe_size, int64_t analyze_duration)
+{
+	lock_guard<mutex> lock(pending_mutex);
+
+	for (const string &path : paths)
+	{
+		Job job = { path, callback, probe_size, analyze_duration, generation };
+		jobs.push_back(job);
+		pending++;
+	}
+
+	// Start a task per file, up to max_threads (each one probes files until the queue is empty)
+	while (running < max_threads && running < (int)jobs.size())
+	{
+		running++;
+		ThreadPool::Global().Submit([this] { RunJobs(); });
+	}
+}
+
+void ProbeBatch::RunJobs()
+{
+	unique_lock<mutex> lock(pending_mutex);
+
+	while (!jobs.empty())
+	{
+		Job job = jobs.front();
+		jobs.pop_front();
+
+		lock.unlock();
+		ProbeFile(job);
+		lock.lock();
+
+		pending--;
+	}
+
+	// Wake Wait() (under the lock, so the notification can't slip in between its check and its wait)
+	running--;
+	pending_changed.notify_all();
+}
+
+void ProbeBatch::ProbeFile(const Job &job)
+{
+	// Skip the files queued before Cancel()
+	if (job.generation != generation)
+		return;
+
+	ProbeResult result;
+	result.path = job.path;
+	result.is_valid = false;
+
+	try
+	{
+		result.info = FFmpegReader::Probe(job.path, job.probe_size, job.analyze_duration);
+		result.is_valid = true;
+	}
+	catch (const exception &e)
+	{
+		result.error = e.what();
+	}
+	catch (...)
+	{
+		result.error = "File could not be probed.";
+	}
+
+	if (job.generation == generation && job.callback)
+		job.callback(result);
+}
+
+void ProbeBatch::Wait()
+{
+	unique_lock<mutex> lock(pending_mutex);
+	pending_changed.wait(lock, [this] { return pending == 0 && running == 0; });
+}
+
+void ProbeBatch::Cancel()
+{
+	generation++;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 22:45
+#vNext
+=============================================================
+*/
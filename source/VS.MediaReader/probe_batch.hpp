@@ -0,0 +1,115 @@
+#ifndef GUARD_probe_batch_20261018224510_
+#define GUARD_probe_batch_20261018224510_
+/*
+@file		probe_batch.hpp
+@author		Webstar
+@date		2026-10-18 22:45
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "thread_pool.hpp"
+
+namespace vs
+{
+	/// The outcome of probing a file
+	struct ProbeResult
+	{
+		std::string path;				///< The path of the file
+		MediaInfo info;					///< The info of the file (only valid if is_valid is true)
+		bool is_valid;					///< False if the file could not be probed
+		std::string error;				///< The reason the file could not be probed
+	};
+
+	/// @brief This class probes a list of files (see FFmpegReader::Probe) on ThreadPool::Global(), a few files at a time
+	/// @remark The callback is called on the worker threads, as each file is probed (so in no particular order).
+	/// At most max_threads workers of the pool probe the files of a batch, so a large batch doesn't take every worker
+	/// from the conversions of the readers.
+	/// @code
+	/// ProbeBatch batch(4);
+	/// batch.Probe(paths, [&](const ProbeResult &result) { /* ... add the result to the browser ... */ });
+	/// batch.Wait();
+	/// @endcode
+	class ProbeBatch
+	{
+	public:
+		typedef std::function<void(const ProbeResult&)> Callback;
+
+	private:
+		/// A file queued to probe
+		struct Job
+		{
+			std::string path;
+			Callback callback;
+			int64_t probe_size;
+			int64_t analyze_duration;
+			int generation;					///< The generation it was queued in (skipped once cancelled)
+		};
+
+		int max_threads;
+		std::deque<Job> jobs;				///< The files not probed yet (guarded by pending_mutex)
+		int running;						///< The tasks probing the files, on the pool (guarded by pending_mutex)
+		std::atomic<int> generation;		///< Incremented by Cancel() (the files queued before it are skipped)
+		std::atomic<int> pending;
+		std::mutex pending_mutex;
+		std::condition_variable pending_changed;
+
+		ProbeBatch(const ProbeBatch&);
+		ProbeBatch& operator=(const ProbeBatch&);
+
+		/// Probe the queued files, until there are none left
+		void RunJobs();
+
+		/// Probe a file, and report it (unless the batch was cancelled)
+		void ProbeFile(const Job &job);
+
+	public:
+		/// @brief Constructor
+		/// @param max_threads The most files probed at the same time
+		ProbeBatch(int max_threads = 4);
+
+		/// Destructor (cancels the files not probed yet, and waits for the others)
+		~ProbeBatch();
+
+		/// @brief Queue files to probe
+		/// @param paths	The paths of the files
+		/// @param callback	Called with the result of each file (on a worker thread)
+		/// @param probe_size	The most bytes read to probe the streams (0 uses the default of FFmpeg)
+		/// @param analyze_duration	The longest duration analyzed to probe the streams, in microseconds (0 uses the default of FFmpeg)
+		void Probe(const std::vector<std::string> &paths, Callback callback, int64_t probe_size = 0, int64_t analyze_duration = 0);
+
+		/// Wait for every queued file to be probed (or skipped, if cancelled), and for the tasks of the batch to finish
+		void Wait();
+
+		/// @brief Skip the files not probed yet (the files being probed still finish, but aren't reported)
+		/// @remark Files queued after Cancel() are probed again.
+		void Cancel();
+
+		/// Get the number of files queued, or being probed
+		int GetPendingCount() { return pending; }
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 22:45
+#vNext
+=============================================================
+*/
+
+#endif
@@ -10,6 +10,8 @@
 // STD
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
 
 // QT
 #include <QDebug>
@@ -35,44 +37,328 @@ bool AudioLocation::is_near(AudioLocation location, int samples_per_frame, long
 		return false;
 }
 
+namespace vs
+{
+	namespace helpers
+	{
+		/// Copy the parameters of a stream (as probed by avformat_find_stream_info, every field of its AVCodecParameters)
+		inline void StoreStreamParameters(AVStream *stream, StreamParameters &parameters)
+		{
+			const AVCodecParameters *codecpar = stream->codecpar;
+
+			parameters.index = stream->index;
+			parameters.codec_type = codecpar->codec_type;
+			parameters.codec_id = codecpar->codec_id;
+			parameters.codec_tag = codecpar->codec_tag;
+			parameters.bit_rate = codecpar->bit_rate;
+			parameters.format = codecpar->format;
+			parameters.bits_per_coded_sample = codecpar->bits_per_coded_sample;
+			parameters.bits_per_raw_sample = codecpar->bits_per_raw_sample;
+			parameters.profile = codecpar->profile;
+			parameters.level = codecpar->level;
+			parameters.width = codecpar->width;
+			parameters.height = codecpar->height;
+			parameters.sample_aspect_ratio = Fraction(codecpar->sample_aspect_ratio.num, codecpar->sample_aspect_ratio.den);
+			parameters.field_order = codecpar->field_order;
+			parameters.color_range = codecpar->color_range;
+			parameters.color_primaries = codecpar->color_primaries;
+			parameters.color_trc = codecpar->color_trc;
+			parameters.color_space = codecpar->color_space;
+			parameters.chroma_location = codecpar->chroma_location;
+			parameters.video_delay = codecpar->video_delay;
+			parameters.channel_layout = codecpar->channel_layout;
+			parameters.channels = codecpar->channels;
+			parameters.sample_rate = codecpar->sample_rate;
+			parameters.block_align = codecpar->block_align;
+			parameters.frame_size = codecpar->frame_size;
+			parameters.initial_padding = codecpar->initial_padding;
+			parameters.trailing_padding = codecpar->trailing_padding;
+			parameters.seek_preroll = codecpar->seek_preroll;
+			parameters.extradata = QByteArray((const char*)codecpar->extradata, codecpar->extradata ? codecpar->extradata_size : 0);
+			parameters.time_base = Fraction(stream->time_base.num, stream->time_base.den);
+			parameters.avg_frame_rate = Fraction(stream->avg_frame_rate.num, stream->avg_frame_rate.den);
+			parameters.r_frame_rate = Fraction(stream->r_frame_rate.num, stream->r_frame_rate.den);
+			parameters.start_time = stream->start_time;
+			parameters.duration = stream->duration;
+		}
+
+		/// Check if a stream (as read from the header) is the stream of a snapshot
+		inline bool MatchStreamParameters(AVStream *stream, const StreamParameters &parameters)
+		{
+			return stream->codecpar->codec_type == parameters.codec_type && stream->codecpar->codec_id == parameters.codec_id &&
+				stream->time_base.num == parameters.time_base.num && stream->time_base.den == parameters.time_base.den;
+		}
+
+		/// Set the parameters of a stream from a snapshot (instead of probing them)
+		inline void RestoreStreamParameters(AVStream *stream, const StreamParameters &parameters)
+		{
+			AVCodecParameters *codecpar = stream->codecpar;
+
+			codecpar->codec_tag = parameters.codec_tag;
+			codecpar->bit_rate = parameters.bit_rate;
+			codecpar->format = parameters.format;
+			codecpar->bits_per_coded_sample = parameters.bits_per_coded_sample;
+			codecpar->bits_per_raw_sample = parameters.bits_per_raw_sample;
+			codecpar->profile = parameters.profile;
+			codecpar->level = parameters.level;
+			codecpar->width = parameters.width;
+			codecpar->height = parameters.height;
+			codecpar->sample_aspect_ratio = av_make_q(parameters.sample_aspect_ratio.num, parameters.sample_aspect_ratio.den);
+			codecpar->field_order = (AVFieldOrder)parameters.field_order;
+			codecpar->color_range = (AVColorRange)parameters.color_range;
+			codecpar->color_primaries = (AVColorPrimaries)parameters.color_primaries;
+			codecpar->color_trc = (AVColorTransferCharacteristic)parameters.color_trc;
+			codecpar->color_space = (AVColorSpace)parameters.color_space;
+			codecpar->chroma_location = (AVChromaLocation)parameters.chroma_location;
+			codecpar->video_delay = parameters.video_delay;
+			codecpar->channel_layout = parameters.channel_layout;
+			codecpar->channels = parameters.channels;
+			codecpar->sample_rate = parameters.sample_rate;
+			codecpar->block_align = parameters.block_align;
+			codecpar->frame_size = parameters.frame_size;
+			codecpar->initial_padding = parameters.initial_padding;
+			codecpar->trailing_padding = parameters.trailing_padding;
+			codecpar->seek_preroll = parameters.seek_preroll;
+
+			// The decoder reads past the end of the extradata, so it is padded
+			av_freep(&codecpar->extradata);
+			codecpar->extradata_size = 0;
+			if (!parameters.extradata.isEmpty())
+			{
+				codecpar->extradata = (uint8_t*)av_mallocz(parameters.extradata.size() + AV_INPUT_BUFFER_PADDING_SIZE);
+				if (codecpar->extradata)
+				{
+					memcpy(codecpar->extradata, parameters.extradata.constData(), parameters.extradata.size());
+					codecpar->extradata_size = parameters.extradata.size();
+				}
+			}
+
+			stream->sample_aspect_ratio = codecpar->sample_aspect_ratio;
+			stream->avg_frame_rate = av_make_q(parameters.avg_frame_rate.num, parameters.avg_frame_rate.den);
+			stream->r_frame_rate = av_make_q(parameters.r_frame_rate.num, parameters.r_frame_rate.den);
+			stream->start_time = parameters.start_time;
+			stream->duration = parameters.duration;
+		}
+
+		/// Set the info to a file without streams
+		inline void ResetInfo(MediaInfo &info)
+		{
+			info.has_video = false;
+			info.has_audio = false;
+			info.has_single_image = false;
+			info.duration = 0.0;
+			info.file_size = 0;
+			info.height = 0;
+			info.width = 0;
+			info.pixel_format = -1;
+			info.fps = Fraction();
+			info.video_bit_rate = 0;
+			info.pixel_ratio = Fraction();
+			info.display_ratio = Fraction();
+			info.vcodec = "";
+			info.acodec = "";
+			info.video_length = 0;
+			info.video_stream_index = -1;
+			info.video_timebase = Fraction();
+			info.interlaced_frame = false;
+			info.top_field_first = true;
+			info.acodec = "";
+			info.audio_bit_rate = 0;
+			info.sample_rate = 0;
+			info.channels = 0;
+			info.channel_layout = LAYOUT_MONO;
+			info.audio_stream_index = -1;
+			info.audio_timebase = Fraction();
+		}
+
+		/// Find the first video, audio and subtitle streams of a file (-1 if there is none)
+		inline void FindStreams(AVFormatContext *format_context, int &video_stream, int &audio_stream, int &subtitle_stream)
+		{
+			video_stream = -1;
+			audio_stream = -1;
+			subtitle_stream = -1;
+
+			// Loop through each stream, and identify the video and audio stream index
+			for (unsigned int i = 0; i < format_context->nb_streams; i++)
+			{
+				// Is this a video stream?
+				if (format_context->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO && video_stream < 0) {
+					video_stream = i;
+				}
+				// Is this an audio stream?
+				if (format_context->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_AUDIO && audio_stream < 0) {
+					audio_stream = i;
+				}
+				if (format_context->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_SUBTITLE && subtitle_stream < 0) {
+					subtitle_stream = i;
+				}
+			}
+		}
+
+		/// Fill the info with the details of a video stream (returns true if its duration is known)
+		inline bool FillVideoInfo(MediaInfo &info, AVFormatContext *format_context, AVStream *stream, const char *codec_name, bool check_fps)
+		{
+			const AVCodecParameters *codecpar = stream->codecpar;
+			bool is_duration_known = false;
+
+			// Set values of FileInfo struct
+			info.has_video = true;
+			info.file_size = format_context->pb ? avio_size(format_context->pb) : -1;
+			info.height = codecpar->height;
+			info.width = codecpar->width;
+			info.vcodec = codec_name;
+			info.video_bit_rate = format_context->bit_rate;
+			if (!check_fps)
+			{
+				// set frames per second (fps)
+				info.fps.num = stream->avg_frame_rate.num;
+				info.fps.den = stream->avg_frame_rate.den;
+			}
+
+			if (stream->sample_aspect_ratio.num != 0)
+			{
+				info.pixel_ratio.num = stream->sample_aspect_ratio.num;
+				info.pixel_ratio.den = stream->sample_aspect_ratio.den;
+			}
+			else if (codecpar->sample_aspect_ratio.num != 0)
+			{
+				info.pixel_ratio.num = codecpar->sample_aspect_ratio.num;
+				info.pixel_ratio.den = codecpar->sample_aspect_ratio.den;
+			}
+			else
+			{
+				info.pixel_ratio.num = 1;
+				info.pixel_ratio.den = 1;
+			}
+
+			info.pixel_format = codecpar->format;
+
+			// Calculate the DAR (display aspect ratio)
+			Fraction size(info.width * info.pixel_ratio.num, info.height * info.pixel_ratio.den);
+
+			// Reduce size fraction
+			size.Reduce();
+
+			// Set the ratio based on the reduced fraction
+			info.display_ratio.num = size.num;
+			info.display_ratio.den = size.den;
+
+			// Set the video timebase
+			info.video_timebase.num = stream->time_base.num;
+			info.video_timebase.den = stream->time_base.den;
+
+			// Set the duration in seconds, and video length (# of frames)
+			info.duration = stream->duration * info.video_timebase.ToDouble();
+
+			// Check for valid duration (if found)
+			if (info.duration <= 0.0f && format_context->duration >= 0)
+				// Use the format's duration
+				info.duration = format_context->duration / AV_TIME_BASE;
+
+			// Calculate duration from filesize and bitrate (if any)
+			if (info.duration <= 0.0f && info.video_bit_rate > 0 && info.file_size > 0)
+				// Estimate from bitrate, total bytes, and framerate
+				info.duration = (info.file_size / info.video_bit_rate);
+
+			// No duration found in stream of file
+			if (info.duration <= 0.0f)
+			{
+				// No duration is found in the video stream
+				info.duration = -1;
+				info.video_length = -1;
+			}
+			else
+			{
+				// Yes, a duration was found
+				is_duration_known = true;
+
+				// Calculate number of frames
+				info.video_length = round(info.duration * info.fps.ToDouble());
+			}
+
+			// Override an invalid framerate
+			if (info.fps.ToFloat() > 120.0f || (info.fps.num == 0 || info.fps.den == 0))
+			{
+				// Set a few important default video settings (so audio can be divided into frames)
+				info.fps.num = 24;
+				info.fps.den = 1;
+				info.video_timebase.num = 1;
+				info.video_timebase.den = 24;
+
+				// Calculate number of frames
+				info.video_length = round(info.duration * info.fps.ToDouble());
+			}
+
+			return is_duration_known;
+		}
+
+		/// Fill the info with the details of an audio stream (after the video stream, if any)
+		inline void FillAudioInfo(MediaInfo &info, AVFormatContext *format_context, AVStream *stream, const char *codec_name)
+		{
+			const AVCodecParameters *codecpar = stream->codecpar;
+
+			// Set values of FileInfo struct
+			info.has_audio = true;
+			info.file_size = format_context->pb ? avio_size(format_context->pb) : -1;
+			info.acodec = codec_name;
+			info.channels = codecpar->channels;
+			info.channel_layout = (ChannelLayout)(codecpar->channel_layout ? codecpar->channel_layout : av_get_default_channel_layout(codecpar->channels));
+			info.sample_rate = codecpar->sample_rate;
+			info.audio_bit_rate = codecpar->bit_rate;
+
+			// Set audio timebase
+			info.audio_timebase.num = stream->time_base.num;
+			info.audio_timebase.den = stream->time_base.den;
+
+			// Get timebase of audio stream (if valid) and greater than the current duration
+			if (stream->duration > 0.0f && stream->duration > info.duration)
+				info.duration = stream->duration * info.audio_timebase.ToDouble();
+
+			// Check for an invalid video length
+			if (info.has_video && info.video_length <= 0)
+			{
+				// Calculate the video length from the audio duration
+				info.video_length = info.duration * info.fps.ToDouble();
+			}
+
+			// Set video timebase (if no video stream was found)
+			if (!info.has_video)
+			{
+				// Set a few important default video settings (so audio can be divided into frames)
+				info.fps.num = 24;
+				info.fps.den = 1;
+				info.video_timebase.num = 1;
+				info.video_timebase.den = 24;
+				info.video_length = info.duration * info.fps.ToDouble();
+				info.width = 720;
+				info.height = 480;
+
+			}
+		}
+	}
+}
+
 // Public
 
 FFmpegReader::FFmpegReader(string filename)
 	: path(filename),
 	max_width(0), max_height(0), last_frame(0), is_seeking(0), seeking_pts(0), seeking_frame(0), seek_count(0),
-	largest_frame_processed(0), current_video_frame(0), seek_audio_frame_found(0), seek_video_frame_found(0),
+	largest_frame_processed(0), current_video_frame(0), decoded_video_frames(0), seek_audio_frame_found(0), seek_video_frame_found(0),
 	audio_pts_offset(99999), video_pts_offset(99999), 
-	is_video_seek(true), check_interlace(false),check_fps(false), enable_seek(true), is_open(false), is_duration_known(false), has_missing_frames(false),
-	packet(NULL), 
-	picture_type(0)
+	is_video_seek(true), check_interlace(false),check_fps(false), enable_seek(true), enable_frame_dedup(false), enable_yuv_converter(false), enable_prefetch(true), max_pinned_bytes(512LL * 1024 * 1024), enable_video(true), enable_audio(true), low_latency_open(false), scrub_refine_delay(100), probe_size(0), analyze_duration(0), info_cache(&MediaInfoCache::Global()), is_open(false), is_duration_known(false), has_missing_frames(false),
+	packet(NULL), pFrame(NULL),
+	picture_type(0),
+	aFrame(NULL), img_convert_ctx(NULL), avr(NULL), avr_sample_fmt(-1), avr_channel_layout(0),
+	audio_converted_linesize(0), audio_converted_capacity(0), last_video_hash(0),
+	next_flight_id(0), video_decoder_threads(0), video_decoder_workload(0), is_decoder_upgrade_pending(false), video_decoder_delay(0), is_conversion_pending(false), is_audio_deferred(false), is_audio_requested(false), is_prefetching(false), cancel_prefetch(false), stop_prefetch_worker(false), prefetch_token(NULL), refine_token(NULL),
+	scrub_generation(0), scrub_refined(0), scrub_target(0), is_refining(false), cancel_refine(false), stop_refine_worker(false),
+	pixel_pool(new PixelBufferPool(0, 16)), audio_pool(new PixelBufferPool(0, 32))
 {
 	// Initialize info struct
-	info.has_video = false;
-	info.has_audio = false;
-	info.has_single_image = false;
-	info.duration = 0.0;
-	info.file_size = 0;
-	info.height = 0;
-	info.width = 0;
-	info.pixel_format = -1;
-	info.fps = Fraction();
-	info.video_bit_rate = 0;
-	info.pixel_ratio = Fraction();
-	info.display_ratio = Fraction();
-	info.vcodec = "";
-	info.acodec = "";
-	info.video_length = 0;
-	info.video_stream_index = -1;
-	info.video_timebase = Fraction();
-	info.interlaced_frame = false;
-	info.top_field_first = true;
-	info.acodec = "";
-	info.audio_bit_rate = 0;
-	info.sample_rate = 0;
-	info.channels = 0;
-	info.channel_layout = LAYOUT_MONO;
-	info.audio_stream_index = -1;
-	info.audio_timebase = Fraction();
+	helpers::ResetInfo(info);
+
+	for (int i = 0; i < AV_NUM_DATA_POINTERS; i++)
+		audio_converted_data[i] = NULL;
 
 	// Initialize FFMpeg, and register all formats and codecs
 	av_register_all();
@@ -87,64 +373,204 @@ FFmpegReader::FFmpegReader(QString filename)
 
 FFmpegReader::~FFmpegReader()
 {
-	if (is_open)
+	// Wait for the prefetch and refinement tasks (they use this reader)
+	CancelPrefetch();
+	CancelScrubRefinement();
+
+	// End the prefetch and refinement threads
 	{
-		// Auto close reader if not already done
-		Close();
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		stop_prefetch_worker = true;
+		prefetch_wake.notify_all();
 	}
-}
+	if (prefetch_worker.joinable())
+		prefetch_worker.join();
 
-void FFmpegReader::Open()
-{
-	if (is_open)
 	{
-		return;
+		std::lock_guard<std::mutex> lock(scrub_mutex);
+		stop_refine_worker = true;
+		scrub_changed.notify_all();
 	}
+	if (refine_worker.joinable())
+		refine_worker.join();
 
-	if (path.empty())
+	if (is_open)
 	{
-		throw InvalidFile("File could not be opened.", path);
+		// Auto close reader if not already done
+		Close();
 	}
 
-	unsigned int num_threads = std::thread::hardware_concurrency();
+	// Give back the decoder threads (if Open failed after taking them)
+	ReleaseDecoderThreads();
+}
 
+// Open the file, and find its video and audio streams (returns true if the streams come from the snapshot of the file)
+bool FFmpegReader::OpenInput(MediaInfoSnapshot &snapshot)
+{
 	// Initialize format context
 	pFormatCtx = NULL;
 
 	int result = 0;
 
+	// Limit the probing (if set)
+	AVDictionary *options = NULL;
+	if (probe_size > 0)
+		av_dict_set_int(&options, "probesize", probe_size, 0);
+	if (analyze_duration > 0)
+		av_dict_set_int(&options, "analyzeduration", analyze_duration, 0);
+
 	// Open video file
-	result = avformat_open_input(&pFormatCtx, path.c_str(), NULL, NULL);
+	result = avformat_open_input(&pFormatCtx, path.c_str(), NULL, &options);
+	av_dict_free(&options);
 	if (result < 0)
 		throw InvalidFile("File could not be opened.", path);
 
+	// Use the snapshot of an earlier Open() of this file (if it still matches the file), instead of probing it again
+	bool is_snapshot = false;
+	info_key = info_cache ? MediaInfoCache::GetFileKey(path) : QString();
+	if (!info_key.isEmpty() && info_cache->Find(info_key, snapshot))
+		is_snapshot = RestoreSnapshot(snapshot);
+
 	// Retrieve stream information
-	result = avformat_find_stream_info(pFormatCtx, NULL);
+	if (!is_snapshot)
+	{
+		result = avformat_find_stream_info(pFormatCtx, NULL);
+		if (result < 0)
+			throw NoStreamsFound("No streams found in file.", path);
+	}
+
+	helpers::FindStreams(pFormatCtx, videoStream, audioStream, subtitleStream);
+
+	if (videoStream == -1 && audioStream == -1)
+		throw NoStreamsFound("No video or audio streams found in this file.", path);
+
+	return is_snapshot;
+}
+
+MediaInfo FFmpegReader::Probe(const string &path, int64_t probe_size, int64_t analyze_duration)
+{
+	// The snapshot of an earlier Open() of the file has the info already
+	QString key = MediaInfoCache::GetFileKey(path);
+	MediaInfoSnapshot snapshot;
+	if (!key.isEmpty() && MediaInfoCache::Global().Find(key, snapshot))
+		return snapshot.info;
+
+	// Only the container is opened (a reader would also set up its caches, pools and threads)
+	av_register_all();
+	avcodec_register_all();
+
+	// Limit the probing (if set)
+	AVDictionary *options = NULL;
+	if (probe_size > 0)
+		av_dict_set_int(&options, "probesize", probe_size, 0);
+	if (analyze_duration > 0)
+		av_dict_set_int(&options, "analyzeduration", analyze_duration, 0);
+
+	AVFormatContext *format_context = NULL;
+	int result = avformat_open_input(&format_context, path.c_str(), NULL, &options);
+	av_dict_free(&options);
 	if (result < 0)
-		throw NoStreamsFound("No streams found in file.", path);
+		throw InvalidFile("File could not be opened.", path);
 
-	videoStream = -1;
-	audioStream = -1;
-	subtitleStream = -1;
+	MediaInfo info;
+	helpers::ResetInfo(info);
 
-	// Loop through each stream, and identify the video and audio stream index
-	for (unsigned int i = 0; i < pFormatCtx->nb_streams; i++)
+	try
 	{
-		// Is this a video stream?
-		if (pFormatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO && videoStream < 0) {
-			videoStream = i;
-		}
-		// Is this an audio stream?
-		if (pFormatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_AUDIO && audioStream < 0) {
-			audioStream = i;
+		if (avformat_find_stream_info(format_context, NULL) < 0)
+			throw NoStreamsFound("No streams found in file.", path);
+
+		int video_stream = -1;
+		int audio_stream = -1;
+		int subtitle_stream = -1;
+		helpers::FindStreams(format_context, video_stream, audio_stream, subtitle_stream);
+		if (video_stream == -1 && audio_stream == -1)
+			throw NoStreamsFound("No video or audio streams found in this file.", path);
+
+		// The codecs are only looked up (for their names), never opened
+		if (video_stream != -1)
+		{
+			AVStream *stream = format_context->streams[video_stream];
+			AVCodec *input_codec = avcodec_find_decoder(stream->codecpar->codec_id);
+			if (!input_codec)
+				throw InvalidCodec("A valid video codec could not be found for this file.", path);
+
+			info.video_stream_index = video_stream;
+			helpers::FillVideoInfo(info, format_context, stream, input_codec->name, false);
 		}
-		if (pFormatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_SUBTITLE && subtitleStream < 0) {
-			subtitleStream = i;
+
+		if (audio_stream != -1)
+		{
+			AVStream *stream = format_context->streams[audio_stream];
+			AVCodec *input_codec = avcodec_find_decoder(stream->codecpar->codec_id);
+			if (!input_codec)
+				throw InvalidCodec("A valid audio codec could not be found for this file.", path);
+
+			info.audio_stream_index = audio_stream;
+			helpers::FillAudioInfo(info, format_context, stream, input_codec->name);
 		}
 	}
+	catch (...)
+	{
+		avformat_close_input(&format_context);
+		throw;
+	}
 
-	if (videoStream == -1 && audioStream == -1)
-		throw NoStreamsFound("No video or audio streams found in this file.", path);
+	avformat_close_input(&format_context);
+
+	return info;
+}
+
+void FFmpegReader::Open()
+{
+	if (is_open)
+	{
+		return;
+	}
+
+	if (path.empty())
+	{
+		throw InvalidFile("File could not be opened.", path);
+	}
+
+	unsigned int num_threads = std::thread::hardware_concurrency();
+
+	// The requests on other threads read the info while it is filled in (i.e. when a seek reopens the file)
+	std::lock_guard<std::mutex> info_lock(info_mutex);
+
+	// Forget the streams of the last open (the enabled streams may have changed since)
+	info.has_video = false;
+	info.has_audio = false;
+	info.video_stream_index = -1;
+	info.audio_stream_index = -1;
+
+	// Open the file, and find its streams
+	MediaInfoSnapshot snapshot;
+	bool is_snapshot = OpenInput(snapshot);
+
+	// Drop the disabled streams (the demuxer skips their packets, and their codecs are never opened)
+	int disabled_video_stream = -1;
+	int disabled_audio_stream = -1;
+	if (!enable_video && videoStream != -1)
+	{
+		pFormatCtx->streams[videoStream]->discard = AVDISCARD_ALL;
+		disabled_video_stream = videoStream;
+		videoStream = -1;
+	}
+	if (!enable_audio && audioStream != -1)
+	{
+		pFormatCtx->streams[audioStream]->discard = AVDISCARD_ALL;
+		disabled_audio_stream = audioStream;
+		audioStream = -1;
+	}
+	if (disabled_video_stream != -1 || disabled_audio_stream != -1)
+	{
+		if (videoStream == -1 && audioStream == -1)
+			throw NoStreamsFound("No enabled video or audio streams found in this file.", path);
+
+		// The snapshot describes every stream of the file, so this reader doesn't store it
+		info_key = QString();
+	}
 
 	// Is there a video stream?
 	if (videoStream != -1)
@@ -164,20 +590,16 @@ void FFmpegReader::Open()
 		if (avcodec_parameters_to_context(pCodecCtx, pStream->codecpar) < 0)
 			throw InvalidCodec("A valid video codec could not be found for this file.", path);
 
-		// Set number of threads equal to number of processors + 1
-		pCodecCtx->thread_count = num_threads;
-
-		// Find the decoder for the video stream
-		AVCodec *pCodec = avcodec_find_decoder(pCodecCtx->codec_id);
-		if (pCodec == NULL) {
-			throw InvalidCodec("A valid video codec could not be found for this file.", path);
-		}
-		// Open video codec
-		if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0)
-			throw InvalidCodec("A video codec was found, but could not be opened.", path);
+		// Open video codec (a low latency open waits for the first video packet)
+		if (!low_latency_open)
+			OpenVideoCodec(false);
 
 		// Update the File Info struct with video details (if a video stream is found)
 		UpdateVideoInfo();
+
+		// Start the cost model of this file over (assume a 2 second GOP, until keyframes are known)
+		cost_model.Reset(2.0 * info.fps.ToDouble());
+		LoadKeyframeIndex();
 	}
 
 	// Is there an audio stream?
@@ -198,21 +620,43 @@ void FFmpegReader::Open()
 		if (avcodec_parameters_to_context(aCodecCtx, aStream->codecpar) < 0)
 			throw InvalidCodec("A valid audio codec could not be found for this file.", path);
 
-		// Set number of threads equal to number of processors + 1
-		aCodecCtx->thread_count = num_threads;
-
-		// Find the decoder for the audio stream
-		AVCodec *aCodec = avcodec_find_decoder(aCodecCtx->codec_id);
-		if (aCodec == NULL) {
-			throw InvalidCodec("A valid audio codec could not be found for this file.", path);
-		}
-		// Open audio codec
-		if (avcodec_open2(aCodecCtx, aCodec, NULL) < 0)
-			throw InvalidCodec("An audio codec was found, but could not be opened.", path);
+		// Open audio codec (a low latency open waits for the first audio packet which is needed)
+		if (!low_latency_open)
+			OpenAudioCodec();
 
 		// Update the File Info struct with audio details (if an audio stream is found)
 		UpdateAudioInfo();
+
+		// Divide the audio into the frames of the disabled video stream (so the frame numbers match the video)
+		if (disabled_video_stream != -1)
+		{
+			AVRational frame_rate = pFormatCtx->streams[disabled_video_stream]->avg_frame_rate;
+			if (frame_rate.num > 0 && frame_rate.den > 0 && av_q2d(frame_rate) <= 120.0)
+			{
+				info.fps = Fraction(frame_rate.num, frame_rate.den);
+				info.video_timebase = Fraction(frame_rate.den, frame_rate.num);
+				info.video_length = round(info.duration * info.fps.ToDouble());
+			}
+		}
+	}
+
+	if (is_snapshot)
+	{
+		// Use what was learned the first time (i.e. the duration, the interlacing, and the PTS offsets of the first packets)
+		// (the info of the snapshot covers every stream, so it doesn't apply to a reader with disabled streams)
+		if (disabled_video_stream == -1 && disabled_audio_stream == -1)
+		{
+			info = snapshot.info;
+			is_duration_known = snapshot.is_duration_known;
+			check_interlace = true;
+		}
+		if (info.has_video && snapshot.video_pts_offset != 99999)
+			video_pts_offset = snapshot.video_pts_offset;
+		if (info.has_audio && snapshot.audio_pts_offset != 99999)
+			audio_pts_offset = snapshot.audio_pts_offset;
 	}
+	else
+		StoreSnapshot();
 
 	// Is there an subtitle track
 	if (subtitleStream != -1)
@@ -220,14 +664,25 @@ void FFmpegReader::Open()
 		//TODO: implment subtitles
 	}
 
+	// A low latency open skips the audio of a video file until a request needs it (a file reopened by a seek keeps
+	// decoding the audio, once it was needed)
+	is_audio_deferred = low_latency_open && info.has_video && info.has_audio && !is_audio_requested;
+
 	// Init previous audio location to zero
 	previous_packet_location.frame = -1;
 	previous_packet_location.sample_start = 0;
 
+	// Allocate the packet, frames and scratch buffers reused by every packet
+	AllocateDecodeObjects();
+
 	// Adjust cache size based on size of frame and audio
 	working_cache.SetMaxBytesFromInfo(num_threads * 30, info.width, info.height, info.sample_rate, info.channels);
 	missing_frames.SetMaxBytesFromInfo(num_threads * 2, info.width, info.height, info.sample_rate, info.channels);
 	final_cache.SetMaxBytesFromInfo(num_threads * 2, info.width, info.height, info.sample_rate, info.channels);
+	final_cache.SetMaxPinnedBytes(max_pinned_bytes);
+
+	// Jumps of up to a few seconds are scrubbing, longer ones are random access
+	access_pattern.SetScrubDistance((long int)(5.0 * info.fps.ToDouble()));
 
 	// Mark as "open"
 	is_open = true;
@@ -235,19 +690,27 @@ void FFmpegReader::Open()
 
 void FFmpegReader::Close()
 {
+	// Stop prefetching and refining (unless one of these tasks is starting the file over)
+	CancelPrefetch();
+	CancelScrubRefinement();
+
 	// Close all objects, if reader is 'open'
 	if (is_open)
 	{
 		// Mark as "closed"
 		is_open = false;
 
-		// Close the codec
-		if (info.has_video)
+		// Close the codec (unless a low latency open never needed it)
+		if (info.has_video && avcodec_is_open(pCodecCtx))
 		{
 			avcodec_flush_buffers(pCodecCtx);
 			avcodec_close(pCodecCtx);
 		}
-		if (info.has_audio)
+		ReleaseDecoderThreads();
+		is_decoder_upgrade_pending = false;
+		video_decoder_delay = 0;
+		is_conversion_pending = false;
+		if (info.has_audio && avcodec_is_open(aCodecCtx))
 		{
 			avcodec_flush_buffers(aCodecCtx);
 			avcodec_close(aCodecCtx);
@@ -260,7 +723,7 @@ void FFmpegReader::Close()
 
 		// Clear processed lists
 		{
-			//std::lock_guard<std::mutex> lock(processing_mutex);
+			std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 			processed_video_frames.clear();
 			processed_audio_frames.clear();
@@ -273,6 +736,9 @@ void FFmpegReader::Close()
 			checked_frames.clear();
 		}
 
+		// Free the packet, frames and scratch buffers
+		FreeDecodeObjects();
+
 		// Close the video file
 		avformat_close_input(&pFormatCtx);
 		av_freep(&pFormatCtx);
@@ -287,6 +753,14 @@ void FFmpegReader::Close()
 	}
 }
 
+// Get a copy of the details of the media file
+MediaInfo FFmpegReader::GetInfo()
+{
+	std::lock_guard<std::mutex> lock(info_mutex);
+
+	return info;
+}
+
 void FFmpegReader::DisplayInfo()
 {
 	cout << fixed << setprecision(2) << boolalpha;
@@ -334,6 +808,199 @@ void FFmpegReader::DisplayInfo()
 }
 
 QSharedPointer<Frame> FFmpegReader::GetFrame(long int requested_frame)
+{
+	// Plain requests come from the playhead
+	return GetFrame(requested_frame, REQUEST_PLAYHEAD);
+}
+
+QSharedPointer<Frame> FFmpegReader::GetFrame(long int requested_frame, RequestPriority priority, RequestScheduler::Clock::time_point deadline)
+{
+	// Learn the access pattern from the requests of the consumers (their own prefetching is not a pattern)
+	if (priority != REQUEST_PREFETCH)
+		access_pattern.Record(requested_frame);
+
+	QSharedPointer<Frame> frame = ReadFrame(requested_frame, priority, deadline);
+
+	// Decode ahead of the requests, if the pattern is predictable
+	if (priority != REQUEST_PREFETCH)
+		SchedulePrefetch();
+
+	return frame;
+}
+
+ScrubResult FFmpegReader::Scrub(long int requested_frame, std::function<void(const ScrubResult&)> refined)
+{
+	// Check for open reader (or throw exception)
+	if (!is_open)
+		throw ReaderClosed("The FFmpegReader is closed.  Call Open() before calling this method.", path);
+
+	if (requested_frame < 1)
+		requested_frame = 1;
+
+	requested_frame = ClampToLength(requested_frame);
+
+	access_pattern.Record(requested_frame);
+
+	// Supersede the previous Scrub() calls
+	ScrubResult result = { QSharedPointer<Frame>(), true, requested_frame, 0 };
+	{
+		std::lock_guard<std::mutex> lock(scrub_mutex);
+
+		result.generation = ++scrub_generation;
+		scrub_target = requested_frame;
+		scrub_callback = refined;
+		scrub_changed.notify_all();
+
+		// Stop refining the previous frame (the playhead moved on)
+		if (refine_token)
+			refine_token->Cancel();
+	}
+
+	// The exact frame, if it's cached
+	result.frame = final_cache.GetFrame(requested_frame);
+
+	// Otherwise the closest decoded frame. Nothing is decoded here: even the keyframe before the requested frame
+	// costs a GOP (a seek lands before the frames it targets), which is left to the refinement task.
+	if (!result.frame)
+		result.frame = final_cache.GetClosestFrame(requested_frame, (long int)ceil(cost_model.GetEstimates().gop_length));
+
+	result.is_approximate = !result.frame || result.frame->number != requested_frame;
+
+	std::lock_guard<std::mutex> lock(scrub_mutex);
+
+	if (!result.is_approximate)
+	{
+		// Nothing to refine
+		scrub_refined = std::max(scrub_refined, result.generation);
+	}
+	else if (!is_refining && !cancel_refine)
+	{
+		// Refine in the background, once the playhead rests (on a thread of the reader, since waiting for the
+		// playhead to rest would hold a worker of the shared ThreadPool)
+		is_refining = true;
+		if (!refine_worker.joinable())
+			refine_worker = std::thread([this] { RunScrubRefinementWorker(); });
+		else
+			scrub_changed.notify_all();
+	}
+
+	return result;
+}
+
+// Run the refinement task whenever Scrub() needs it (until the reader is destroyed)
+void FFmpegReader::RunScrubRefinementWorker()
+{
+	std::unique_lock<std::mutex> lock(scrub_mutex);
+	refine_thread = std::this_thread::get_id();
+
+	while (true)
+	{
+		scrub_changed.wait(lock, [this] { return is_refining || stop_refine_worker; });
+		if (stop_refine_worker)
+			break;
+
+		RunScrubRefinement(lock);
+	}
+
+	refine_thread = std::thread::id();
+}
+
+// Decode the frame under the playhead once it stops moving, until the latest Scrub() call is refined
+void FFmpegReader::RunScrubRefinement(std::unique_lock<std::mutex> &lock)
+{
+	while (!cancel_refine && scrub_refined < scrub_generation)
+	{
+		// Wait for the playhead to rest (a newer Scrub() call starts the wait over)
+		uint64_t generation = scrub_generation;
+		if (scrub_changed.wait_for(lock, std::chrono::milliseconds(scrub_refine_delay), [&] { return cancel_refine || scrub_generation != generation; }))
+			continue;
+
+		ScrubResult result = { QSharedPointer<Frame>(), false, scrub_target, generation };
+		std::function<void(const ScrubResult&)> callback = scrub_callback;
+
+		// The token lets a newer Scrub() call stop the decoding between two packets
+		RequestToken token;
+		refine_token = &token;
+
+		lock.unlock();
+		try
+		{
+			result.frame = ReadFrame(result.requested_frame, REQUEST_PLAYHEAD, RequestScheduler::NoDeadline(), &token);
+		}
+		catch (...)
+		{
+			// The reader was closed, or the frame can't be decoded (there is nothing to refine it to)
+		}
+		lock.lock();
+
+		refine_token = NULL;
+		scrub_refined = std::max(scrub_refined, generation);
+
+		// Only the latest Scrub() call gets its frame (a superseded one goes around again, for the new frame)
+		if (result.frame && callback && !token.IsCancelled() && generation == scrub_generation && !cancel_refine)
+		{
+			lock.unlock();
+			callback(result);
+			lock.lock();
+		}
+	}
+
+	is_refining = false;
+	scrub_changed.notify_all();
+}
+
+// Stop the refinement task, and wait for it to finish
+void FFmpegReader::CancelScrubRefinement()
+{
+	std::unique_lock<std::mutex> lock(scrub_mutex);
+
+	if (!is_refining || refine_thread == std::this_thread::get_id())
+		return;
+
+	cancel_refine = true;
+	if (refine_token)
+		refine_token->Cancel();
+	scrub_changed.notify_all();
+	scrub_changed.wait(lock, [this] { return !is_refining; });
+	cancel_refine = false;
+}
+
+QSharedPointer<Frame> FFmpegReader::GetFrame(long int requested_frame, RequestPriority priority, RequestToken &token)
+{
+	if (priority != REQUEST_PREFETCH)
+		access_pattern.Record(requested_frame);
+
+	QSharedPointer<Frame> frame;
+	try
+	{
+		frame = ReadFrame(requested_frame, priority, token.GetDeadline(), &token);
+	}
+	catch (...)
+	{
+		token.SetStatus(REQUEST_FAILED);
+		throw;
+	}
+
+	// A stopped request has its status already
+	if (token.GetStatus() == REQUEST_PENDING)
+		token.SetStatus(REQUEST_COMPLETED);
+
+	if (priority != REQUEST_PREFETCH)
+		SchedulePrefetch();
+
+	return frame;
+}
+
+// Give up on a request stopped by its token, and return the closest cached frame (if any)
+QSharedPointer<Frame> FFmpegReader::StopRequest(long int requested_frame, RequestToken *token)
+{
+	token->SetStatus(token->GetStopStatus());
+
+	return final_cache.GetClosestFrame(requested_frame, (long int)ceil(cost_model.GetEstimates().gop_length));
+}
+
+// Get a frame from the cache, or decode it (until the token, if any, stops the request)
+QSharedPointer<Frame> FFmpegReader::ReadFrame(long int requested_frame, RequestPriority priority, RequestScheduler::Clock::time_point deadline, RequestToken *token)
 {
 	// Check for open reader (or throw exception)
 	if (!is_open)
@@ -343,24 +1010,52 @@ QSharedPointer<Frame> FFmpegReader::GetFrame(long int requested_frame)
 	if (requested_frame < 1)
 		requested_frame = 1;
 
-	if (requested_frame > info.video_length && is_duration_known)
-		requested_frame = info.video_length;
+	requested_frame = ClampToLength(requested_frame);
+
+	{
+		std::lock_guard<std::mutex> lock(info_mutex);
+		if (info.has_video && info.video_length == 0)
+			throw InvalidFile("Could not detect the duration of the video or audio stream.", path);
+	}
 
-	if (info.has_video && info.video_length == 0)
-		throw InvalidFile("Could not detect the duration of the video or audio stream.", path);
 
+	// Prefetching (i.e. for playback) and analysis (i.e. waveforms) need the audio skipped by a low latency open
+	if (is_audio_deferred && (priority == REQUEST_PREFETCH || priority == REQUEST_ANALYSIS))
+		is_audio_requested = true;
 
-	// Check the cache for this frame
+	// Check the cache for this frame (the frames cached without their audio don't count, once audio is needed)
 	QSharedPointer<Frame> frame = final_cache.GetFrame(requested_frame);
-	if (frame)
+	if (frame && !(is_audio_deferred && is_audio_requested))
 	{
 		return frame; // Return the cached frame
 	}
-	else
+
+	// Wait for a request already decoding this frame (or a nearby frame, which walks past this one), and share its result
+	if (WaitForFlight(requested_frame, priority, token))
+	{
+		frame = final_cache.GetFrame(requested_frame);
+		if (frame && !(is_audio_deferred && is_audio_requested))
+		{
+			return frame;
+		}
+	}
+
+	// Let other requests for this frame wait for this one (until it returns, or throws)
+	struct FlightScope
 	{
-		//std::lock_guard<std::mutex> lock(get_frames_mutex);
+		FFmpegReader *reader;
+		uint64_t id;
+		~FlightScope() { reader->EndFlight(id); }
+	} flight = { this, BeginFlight(requested_frame, priority) };
 
-		// Check the cache a 2nd time (due to a potential previous lock)
+	// Wait for the decoder (more urgent requests go first)
+	ScheduledRequest request(scheduler, priority, deadline, token);
+	if (!request.HasDecoder())
+		return StopRequest(requested_frame, token);
+
+	while (true)
+	{
+		// Check the cache a 2nd time (the frame could have been decoded while waiting)
 		if (has_missing_frames)
 		{
 			bool result = CheckMissingFrame(requested_frame);
@@ -372,188 +1067,456 @@ QSharedPointer<Frame> FFmpegReader::GetFrame(long int requested_frame)
 			return frame;
 		}
 
+		// Stop before seeking or decoding, if the request was cancelled (or is late)
+		if (request.ShouldStop())
+			return StopRequest(requested_frame, token);
+
 		// Frame is not in cache
 		// Reset seek count
 		seek_count = 0;
 
+		// Start decoding the audio skipped by a low latency open
+		if (is_audio_deferred && is_audio_requested)
+			ResumeAudio(requested_frame);
+
 		// Check for first frame (always need to get frame 1 before other frames, to correctly calculate offsets)
-		if (last_frame == 0 && requested_frame != 1)
+		// (unless the offsets are known already, i.e. from the snapshot of the file)
+		bool is_offset_known = (!info.has_video || video_pts_offset != 99999) && (!info.has_audio || is_audio_deferred || audio_pts_offset != 99999);
+		if (last_frame == 0 && requested_frame != 1 && !is_offset_known)
 		{
 			// Get first frame
-			ReadStream(1);
+			if (!ReadStream(1, request))
+			{
+				if (request.ShouldStop() || !request.Yield())
+					return StopRequest(requested_frame, token);
+				continue;
+			}
 		}
 
 		// Are we within X frames of the requested frame?
 		long int diff = requested_frame - last_frame;
-		if (diff >= 1 && diff <= 20)
-		{
-			// Continue walking the stream
-			return ReadStream(requested_frame);
-		}
-		else
+		bool must_seek = !CanWalkTo(requested_frame);
+
+		if (must_seek)
 		{
 			// Greater than 30 frames away, or backwards, we need to seek to the nearest key frame... Only seek if enabled
 			if (enable_seek)
 			{
+				std::chrono::steady_clock::time_point seek_started = std::chrono::steady_clock::now();
 				Seek(requested_frame);
+				cost_model.AddSeekTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - seek_started).count());
 			}
 
 			else if (!enable_seek && diff < 0)
 			{
 				// Start over, since we can't seek, and the requested frame is smaller than our position
-				Close();
-				Open();
+				// (rewinding to the start doesn't land on a keyframe near the frame, so it is safe for any codec)
+				Seek(1);
 			}
+		}
 
-			// Then continue walking the stream
-			return ReadStream(requested_frame);
+		// Then continue walking the stream
+		frame = ReadStream(requested_frame, request);
+		if (frame)
+		{
+			return frame;
 		}
 
+		// The request was stopped by its token (between two packets, so the reader can resume from there)
+		if (request.ShouldStop())
+			return StopRequest(requested_frame, token);
+
+		// A more urgent request is waiting: let it decode first, then start over (it may have moved the stream)
+		if (!request.Yield())
+			return StopRequest(requested_frame, token);
 	}
 }
 
-// Private
+// Check if a frame can be reached by decoding forward from the current position (instead of seeking)
+bool FFmpegReader::CanWalkTo(long int requested_frame)
+{
+	// Walk when decoding every frame up to the requested one costs less than seeking to its keyframe
+	// (playback favors walking, since the next requests need the same frames, and random access favors seeking)
+	// A last frame of 0 is the start of the stream, unless a seek moved the stream and nothing was decoded since.
+	if (last_frame == 0 && is_seeking)
+		return false;
 
-void FFmpegReader::UpdateAudioInfo()
+	return requested_frame > last_frame && cost_model.ShouldWalk(last_frame, requested_frame, access_pattern.GetStrategy().walk_bias);
+}
+
+// Clamp a frame number to the length of the file, if it is known
+long int FFmpegReader::ClampToLength(long int frame_number)
 {
-	// Set values of FileInfo struct
-	info.has_audio = true;
-	info.file_size = pFormatCtx->pb ? avio_size(pFormatCtx->pb) : -1;
-	info.acodec = aCodecCtx->codec->name;
-	info.channels = aCodecCtx->channels;
-	if (aCodecCtx->channel_layout == 0) aCodecCtx->channel_layout = av_get_default_channel_layout(aCodecCtx->channels);
-	info.channel_layout = (ChannelLayout)aCodecCtx->channel_layout;
-	info.sample_rate = aCodecCtx->sample_rate;
-	info.audio_bit_rate = aCodecCtx->bit_rate;
+	std::lock_guard<std::mutex> lock(info_mutex);
+
+	if (frame_number > info.video_length && is_duration_known)
+		return info.video_length;
+
+	return frame_number;
+}
+
+// Get the number of frames before a requested frame to convert and cache (instead of skipping them)
+long int FFmpegReader::GetSkipWindow()
+{
+	long int window = cost_model.GetSkipWindow();
+
+	// Reverse playback needs every frame between the keyframe and the requested frame
+	if (access_pattern.GetStrategy().retain_gop)
+		window = std::max(window, (long int)ceil(cost_model.GetEstimates().gop_length));
 
-	// Set audio timebase
-	info.audio_timebase.num = aStream->time_base.num;
-	info.audio_timebase.den = aStream->time_base.den;
+	return window;
+}
 
-	// Get timebase of audio stream (if valid) and greater than the current duration
-	if (aStream->duration > 0.0f && aStream->duration > info.duration)
-		info.duration = aStream->duration * info.audio_timebase.ToDouble();
+// Queue the prefetch task, if there are hinted ranges or the access pattern is predictable (and it isn't queued already)
+void FFmpegReader::SchedulePrefetch()
+{
+	if (!is_open)
+		return;
 
-	// Check for an invalid video length
-	if (info.has_video && info.video_length <= 0)
+	bool has_pattern = enable_prefetch && access_pattern.GetStrategy().prefetch_count > 0;
 	{
-		// Calculate the video length from the audio duration
-		info.video_length = info.duration * info.fps.ToDouble();
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+
+		if ((prefetch_hints.empty() && !has_pattern) || is_prefetching || cancel_prefetch)
+			return;
+
+		// Decode on a thread of the reader (ReadFrame blocks while other requests decode, which would hold a
+		// worker of the shared ThreadPool)
+		is_prefetching = true;
+		if (!prefetch_worker.joinable())
+			prefetch_worker = std::thread([this] { RunPrefetchWorker(); });
+		else
+			prefetch_wake.notify_all();
 	}
+}
 
-	// Set video timebase (if no video stream was found)
-	if (!info.has_video)
+// Run the prefetch task whenever SchedulePrefetch() queues it (until the reader is destroyed)
+void FFmpegReader::RunPrefetchWorker()
+{
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+	prefetch_thread = std::this_thread::get_id();
+
+	while (true)
 	{
-		// Set a few important default video settings (so audio can be divided into frames)
-		info.fps.num = 24;
-		info.fps.den = 1;
-		info.video_timebase.num = 1;
-		info.video_timebase.den = 24;
-		info.video_length = info.duration * info.fps.ToDouble();
-		info.width = 720;
-		info.height = 480;
+		prefetch_wake.wait(lock, [this] { return is_prefetching || stop_prefetch_worker; });
+		if (stop_prefetch_worker)
+			break;
 
+		RunPrefetch(lock);
 	}
+
+	prefetch_thread = std::thread::id();
 }
 
-void FFmpegReader::UpdateVideoInfo()
+// Take the next frame of the most urgent hinted range which isn't cached yet (0 if there is none)
+long int FFmpegReader::TakeHintFrame(RequestPriority &priority)
 {
-	// Set values of FileInfo struct
-	info.has_video = true;
-	info.file_size = pFormatCtx->pb ? avio_size(pFormatCtx->pb) : -1;
-	info.height = pCodecCtx->height;
-	info.width = pCodecCtx->width;
-	info.vcodec = pCodecCtx->codec->name;
-	info.video_bit_rate = pFormatCtx->bit_rate;
-	if (!check_fps)
+	while (true)
 	{
-		// set frames per second (fps)
-		info.fps.num = pStream->avg_frame_rate.num;
-		info.fps.den = pStream->avg_frame_rate.den;
+		// The most urgent hint (the first one hinted, among the hints of the same priority)
+		vector<PrefetchHint>::iterator hint = prefetch_hints.end();
+		for (vector<PrefetchHint>::iterator itr = prefetch_hints.begin(); itr != prefetch_hints.end(); ++itr)
+			if (hint == prefetch_hints.end() || itr->priority < hint->priority)
+				hint = itr;
+
+		if (hint == prefetch_hints.end())
+			return 0;
+
+		// Skip the frames which are cached already, and the ones Evict released
+		while (hint->next <= hint->end && (final_cache.Contains(hint->next) || !final_cache.IsPinned(hint->next)))
+			hint->next++;
+
+		if (hint->next > hint->end)
+		{
+			// The whole range was decoded or evicted (what's decoded stays pinned, until Evict)
+			prefetch_hints.erase(hint);
+			continue;
+		}
+
+		priority = hint->priority;
+		return hint->next++;
 	}
+}
+
+// Get the next frame the access pattern expects, which isn't cached yet (0 if there is none)
+long int FFmpegReader::GetPatternFrame(set<long int> &attempted)
+{
+	if (!enable_prefetch || (int)attempted.size() >= 64)
+		return 0;
 
-	if (pStream->sample_aspect_ratio.num != 0)
+	AccessStrategy strategy = access_pattern.GetStrategy();
+	long int position = access_pattern.GetLastRequest();
+
+	for (int index = 1; index <= strategy.prefetch_count; index++)
 	{
-		info.pixel_ratio.num = pStream->sample_aspect_ratio.num;
-		info.pixel_ratio.den = pStream->sample_aspect_ratio.den;
+		long int frame = position + index * strategy.prefetch_step;
+		if (frame < 1 || ClampToLength(frame) < frame)
+			break;
+
+		// Don't start the file over for a prefetch (without seeking, going back means reopening it)
+		if (!enable_seek && frame <= last_frame)
+			continue;
+
+		if (!final_cache.Contains(frame) && attempted.find(frame) == attempted.end())
+		{
+			attempted.insert(frame);
+			access_pattern.AddPrefetched(frame);
+			return frame;
+		}
 	}
-	else if (pCodecCtx->sample_aspect_ratio.num != 0)
+
+	return 0;
+}
+
+// Decode the hinted ranges, then the frames the access pattern expects next (the task follows the latest request)
+void FFmpegReader::RunPrefetch(std::unique_lock<std::mutex> &lock)
+{
+	set<long int> attempted;
+	while (!cancel_prefetch && is_open)
 	{
-		info.pixel_ratio.num = pCodecCtx->sample_aspect_ratio.num;
-		info.pixel_ratio.den = pCodecCtx->sample_aspect_ratio.den;
+		RequestPriority priority = REQUEST_PREFETCH;
+		long int next_frame = TakeHintFrame(priority);
+
+		if (next_frame == 0)
+		{
+			lock.unlock();
+			next_frame = GetPatternFrame(attempted);
+			lock.lock();
+		}
+
+		// Nothing left to decode (unless a range was hinted meanwhile)
+		if (next_frame == 0)
+		{
+			if (prefetch_hints.empty())
+				break;
+			continue;
+		}
+
+		// The token lets CancelPrefetch stop the frame between two packets
+		RequestToken token;
+		prefetch_token = &token;
+
+		lock.unlock();
+		try
+		{
+			ReadFrame(next_frame, priority, RequestScheduler::NoDeadline(), &token);
+		}
+		catch (...)
+		{
+			// Prefetching is best effort (the request for the frame will report the error)
+			token.Cancel();
+		}
+		lock.lock();
+
+		prefetch_token = NULL;
+		if (token.IsCancelled())
+			break;
 	}
-	else
+
+	is_prefetching = false;
+	prefetch_finished.notify_all();
+}
+
+long int FFmpegReader::Prefetch(long int start_frame, long int end_frame, RequestPriority priority)
+{
+	// Check for open reader (or throw exception)
+	if (!is_open)
+		throw ReaderClosed("The FFmpegReader is closed.  Call Open() before calling this method.", path);
+
+	if (start_frame < 1)
+		start_frame = 1;
+
+	end_frame = ClampToLength(end_frame);
+
+	if (start_frame > end_frame)
+		return start_frame - 1;
+
+	// Keep the frames of the range, until Evict releases them (only decode the part which fits in the pinned bytes)
+	end_frame = final_cache.Pin(start_frame, end_frame);
+	if (start_frame > end_frame)
+		return end_frame;
+
 	{
-		info.pixel_ratio.num = 1;
-		info.pixel_ratio.den = 1;
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+
+		PrefetchHint hint = { start_frame, end_frame, start_frame, priority };
+		prefetch_hints.push_back(hint);
 	}
 
-	info.pixel_format = pCodecCtx->pix_fmt;
+	SchedulePrefetch();
+
+	return end_frame;
+}
+
+void FFmpegReader::Evict(long int start_frame, long int end_frame)
+{
+	if (start_frame > end_frame)
+		return;
+
+	// Release one pin of each frame of the range, and remove the frames no other range pins (the prefetch stops
+	// decoding them, see TakeHintFrame)
+	final_cache.Unpin(start_frame, end_frame);
+	final_cache.RemoveUnpinned(start_frame, end_frame);
+}
+
+// Stop the prefetch task, and wait for it to finish
+void FFmpegReader::CancelPrefetch()
+{
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+
+	if (!is_prefetching || prefetch_thread == std::this_thread::get_id())
+		return;
+
+	cancel_prefetch = true;
+	if (prefetch_token)
+		prefetch_token->Cancel();
+	prefetch_finished.wait(lock, [this] { return !is_prefetching; });
+	cancel_prefetch = false;
+}
+
+// Use the streams of a snapshot instead of probing the file (returns false if the snapshot doesn't match the file)
+bool FFmpegReader::RestoreSnapshot(const MediaInfoSnapshot &snapshot)
+{
+	if (snapshot.stream_count != (int)pFormatCtx->nb_streams)
+		return false;
+
+	const StreamParameters *parameters[2] = { &snapshot.video, &snapshot.audio };
+	for (int index = 0; index < 2; index++)
+	{
+		// The demuxer sets the time base of the streams when it reads the header, so it must match
+		if (parameters[index]->index >= 0 && !helpers::MatchStreamParameters(pFormatCtx->streams[parameters[index]->index], *parameters[index]))
+			return false;
+	}
 
-	// Calculate the DAR (display aspect ratio)
-	Fraction size(info.width * info.pixel_ratio.num, info.height * info.pixel_ratio.den);
+	for (int index = 0; index < 2; index++)
+		if (parameters[index]->index >= 0)
+			helpers::RestoreStreamParameters(pFormatCtx->streams[parameters[index]->index], *parameters[index]);
 
-	// Reduce size fraction
-	size.Reduce();
+	return true;
+}
 
-	// Set the ratio based on the reduced fraction
-	info.display_ratio.num = size.num;
-	info.display_ratio.den = size.den;
+// Store the snapshot of the file (the info, the parameters of the streams, and the PTS offsets found so far)
+void FFmpegReader::StoreSnapshot()
+{
+	if (info_key.isEmpty())
+		return;
 
-	// Set the video timebase
-	info.video_timebase.num = pStream->time_base.num;
-	info.video_timebase.den = pStream->time_base.den;
+	MediaInfoSnapshot snapshot = MediaInfoSnapshot();
+	snapshot.info = info;
+	snapshot.is_duration_known = is_duration_known;
+	snapshot.video_pts_offset = video_pts_offset;
+	snapshot.audio_pts_offset = audio_pts_offset;
+	snapshot.stream_count = pFormatCtx->nb_streams;
+	snapshot.video.index = -1;
+	snapshot.audio.index = -1;
 
-	// Set the duration in seconds, and video length (# of frames)
-	info.duration = pStream->duration * info.video_timebase.ToDouble();
+	if (info.has_video)
+		helpers::StoreStreamParameters(pStream, snapshot.video);
+	if (info.has_audio)
+		helpers::StoreStreamParameters(aStream, snapshot.audio);
 
-	// Check for valid duration (if found)
-	if (info.duration <= 0.0f && pFormatCtx->duration >= 0)
-		// Use the format's duration
-		info.duration = pFormatCtx->duration / AV_TIME_BASE;
+	info_cache->Store(info_key, snapshot);
+}
 
-	// Calculate duration from filesize and bitrate (if any)
-	if (info.duration <= 0.0f && info.video_bit_rate > 0 && info.file_size > 0)
-		// Estimate from bitrate, total bytes, and framerate
-		info.duration = (info.file_size / info.video_bit_rate);
+// Add the keyframes listed in the index of the video stream (if the demuxer read one) to the cost model
+void FFmpegReader::LoadKeyframeIndex()
+{
+	int64_t start_time = pStream->start_time != AV_NOPTS_VALUE ? pStream->start_time : 0;
+	double fps = info.fps.ToDouble();
 
-	// No duration found in stream of file
-	if (info.duration <= 0.0f)
+	for (int index = 0; index < pStream->nb_index_entries; index++)
 	{
-		// No duration is found in the video stream
-		info.duration = -1;
-		info.video_length = -1;
-		is_duration_known = false;
+		const AVIndexEntry &entry = pStream->index_entries[index];
+
+		if (entry.flags & AVINDEX_KEYFRAME)
+		{
+			double seconds = double(entry.timestamp - start_time) * info.video_timebase.ToDouble();
+			cost_model.AddKeyframe(round(seconds * fps) + 1, true);
+		}
 	}
-	else
+}
+
+// Wait for the requests decoding the same (or a nearby) frame, with the same or a more urgent priority
+bool FFmpegReader::WaitForFlight(long int requested_frame, RequestPriority priority, RequestToken *token)
+{
+	std::unique_lock<std::mutex> lock(flights_mutex);
+	bool has_waited = false;
+
+	while (true)
 	{
-		// Yes, a duration was found
-		is_duration_known = true;
+		// A less urgent request is not waited for (the scheduler preempts it instead)
+		bool is_in_flight = false;
+		for (size_t i = 0; i < flights.size(); i++)
+		{
+			if (abs(flights[i].frame - requested_frame) <= SingleFlightWindow && flights[i].priority <= priority)
+			{
+				is_in_flight = true;
+				break;
+			}
+		}
+
+		if (!is_in_flight || (token && token->ShouldStop()))
+			return has_waited;
 
-		// Calculate number of frames
-		info.video_length = round(info.duration * info.fps.ToDouble());
+		// Wake up now and then to check the token (cancelling it doesn't notify the flights)
+		if (token)
+			flight_finished.wait_until(lock, std::min(token->GetDeadline(), RequestToken::Clock::now() + std::chrono::milliseconds(5)));
+		else
+			flight_finished.wait(lock);
+		has_waited = true;
 	}
+}
+
+// Announce that a request is decoding a frame
+uint64_t FFmpegReader::BeginFlight(long int requested_frame, RequestPriority priority)
+{
+	std::lock_guard<std::mutex> lock(flights_mutex);
 
-	// Override an invalid framerate
-	if (info.fps.ToFloat() > 120.0f || (info.fps.num == 0 || info.fps.den == 0))
+	FrameFlight flight = { next_flight_id++, requested_frame, priority };
+	flights.push_back(flight);
+
+	return flight.id;
+}
+
+// Announce that a request is done decoding (and wake up the requests waiting for it)
+void FFmpegReader::EndFlight(uint64_t id)
+{
 	{
-		// Set a few important default video settings (so audio can be divided into frames)
-		info.fps.num = 24;
-		info.fps.den = 1;
-		info.video_timebase.num = 1;
-		info.video_timebase.den = 24;
+		std::lock_guard<std::mutex> lock(flights_mutex);
 
-		// Calculate number of frames
-		info.video_length = round(info.duration * info.fps.ToDouble());
+		for (size_t i = 0; i < flights.size(); i++)
+		{
+			if (flights[i].id == id)
+			{
+				flights.erase(flights.begin() + i);
+				break;
+			}
+		}
 	}
 
+	flight_finished.notify_all();
+}
+
+// Private
+
+void FFmpegReader::UpdateAudioInfo()
+{
+	// The resampler needs a channel layout
+	if (aCodecCtx->channel_layout == 0) aCodecCtx->channel_layout = av_get_default_channel_layout(aCodecCtx->channels);
+
+	helpers::FillAudioInfo(info, pFormatCtx, aStream, aCodecCtx->codec->name);
+}
+
+void FFmpegReader::UpdateVideoInfo()
+{
+	is_duration_known = helpers::FillVideoInfo(info, pFormatCtx, pStream, pCodecCtx->codec->name, check_fps);
 }
 
 // Check if a frame is missing and attempt to replace it's frame image (and
 bool FFmpegReader::CheckMissingFrame(long int requested_frame)
 {
 	// Lock
-	//std::lock_guard<std::mutex> lock(processing_mutex);
+	std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 	// Init # of times this frame has been checked so far
 	int checked_count = 0;
@@ -609,8 +1572,8 @@ bool FFmpegReader::CheckMissingFrame(long int requested_frame)
 			}
 		}
 
-		// Create blank missing frame
-		QSharedPointer<Frame> missing_frame = CreateFrame(requested_frame);
+		// Create blank missing frame (without an image plane, since it shares the image of its parent)
+		QSharedPointer<Frame> missing_frame = CreateFrame(requested_frame, false);
 
 		// If previous frame found, copy image from previous to missing frame (else we'll just wait a bit and try again later)
 		if (parent_frame != NULL)
@@ -619,7 +1582,8 @@ bool FFmpegReader::CheckMissingFrame(long int requested_frame)
 			QSharedPointer<QImage> parent_image = parent_frame->GetImage();
 			if (parent_image) 
 			{
-				missing_frame->AddImage(QSharedPointer<QImage>(new QImage(*parent_image)));
+				// Share the parent's pixels (copy-on-write, so nothing is copied unless the image is modified)
+				missing_frame->AddImage(QSharedPointer<QImage>::create(*parent_image));
 
 				processed_video_frames[missing_frame->number] = missing_frame->number;
 				processed_audio_frames[missing_frame->number] = missing_frame->number;
@@ -669,7 +1633,7 @@ void FFmpegReader::CheckWorkingFrames(bool end_of_stream, long int requested_fra
 
 		// limit scope of next few lines... for locking
 		{
-			//std::lock_guard<std::mutex> lock(processing_mutex);
+			std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 			is_video_ready = processed_video_frames.count(f->number);
 			is_audio_ready = processed_audio_frames.count(f->number);
@@ -694,9 +1658,9 @@ void FFmpegReader::CheckWorkingFrames(bool end_of_stream, long int requested_fra
 
 		bool is_seek_trash = IsPartialFrame(f->number);
 
-		// Adjust for available streams
+		// Adjust for available streams (and for the audio skipped by a low latency open)
 		if (!info.has_video) is_video_ready = true;
-		if (!info.has_audio) is_audio_ready = true;
+		if (!info.has_audio || is_audio_deferred) is_audio_ready = true;
 
 		// Make final any frames that get stuck (for whatever reason)
 		if (checked_count >= max_checked_count && (!is_video_ready || !is_audio_ready))
@@ -706,15 +1670,15 @@ void FFmpegReader::CheckWorkingFrames(bool end_of_stream, long int requested_fra
 
 			if (info.has_video && !is_video_ready && last_video_frame) 
 			{
-				// Copy image from last frame
-				f->AddImage(QSharedPointer<QImage>(new QImage(*last_video_frame->GetImage())));
+				// Share the image of the last frame (copy-on-write)
+				f->AddImage(QSharedPointer<QImage>::create(*last_video_frame->GetImage()));
 
 				is_video_ready = true;
 			}
 
 			if (info.has_audio && !is_audio_ready)
 			{
-				//std::lock_guard<std::mutex> lock(processing_mutex);
+				std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 				// Mark audio as processed, and indicate the frame has audio data
 				is_audio_ready = true;
@@ -731,7 +1695,7 @@ void FFmpegReader::CheckWorkingFrames(bool end_of_stream, long int requested_fra
 
 				// Add to missing cache (if another frame depends on it)
 				{
-					//std::lock_guard<std::mutex> lock(processing_mutex);
+					std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 					if (missing_video_frames_source.count(f->number))
 					{
@@ -763,7 +1727,7 @@ void FFmpegReader::CheckWorkingFrames(bool end_of_stream, long int requested_fra
 }
 
 // Read the stream until we find the requested Frame
-QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
+QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame, ScheduledRequest &request)
 {
 	// Allocate video frame
 	bool end_of_stream = false;
@@ -776,17 +1740,31 @@ QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
 	int minimum_packets = std::thread::hardware_concurrency();
 	int max_packets = 4096;
 
+	// Time spent decoding the packets of the next video frame (for the cost model)
+	double decode_time = 0.0;
+
+	// Convert the video frame left by a stopped request first (its packet is still the current one)
+	if (is_conversion_pending)
+	{
+		is_conversion_pending = false;
+		ProcessVideoPacket(requested_frame);
+	}
+
 	// TODO: Convert to parallel version
 	// Loop through the stream until the correct frame is found
 	while (true)
 	{
+		// Step aside at a packet boundary, if a more urgent request is waiting for the decoder (or the request was stopped)
+		if (request.ShouldYield() || request.ShouldStop())
+			return QSharedPointer<Frame>();
+
 		// Get the next packet into a local variable called packet
 		packet_error = GetNextPacket();
 
 		int processing_video_frames_size = 0;
 		int processing_audio_frames_size = 0;
 		{
-			//std::lock_guard<std::mutex> lock(processing_mutex);
+			std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 			processing_video_frames_size = processing_video_frames.size();
 			processing_audio_frames_size = processing_audio_frames.size();
@@ -797,7 +1775,7 @@ QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
 		{
 			std::this_thread::sleep_for(2.5s);
 
-			//std::lock_guard<std::mutex> lock(processing_mutex);
+			std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 			processing_video_frames_size = processing_video_frames.size();
 			processing_audio_frames_size = processing_audio_frames.size();
@@ -828,21 +1806,42 @@ QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
 				continue;
 			}
 
+			// Open the codec on the first packet which needs it (after a low latency open), and give it its threads at
+			// the next keyframe, once the first frame is out (the new decoder needs nothing from before the keyframe, so
+			// the stream goes on without a seek)
+			if (!avcodec_is_open(pCodecCtx))
+				OpenVideoCodec(true);
+			else if (is_decoder_upgrade_pending && last_frame > 0 && (packet->flags & AV_PKT_FLAG_KEY))
+				UpgradeVideoDecoder(requested_frame);
+
 			// Get the AVFrame from the current packet
+			std::chrono::steady_clock::time_point decode_started = std::chrono::steady_clock::now();
 			frame_finished = GetAVFrame();
+			decode_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - decode_started).count();
 
 			// Check if the AVFrame is finished and set it
 			if (frame_finished)
 			{
+				cost_model.AddDecodeTime(decode_time);
+				decode_time = 0.0;
+
 				// Update PTS / Frame Offset (if any)
 				UpdatePTSOffset(true);
 
+				// Stop before converting, if the request was stopped while decoding (the next request converts the
+				// frame, so the stream goes on from here)
+				if (request.ShouldStop())
+				{
+					is_conversion_pending = true;
+					return QSharedPointer<Frame>();
+				}
+
 				// Process Video Packet
 				ProcessVideoPacket(requested_frame);
 			}
 
 		}
-		else if (info.has_audio && packet->stream_index == audioStream) // Audio packet
+		else if (info.has_audio && !is_audio_deferred && packet->stream_index == audioStream) // Audio packet
 		{
 			// Check the status of a seek (if any)
 			if (is_seeking)
@@ -860,6 +1859,10 @@ QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
 				continue;
 			}
 
+			// Open the codec on the first packet which needs it (after a low latency open, once audio is needed)
+			if (!avcodec_is_open(aCodecCtx))
+				OpenAudioCodec();
+
 			// Update PTS / Frame Offset (if any)
 			UpdatePTSOffset(false);
 
@@ -870,6 +1873,10 @@ QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
 			ProcessAudioPacket(requested_frame, location.frame, location.sample_start);
 		}
 
+		// Stop before assembling the finished frames, if the request was stopped (the next packet assembles them)
+		if (request.ShouldStop())
+			return QSharedPointer<Frame>();
+
 		// Check if working frames are 'finished'
 		bool is_cache_found = false;
 		if (!is_seeking)
@@ -882,7 +1889,7 @@ QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
 		}
 
 		// Check if requested 'final' frame is available
-		is_cache_found = (final_cache.GetFrame(requested_frame) != NULL);
+		is_cache_found = final_cache.Contains(requested_frame);
 
 		// Increment frames processed
 		packets_processed++;
@@ -920,58 +1927,273 @@ QSharedPointer<Frame> FFmpegReader::ReadStream(long int requested_frame)
 		{
 			// The largest processed frame is no longer in cache, return a blank frame
 			QSharedPointer<Frame> f = CreateFrame(largest_frame_processed);
-			f->AddColor(info.width, info.height, "#000");
+			if (info.has_video)
+				f->AddColor(info.width, info.height, "#000");
 			return f;
 		}
 	}
 }
 
-// Get the next packet (if any)
-int FFmpegReader::GetNextPacket()
+// Take a share of the decoder threads of the process, and pick frame or slice threading for the video codec
+void FFmpegReader::AcquireDecoderThreads(AVCodec *codec)
+{
+	// Threads left over from a failed Open
+	ReleaseDecoderThreads();
+
+	bool frame_threads = (codec->capabilities & AV_CODEC_CAP_FRAME_THREADS) != 0;
+	bool slice_threads = (codec->capabilities & AV_CODEC_CAP_SLICE_THREADS) != 0;
+
+	// Decoders which can't use threads don't take any from the budget
+	if (!frame_threads && !slice_threads)
+	{
+		pCodecCtx->thread_count = 1;
+		return;
+	}
+
+	// The workload is the number of pixels per second
+	double fps = av_q2d(pStream->avg_frame_rate);
+	if (fps <= 0.0)
+		fps = 30.0;
+	video_decoder_workload = (int64_t)(pCodecCtx->width * (double)pCodecCtx->height * fps);
+	video_decoder_threads = DecoderThreadBudget::Global().Acquire(video_decoder_workload);
+
+	// Intra-only codecs (i.e. ProRes, DNxHD) split each frame into slices, which doesn't delay the output.
+	// Other codecs decode several frames at once (when they can), which scales much better for them.
+	const AVCodecDescriptor *descriptor = avcodec_descriptor_get(codec->id);
+	bool intra_only = descriptor && (descriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+
+	pCodecCtx->thread_count = video_decoder_threads;
+	pCodecCtx->thread_type = (slice_threads && (intra_only || !frame_threads)) ? FF_THREAD_SLICE : FF_THREAD_FRAME;
+}
+
+// Open the video codec, with its share of the decoder threads (or on one thread, until the first frame is out)
+void FFmpegReader::OpenVideoCodec(bool single_threaded)
+{
+	// Find the decoder for the video stream
+	AVCodec *pCodec = avcodec_find_decoder(pCodecCtx->codec_id);
+	if (pCodec == NULL)
+		throw InvalidCodec("A valid video codec could not be found for this file.", path);
+
+	if (single_threaded)
+	{
+		// A single thread outputs the first frame sooner (frame threads delay the output by a frame per thread)
+		pCodecCtx->thread_count = 1;
+		is_decoder_upgrade_pending = true;
+	}
+	else
+	{
+		// Take a share of the decoder threads of the process (instead of one thread per core for every reader)
+		AcquireDecoderThreads(pCodec);
+		is_decoder_upgrade_pending = false;
+	}
+
+	if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0)
+	{
+		ReleaseDecoderThreads();
+		throw InvalidCodec("A video codec was found, but could not be opened.", path);
+	}
+
+	// Frame threads output each frame a packet later per extra thread. The delay is taken off the DTS of the
+	// packets (see GetVideoPTS), so the frames are numbered the same for any thread count (i.e. after
+	// UpgradeVideoDecoder, or with the PTS offset of a snapshot stored by a reader with other threads)
+	video_decoder_delay = 0;
+	if ((pCodecCtx->active_thread_type & FF_THREAD_FRAME) && pCodecCtx->thread_count > 1)
+		video_decoder_delay = (int64_t)(pCodecCtx->thread_count - 1) * GetVideoFrameDuration();
+}
+
+// Get the duration of a video frame (in DTS units)
+int64_t FFmpegReader::GetVideoFrameDuration()
+{
+	return max((int64_t)1, (int64_t)round(1.0 / (info.fps.ToDouble() * info.video_timebase.ToDouble())));
+}
+
+// Open the audio codec
+void FFmpegReader::OpenAudioCodec()
+{
+	// Audio decoders are cheap (and FFmpeg can't split them across threads), so they don't use the budget
+	aCodecCtx->thread_count = 1;
+
+	// Find the decoder for the audio stream
+	AVCodec *aCodec = avcodec_find_decoder(aCodecCtx->codec_id);
+	if (aCodec == NULL)
+		throw InvalidCodec("A valid audio codec could not be found for this file.", path);
+
+	if (avcodec_open2(aCodecCtx, aCodec, NULL) < 0)
+		throw InvalidCodec("An audio codec was found, but could not be opened.", path);
+}
+
+// Replace the single threaded video codec of a low latency open, by one with its share of the decoder threads
+// (the thread count of an open codec can't change, so the new codec starts at the keyframe packet being read)
+void FFmpegReader::UpgradeVideoDecoder(long int requested_frame)
+{
+	is_decoder_upgrade_pending = false;
+
+	AVCodecContext *new_context = avcodec_alloc_context3(pCodecCtx->codec);
+	if (new_context == NULL || avcodec_parameters_to_context(new_context, pStream->codecpar) < 0)
+	{
+		// Keep decoding on one thread
+		avcodec_free_context(&new_context);
+		return;
+	}
+
+	// Output the frames still delayed by the old codec (i.e. for B-frames), numbered like the packets which would
+	// have output them (the frames are numbered by the DTS of their packet)
+	AVPacket *keyframe_packet = packet;
+	AVPacket drain_packet;
+	av_init_packet(&drain_packet);
+	drain_packet.data = NULL;
+	drain_packet.size = 0;
+	drain_packet.dts = keyframe_packet->dts;
+
+	int64_t frame_duration = keyframe_packet->duration;
+	if (frame_duration <= 0)
+		frame_duration = GetVideoFrameDuration();
+
+	packet = &drain_packet;
+	while (drain_packet.dts != AV_NOPTS_VALUE)
+	{
+		int frame_finished = 0;
+		if (avcodec_decode_video2(pCodecCtx, pFrame, &frame_finished, &drain_packet) < 0 || !frame_finished)
+			break;
+
+		picture_type = pFrame->pict_type;
+		ProcessVideoPacket(requested_frame);
+		drain_packet.dts += frame_duration;
+	}
+	packet = keyframe_packet;
+
+	avcodec_free_context(&pCodecCtx);
+	pCodecCtx = new_context;
+	OpenVideoCodec(false);
+}
+
+// Start decoding the audio skipped by a low latency open (called by the request which decodes)
+void FFmpegReader::ResumeAudio(long int requested_frame)
+{
+	is_audio_deferred = false;
+
+	// The frames decoded so far have silent audio (the ranges passed to Prefetch() stay pinned, and are hinted
+	// again, so the prefetch task decodes them with their audio)
+	vector<pair<long int, long int>> pinned_ranges = final_cache.GetPinnedRanges();
+	final_cache.Clear();
+	missing_frames.Clear();
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+
+		// Start the hints not fully decoded yet over
+		for (vector<PrefetchHint>::iterator itr = prefetch_hints.begin(); itr != prefetch_hints.end(); ++itr)
+			itr->next = itr->start;
+
+		// Hint the ranges decoded already again (the hint of a range is dropped once it is decoded)
+		for (size_t index = 0; index < pinned_ranges.size(); index++)
+		{
+			bool is_hinted = false;
+			for (vector<PrefetchHint>::iterator itr = prefetch_hints.begin(); itr != prefetch_hints.end() && !is_hinted; ++itr)
+				is_hinted = itr->start == pinned_ranges[index].first && itr->end == pinned_ranges[index].second;
+
+			if (!is_hinted)
+			{
+				PrefetchHint hint = { pinned_ranges[index].first, pinned_ranges[index].second, pinned_ranges[index].first, REQUEST_PREFETCH };
+				prefetch_hints.push_back(hint);
+			}
+		}
+	}
+
+	// Nothing was decoded yet
+	if (last_frame == 0 && largest_frame_processed == 0 && !is_seeking)
+		return;
+
+	// Start the stream over before the requested frame, so its audio is decoded from the start (or from the start of
+	// the file, to find the PTS offset of the first audio packet)
+	if (audio_pts_offset == 99999 || !enable_seek)
+		Seek(1);
+	else
+		Seek(requested_frame);
+}
+
+// Need the audio skipped by a low latency open
+void FFmpegReader::RequestAudio()
 {
-	int found_packet = 0;
-	AVPacket *next_packet = new AVPacket();
-	found_packet = av_read_frame(pFormatCtx, next_packet);
+	is_audio_requested = true;
+}
 
-	if (packet)
-	{
-		// Remove previous packet before getting next one
-		RemoveAVPacket(packet);
-		packet = NULL;
-	}
+// Give back the decoder threads of the video codec
+void FFmpegReader::ReleaseDecoderThreads()
+{
+	if (video_decoder_threads > 0)
+		DecoderThreadBudget::Global().Release(video_decoder_workload, video_decoder_threads);
+
+	video_decoder_threads = 0;
+	video_decoder_workload = 0;
+}
+
+// Allocate the packet, frames and scratch buffers reused by every packet
+void FFmpegReader::AllocateDecodeObjects()
+{
+	packet = av_packet_alloc();
+	pFrame = AV_ALLOCATE_FRAME();
+	aFrame = AV_ALLOCATE_FRAME();
+	if (packet == NULL || pFrame == NULL || aFrame == NULL)
+		throw std::bad_alloc();
+}
+
+// Free the packet, frames and scratch buffers
+void FFmpegReader::FreeDecodeObjects()
+{
+	av_packet_free(&packet);
+	AV_FREE_FRAME(&pFrame);
+	AV_FREE_FRAME(&aFrame);
+
+	// Free the scaler contexts
+	sws_freeContext(img_convert_ctx);
+	img_convert_ctx = NULL;
+	for (size_t i = 0; i < slice_convert_ctx.size(); i++)
+		sws_freeContext(slice_convert_ctx[i]);
+	slice_convert_ctx.clear();
 
-	if (found_packet >= 0)
+	// Free the resample context
+	if (avr)
 	{
-		// Update current packet pointer
-		packet = next_packet;
+		avresample_close(avr);
+		avresample_free(&avr);
 	}
+	avr_sample_fmt = -1;
+	avr_channel_layout = 0;
+
+	// Free the converted audio samples
+	av_freep(&audio_converted_data[0]);
+	audio_converted_linesize = 0;
+	audio_converted_capacity = 0;
+
+	// Release the channel buffers
+	audio_channel_buffers.setSize(0, 0);
+	audio_interleaved_buffer.setSize(0, 0);
+}
+
+// Get the next packet (if any)
+int FFmpegReader::GetNextPacket()
+{
+	// Remove previous packet before getting next one (the packet object itself is reused)
+	RemoveAVPacket(packet);
 
 	// Return if packet was found (or error number)
-	return found_packet;
+	return av_read_frame(pFormatCtx, packet);
 }
 
-// Remove AVPacket from cache (and deallocate it's memory)
+// Release the data of an AVPacket (the packet object itself is reused)
 void FFmpegReader::RemoveAVPacket(AVPacket* remove_packet)
 {
 	// deallocate memory for packet
-	AV_FREE_PACKET(remove_packet);
-
-	// Delete the object
-	delete remove_packet;
+	if (remove_packet)
+		AV_FREE_PACKET(remove_packet);
 }
 
-// Remove AVFrame from cache (and deallocate it's memory)
-void FFmpegReader::RemoveAVFrame(AVPicture* remove_frame)
+// Release the data of an AVFrame (the frame object itself is reused)
+void FFmpegReader::RemoveAVFrame(AVFrame* remove_frame)
 {
-	// Remove pFrame (if exists)
+	// Unreference pFrame (if exists)
 	if (remove_frame)
-	{
-		// Free memory
-		avpicture_free(remove_frame);
-
-		// Delete the object
-		delete remove_frame;
-	}
+		AV_RESET_FRAME(remove_frame);
 }
 
 // Get an AVFrame (if any)
@@ -979,35 +2201,27 @@ bool FFmpegReader::GetAVFrame()
 {
 	int frameFinished = -1;
 
-	// Decode video frame
-	AVFrame *next_frame = AV_ALLOCATE_FRAME();
-	avcodec_decode_video2(pCodecCtx, next_frame, &frameFinished, packet);
+	// Decode video frame. The decoded frame is only valid until the next decode call, but
+	// ProcessVideoPacket converts it right away, so there is no need to copy the picture.
+	avcodec_decode_video2(pCodecCtx, pFrame, &frameFinished, packet);
 
 	// is frame finished
 	if (frameFinished)
 	{
-		// AVFrames are clobbered on the each call to avcodec_decode_video, so we
-		// must make a copy of the image data before this method is called again.
-		pFrame = new AVPicture();
-		avpicture_alloc(pFrame, pCodecCtx->pix_fmt, info.width, info.height);
-		av_picture_copy(pFrame, (AVPicture *)next_frame, pCodecCtx->pix_fmt, info.width, info.height);
-
 		// this need for the scene dection so include it for frame details
-		picture_type = next_frame->pict_type;
-		// next_frame->metadata
+		picture_type = pFrame->pict_type;
+		// pFrame->metadata
 
 		// Detect interlaced frame (only once)
 		if (!check_interlace)
 		{
+			std::lock_guard<std::mutex> lock(info_mutex);
 			check_interlace = true;
-			info.interlaced_frame = next_frame->interlaced_frame;
-			info.top_field_first = next_frame->top_field_first;
+			info.interlaced_frame = pFrame->interlaced_frame;
+			info.top_field_first = pFrame->top_field_first;
 		}
 	}
 
-	// deallocate the frame
-	AV_FREE_FRAME(&next_frame);
-
 	// Did we get a video frame?
 	return frameFinished;
 }
@@ -1044,6 +2258,9 @@ void FFmpegReader::UpdatePTSOffset(bool is_video)
 		{
 			// Find the difference between PTS and frame number (no more than 10 timebase units allowed)
 			video_pts_offset = 0 - max(GetVideoPTS(), (long)info.video_timebase.ToInt() * 10);
+
+			// Remember it for the next time this file is opened
+			StoreSnapshot();
 		}
 	}
 	else
@@ -1053,6 +2270,9 @@ void FFmpegReader::UpdatePTSOffset(bool is_video)
 		{
 			// Find the difference between PTS and frame number (no more than 10 timebase units allowed)
 			audio_pts_offset = 0 - max(packet->pts, (int64_t)info.audio_timebase.ToInt() * 10);
+
+			// Remember it for the next time this file is opened
+			StoreSnapshot();
 		}
 	}
 }
@@ -1062,7 +2282,7 @@ long int FFmpegReader::GetVideoPTS()
 {
 	long int current_pts = 0;
 	if (packet->dts != AV_NOPTS_VALUE)
-		current_pts = packet->dts;
+		current_pts = packet->dts - video_decoder_delay;
 
 	// Return adjusted PTS
 	return current_pts;
@@ -1116,7 +2336,7 @@ AudioLocation FFmpegReader::GetAudioPTSLocation(long int pts)
 		}
 		else
 		{
-			//std::lock_guard<std::mutex> lock(processing_mutex);
+			std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 			for (long int audio_frame = previous_packet_location.frame; audio_frame < location.frame; audio_frame++)
 			{
@@ -1136,6 +2356,44 @@ AudioLocation FFmpegReader::GetAudioPTSLocation(long int pts)
 }
 
 // Seek to a specific frame.  This is not always frame accurate, it's more of an estimation on many codecs.
+// Check if the input can seek (pipes and live streams can only be read once)
+bool FFmpegReader::IsSeekable()
+{
+	if (pFormatCtx->pb)
+		return (pFormatCtx->pb->seekable & AVIO_SEEKABLE_NORMAL) != 0;
+
+	// Formats without a byte stream (i.e. image sequences, devices) seek on their own, if they can
+	return pFormatCtx->iformat->read_seek != NULL || pFormatCtx->iformat->read_seek2 != NULL;
+}
+
+// Return to the start of the file, without closing it (the probed info, the PTS offsets and the final cache are kept)
+bool FFmpegReader::Rewind()
+{
+	if (!IsSeekable())
+		return false;
+
+	// Seek every stream to the start time of the file
+	int64_t start_time = pFormatCtx->start_time != AV_NOPTS_VALUE ? pFormatCtx->start_time : 0;
+	if (avformat_seek_file(pFormatCtx, -1, INT64_MIN, start_time, start_time, 0) < 0)
+	{
+		fprintf(stderr, "%s: error while rewinding\n", pFormatCtx->filename);
+		return false;
+	}
+
+	// Drop the frames buffered by the decoders
+	if (info.has_audio && avcodec_is_open(aCodecCtx))
+		avcodec_flush_buffers(aCodecCtx);
+
+	if (info.has_video && avcodec_is_open(pCodecCtx))
+		avcodec_flush_buffers(pCodecCtx);
+
+	// Reset previous audio location to zero
+	previous_packet_location.frame = -1;
+	previous_packet_location.sample_start = 0;
+
+	return true;
+}
+
 void FFmpegReader::Seek(long int requested_frame)
 {
 	// Adjust for a requested frame that is too small or too large
@@ -1148,7 +2406,7 @@ void FFmpegReader::Seek(long int requested_frame)
 	int processing_video_frames_size = 0;
 	int processing_audio_frames_size = 0;
 	{
-		//std::lock_guard<std::mutex> lock(processing_mutex);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 		processing_video_frames_size = processing_video_frames.size();
 		processing_audio_frames_size = processing_audio_frames.size();
 	}
@@ -1157,7 +2415,7 @@ void FFmpegReader::Seek(long int requested_frame)
 	while (processing_video_frames_size + processing_audio_frames_size > 0)
 	{
 		std::this_thread::sleep_for(2.5s);
-		//std::lock_guard<std::mutex> lock(processing_mutex);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 		processing_video_frames_size = processing_video_frames.size();
 		processing_audio_frames_size = processing_audio_frames.size();
 	}
@@ -1166,9 +2424,16 @@ void FFmpegReader::Seek(long int requested_frame)
 	working_cache.Clear();
 	missing_frames.Clear();
 
+	// Drop the frame a stopped request didn't convert (it is from before the seek)
+	if (is_conversion_pending)
+	{
+		is_conversion_pending = false;
+		RemoveAVFrame(pFrame);
+	}
+
 	// Clear processed lists
 	{
-		//std::lock_guard<std::mutex> lock(processing_mutex);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 		processing_audio_frames.clear();
 		processing_video_frames.clear();
 		processed_video_frames.clear();
@@ -1191,17 +2456,21 @@ void FFmpegReader::Seek(long int requested_frame)
 	// Increment seek count
 	seek_count++;
 
-	// If seeking near frame 1, we need to close and re-open the file (this is more reliable than seeking)
+	// If seeking near frame 1, start the file over (this is more reliable than seeking to a keyframe near the start)
 	int buffer_amount = 6;
 	if (requested_frame - buffer_amount < 20)
 	{
-		// Close and re-open file (basically seeking to frame 1)
-		Close();
-		Open();
+		// Rewind the file (only inputs which can't seek are closed and re-opened, which probes them again)
+		if (!Rewind())
+		{
+			Close();
+			Open();
 
-		// Update overrides (since closing and re-opening might update these)
-		info.has_audio = has_audio_override;
-		info.has_video = has_video_override;
+			// Update overrides (since closing and re-opening might update these)
+			std::lock_guard<std::mutex> lock(info_mutex);
+			info.has_audio = has_audio_override;
+			info.has_video = has_video_override;
+		}
 
 		// Not actually seeking, so clear these flags
 		is_seeking = false;
@@ -1256,11 +2525,11 @@ void FFmpegReader::Seek(long int requested_frame)
 		if (seek_worked)
 		{
 			// Flush audio buffer
-			if (info.has_audio)
+			if (info.has_audio && avcodec_is_open(aCodecCtx))
 				avcodec_flush_buffers(aCodecCtx);
 
 			// Flush video buffer
-			if (info.has_video)
+			if (info.has_video && avcodec_is_open(pCodecCtx))
 				avcodec_flush_buffers(pCodecCtx);
 
 			// Reset previous audio location to zero
@@ -1295,6 +2564,7 @@ void FFmpegReader::Seek(long int requested_frame)
 			Open();
 
 			// Update overrides (since closing and re-opening might update these)
+			std::lock_guard<std::mutex> lock(info_mutex);
 			info.has_audio = has_audio_override;
 			info.has_video = has_video_override;
 		}
@@ -1312,8 +2582,8 @@ bool FFmpegReader::CheckSeek(bool is_video)
 		if ((is_video_seek && !seek_video_frame_found) || (!is_video_seek && !seek_audio_frame_found))
 			return false;
 
-		// Check for both streams
-		if ((info.has_video && !seek_video_frame_found) || (info.has_audio && !seek_audio_frame_found))
+		// Check for both streams (the audio skipped by a low latency open is never found)
+		if ((info.has_video && !seek_video_frame_found) || (info.has_audio && !is_audio_deferred && !seek_audio_frame_found))
 			return false;
 
 		// Determine max seeked frame
@@ -1348,22 +2618,20 @@ void FFmpegReader::ProcessAudioPacket(long int requested_frame, long int target_
 		seek_audio_frame_found = target_frame;
 
 	// Are we close enough to decode the frame's audio?
-	if (target_frame < (requested_frame - 20))
+	if (target_frame < (requested_frame - GetSkipWindow()))
 	{
 		// Skip to next frame without decoding or caching
 		return;
 	}
 
-	// Init an AVFrame to hold the decoded audio samples
+	// Use the reader's AVFrame to hold the decoded audio samples
 	int frame_finished = 0;
-	AVFrame *audio_frame = AV_ALLOCATE_FRAME();
+	AVFrame *audio_frame = aFrame;
 	AV_RESET_FRAME(audio_frame);
 
 	int packet_samples = 0;
 	int data_size = 0;
 
-	// re-initialize buffer size (it gets changed in the avcodec_decode_audio2 method call)
-	int buf_size = AVCODEC_MAX_AUDIO_FRAME_SIZE + FF_INPUT_BUFFER_PADDING_SIZE;
 	int used = avcodec_decode_audio4(aCodecCtx, audio_frame, &frame_finished, packet);
 
 	if (frame_finished) 
@@ -1385,7 +2653,7 @@ void FFmpegReader::ProcessAudioPacket(long int requested_frame, long int target_
 
 	// Add audio frame to list of processing audio frames
 	{
-		//std::lock_guard<std::mutex> lock(processing_mutex);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 		processing_audio_frames.insert(pair<int, int>(previous_packet_location.frame, previous_packet_location.frame));
 	}
@@ -1411,7 +2679,7 @@ void FFmpegReader::ProcessAudioPacket(long int requested_frame, long int target_
 
 			// Add audio frame to list of processing audio frames
 			{
-				//std::lock_guard<std::mutex> lock(processing_mutex);
+				std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 				processing_audio_frames.insert(pair<int, int>(previous_packet_location.frame, previous_packet_location.frame));
 			}
@@ -1425,93 +2693,20 @@ void FFmpegReader::ProcessAudioPacket(long int requested_frame, long int target_
 	}
 
 
-	// Allocate audio buffer
-	int16_t *audio_buf = new int16_t[AVCODEC_MAX_AUDIO_FRAME_SIZE + FF_INPUT_BUFFER_PADDING_SIZE];
-
-	// Create output frame
-	AVFrame *audio_converted = AV_ALLOCATE_FRAME();
-	AV_RESET_FRAME(audio_converted);
-	audio_converted->nb_samples = audio_frame->nb_samples;
-	av_samples_alloc(audio_converted->data, audio_converted->linesize, info.channels, audio_frame->nb_samples, AV_SAMPLE_FMT_S16, 0);
-
-	AVAudioResampleContext *avr = NULL;
-	int nb_samples = 0;
-
-	// setup resample context
-	avr = avresample_alloc_context();
-	av_opt_set_int(avr, "in_channel_layout", aCodecCtx->channel_layout, 0);
-	av_opt_set_int(avr, "out_channel_layout", aCodecCtx->channel_layout, 0);
-	av_opt_set_int(avr, "in_sample_fmt", aCodecCtx->sample_fmt, 0);
-	av_opt_set_int(avr, "out_sample_fmt", AV_SAMPLE_FMT_S16, 0);
-	av_opt_set_int(avr, "in_sample_rate", info.sample_rate, 0);
-	av_opt_set_int(avr, "out_sample_rate", info.sample_rate, 0);
-	av_opt_set_int(avr, "in_channels", info.channels, 0);
-	av_opt_set_int(avr, "out_channels", info.channels, 0);
-	int r = avresample_open(avr);
-
-	// Convert audio samples
-	nb_samples = avresample_convert(avr, 	// audio resample context
-		audio_converted->data, 			// output data pointers
-		audio_converted->linesize[0], 	// output plane size, in bytes. (0 if unknown)
-		audio_converted->nb_samples,	// maximum number of samples that the output buffer can hold
-		audio_frame->data,				// input data pointers
-		audio_frame->linesize[0],		// input plane size, in bytes (0 if unknown)
-		audio_frame->nb_samples);		// number of input samples to convert
-
-										// Copy audio samples over original samples
-	memcpy(audio_buf, audio_converted->data[0], audio_converted->nb_samples * av_get_bytes_per_sample(AV_SAMPLE_FMT_S16) * info.channels);
-
-	// Deallocate resample buffer
-	avresample_close(avr);
-	avresample_free(&avr);
-	avr = NULL;
+	// Convert the samples to floats, with one buffer per channel (the allocation is kept between packets)
+	int channel_buffer_size = packet_samples / info.channels;
+	audio_channel_buffers.setSize(info.channels, channel_buffer_size, false, false, true);
 
-	// Free AVFrames
-	av_free(audio_converted->data[0]);
-	AV_FREE_FRAME(&audio_converted);
+	if (channel_buffer_size > 0)
+		ConvertAudioSamples(audio_frame, channel_buffer_size);
 
 	long int starting_frame_number = -1;
 	for (int channel_filter = 0; channel_filter < info.channels; channel_filter++)
 	{
 		// Array of floats (to hold samples for each channel)
 		starting_frame_number = target_frame;
-		int channel_buffer_size = packet_samples / info.channels;
-		float *channel_buffer = new float[channel_buffer_size];
-
-		// Init buffer array
-		for (int z = 0; z < channel_buffer_size; z++)
-			channel_buffer[z] = 0.0f;
-
-		// Loop through all samples and add them to our Frame based on channel.
-		// Toggle through each channel number, since channel data is stored like (left right left right)
-		int channel = 0;
-		int position = 0;
-		for (int sample = 0; sample < packet_samples; sample++)
-		{
-			// Only add samples for current channel
-			if (channel_filter == channel)
-			{
-				// Add sample (convert from (-32768 to 32768)  to (-1.0 to 1.0))
-				channel_buffer[position] = audio_buf[sample] * (1.0f / (1 << 15));
-
-				// Increment audio position
-				position++;
-			}
-
-			// increment channel (if needed)
-			if ((channel + 1) < info.channels)
-			{
-				// move to next channel
-				channel++;
-			}
-			else
-			{
-				// reset channel
-				channel = 0;
-			}
-		}
+		float *channel_buffer = audio_channel_buffers.getWritePointer(channel_filter);
 
-	
 		// Loop through samples, and add them to the correct frames
 		int start = starting_sample;
 		int remaining_samples = channel_buffer_size;
@@ -1550,19 +2745,12 @@ void FFmpegReader::ProcessAudioPacket(long int requested_frame, long int target_
 			start = 0;
 		}
 
-		// clear channel buffer
-		delete[] channel_buffer;
-		channel_buffer = NULL;
 		iterate_channel_buffer = NULL;
 	}
 
-	// Clean up some arrays
-	delete[] audio_buf;
-	audio_buf = NULL;
-
 	// Remove audio frame from list of processing audio frames
 	{
-		//std::lock_guard<std::mutex> lock(processing_mutex);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 		// Update all frames as completed
 		for (long int f = target_frame; f < starting_frame_number; f++) 
@@ -1587,14 +2775,145 @@ void FFmpegReader::ProcessAudioPacket(long int requested_frame, long int target_
 		}
 	}
 
-	// Free audio frame
-	AV_FREE_FRAME(&audio_frame);
+	// Release the decoded samples (the frame itself is reused)
+	RemoveAVFrame(audio_frame);
+
+}
+
+// Convert the decoded audio samples to floats (one buffer per channel)
+// Convert decoded samples to a float buffer per channel, for the sample formats which don't need avresample
+bool FFmpegReader::ConvertSampleFormat(const uint8_t * const *data, int sample_fmt, int channels, int nb_samples, float * const *channel_buffers, AudioSampleBuffer &interleaved_buffer)
+{
+	const float int16_scale = 1.0f / (1 << 15);
+	const float int32_scale = 1.0f / 2147483648.0f;
+	int total_samples = nb_samples * channels;
+
+	// Planar formats are converted plane by plane, and interleaved formats are converted and then split into the channels
+	switch (sample_fmt)
+	{
+	case AV_SAMPLE_FMT_S16P:
+		for (int channel = 0; channel < channels; channel++)
+			AudioConversion::Int16ToFloat(channel_buffers[channel], (const int16_t *)data[channel], int16_scale, nb_samples);
+		return true;
+
+	case AV_SAMPLE_FMT_S32P:
+		for (int channel = 0; channel < channels; channel++)
+			AudioConversion::Int32ToFloat(channel_buffers[channel], (const int32_t *)data[channel], int32_scale, nb_samples);
+		return true;
+
+	case AV_SAMPLE_FMT_FLTP:
+		for (int channel = 0; channel < channels; channel++)
+			AudioConversion::FloatToFloat(channel_buffers[channel], (const float *)data[channel], 1.0f, nb_samples);
+		return true;
+
+	case AV_SAMPLE_FMT_DBLP:
+		for (int channel = 0; channel < channels; channel++)
+			AudioConversion::DoubleToFloat(channel_buffers[channel], (const double *)data[channel], 1.0f, nb_samples);
+		return true;
+
+	case AV_SAMPLE_FMT_FLT:
+		AudioConversion::Deinterleave(channel_buffers, (const float *)data[0], channels, nb_samples);
+		return true;
+
+	case AV_SAMPLE_FMT_S16:
+	case AV_SAMPLE_FMT_S32:
+	case AV_SAMPLE_FMT_DBL:
+	{
+		interleaved_buffer.setSize(1, total_samples, false, false, true);
+		float *interleaved = interleaved_buffer.getWritePointer(0);
+
+		if (sample_fmt == AV_SAMPLE_FMT_S16)
+			AudioConversion::Int16ToFloat(interleaved, (const int16_t *)data[0], int16_scale, total_samples);
+		else if (sample_fmt == AV_SAMPLE_FMT_S32)
+			AudioConversion::Int32ToFloat(interleaved, (const int32_t *)data[0], int32_scale, total_samples);
+		else
+			AudioConversion::DoubleToFloat(interleaved, (const double *)data[0], 1.0f, total_samples);
+
+		AudioConversion::Deinterleave(channel_buffers, interleaved, channels, nb_samples);
+		return true;
+	}
+
+	default:
+		return false;
+	}
+}
+
+void FFmpegReader::ConvertAudioSamples(AVFrame *audio_frame, int nb_samples)
+{
+	float * const *channel_buffers = audio_channel_buffers.getArrayOfWritePointers();
+	const float int16_scale = 1.0f / (1 << 15);
+	int total_samples = nb_samples * info.channels;
+
+	// The common sample formats are converted directly
+	if (aCodecCtx->channels == info.channels &&
+		ConvertSampleFormat(audio_frame->extended_data, aCodecCtx->sample_fmt, info.channels, nb_samples, channel_buffers, audio_interleaved_buffer))
+		return;
+
+	// Any other format is resampled to S16 first
+
+	// Grow the converted sample buffer (if needed). It is kept between packets, so this only happens for the first packets.
+	if (audio_frame->nb_samples > audio_converted_capacity)
+	{
+		av_freep(&audio_converted_data[0]);
+		av_samples_alloc(audio_converted_data, &audio_converted_linesize, info.channels, audio_frame->nb_samples, AV_SAMPLE_FMT_S16, 0);
+		audio_converted_capacity = audio_frame->nb_samples;
+	}
+
+	// Setup the resample context (it is only re-created when the input format changes)
+	if (avr == NULL || avr_sample_fmt != aCodecCtx->sample_fmt || avr_channel_layout != (int64_t)aCodecCtx->channel_layout)
+	{
+		if (avr)
+		{
+			avresample_close(avr);
+			avresample_free(&avr);
+		}
+
+		avr = avresample_alloc_context();
+		av_opt_set_int(avr, "in_channel_layout", aCodecCtx->channel_layout, 0);
+		av_opt_set_int(avr, "out_channel_layout", aCodecCtx->channel_layout, 0);
+		av_opt_set_int(avr, "in_sample_fmt", aCodecCtx->sample_fmt, 0);
+		av_opt_set_int(avr, "out_sample_fmt", AV_SAMPLE_FMT_S16, 0);
+		av_opt_set_int(avr, "in_sample_rate", info.sample_rate, 0);
+		av_opt_set_int(avr, "out_sample_rate", info.sample_rate, 0);
+		av_opt_set_int(avr, "in_channels", info.channels, 0);
+		av_opt_set_int(avr, "out_channels", info.channels, 0);
+		avresample_open(avr);
+
+		avr_sample_fmt = aCodecCtx->sample_fmt;
+		avr_channel_layout = aCodecCtx->channel_layout;
+	}
+
+	// Convert audio samples
+	int converted_samples = avresample_convert(avr, 	// audio resample context
+		audio_converted_data, 			// output data pointers
+		audio_converted_linesize, 		// output plane size, in bytes. (0 if unknown)
+		audio_converted_capacity,		// maximum number of samples that the output buffer can hold
+		audio_frame->data,				// input data pointers
+		audio_frame->linesize[0],		// input plane size, in bytes (0 if unknown)
+		audio_frame->nb_samples);		// number of input samples to convert
+
+	// Missing samples (if any) are silent
+	if (converted_samples < nb_samples)
+	{
+		if (converted_samples < 0)
+			converted_samples = 0;
+
+		memset(audio_converted_data[0] + converted_samples * info.channels * sizeof(int16_t), 0, (nb_samples - converted_samples) * info.channels * sizeof(int16_t));
+	}
+
+	// Convert from (-32768 to 32768) to (-1.0 to 1.0), and split the channels
+	audio_interleaved_buffer.setSize(1, total_samples, false, false, true);
+	float *interleaved = audio_interleaved_buffer.getWritePointer(0);
 
+	AudioConversion::Int16ToFloat(interleaved, (const int16_t *)audio_converted_data[0], int16_scale, total_samples);
+	AudioConversion::Deinterleave(channel_buffers, interleaved, info.channels, nb_samples);
 }
 
 // Process a video packet
 void FFmpegReader::ProcessVideoPacket(long int requested_frame)
 {
+	decoded_video_frames++;
+
 	// Calculate current frame #
 	long int current_frame = ConvertVideoPTStoFrame(GetVideoPTS());
 
@@ -1602,8 +2921,13 @@ void FFmpegReader::ProcessVideoPacket(long int requested_frame)
 	if (!seek_video_frame_found && is_seeking)
 		seek_video_frame_found = current_frame;
 
+	// Keep track of the keyframes (the index of some files is missing or incomplete)
+	if (pFrame->key_frame && current_frame > 0)
+		cost_model.AddKeyframe(current_frame);
+
 	// Are we close enough to decode the frame? and is this frame # valid?
-	if ((current_frame < (requested_frame - 20)) || (current_frame == -1))
+	// (frames further back than the skip window are cheaper to seek back to, than to convert now)
+	if ((current_frame < (requested_frame - GetSkipWindow())) || (current_frame == -1))
 	{
 		// Remove frame and packet
 		RemoveAVFrame(pFrame);
@@ -1612,76 +2936,107 @@ void FFmpegReader::ProcessVideoPacket(long int requested_frame)
 		return;
 	}
 
+	std::chrono::steady_clock::time_point convert_started = std::chrono::steady_clock::now();
+
 	// Init some things local
 	PixelFormat pix_fmt = pCodecCtx->pix_fmt;
 	int height = info.height;
 	int width = info.width;
 	long int video_length = info.video_length;
-	AVPicture *my_frame = pFrame;
+	AVFrame *my_frame = pFrame;
 	int pict_type = picture_type;
 
-	// Add video frame to list of processing video frames
-	//std::lock_guard<std::mutex> lock(processing_mutex);
-
-	processing_video_frames[current_frame] = current_frame;
-
-	// Create variables for a RGB Frame (since most videos are not in RGB, we must convert it)
-	AVFrame *pFrameRGB = NULL;
-	int numBytes;
-	uint8_t *buffer = NULL;
-
-	// Allocate an AVFrame structure
-	pFrameRGB = AV_ALLOCATE_FRAME();
-	if (pFrameRGB == NULL)
-		throw OutOfBoundsFrame("Convert Image Broke!", current_frame, video_length);
-
 	// Determine if video needs to be scaled down (for performance reasons)
-	// Timelines pass their size to the clips, which pass their size to the readers (as max size)
-	// If a clip is being scaled larger, it will set max_width and max_height = 0 (which means don't down scale)
 	int original_height = height;
-	if (max_width != 0 && max_height != 0 && max_width < width && max_height < height)
+	GetOutputSize(width, height);
+
+	// Add video frame to list of processing video frames, and create or get the existing frame object
+	// (the lock isn't held during the conversion, which waits for the slices on the shared thread pool)
+	QSharedPointer<Frame> f;
 	{
-		// Override width and height (but maintain aspect ratio)
-		float ratio = float(width) / float(height);
-		int possible_width = round(max_height * ratio);
-		int possible_height = round(max_width / ratio);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
-		if (possible_width <= max_width)
-		{
-			// use calculated width, and max_height
-			width = possible_width;
-			height = max_height;
-		}
+		processing_video_frames[current_frame] = current_frame;
+		f = CreateFrame(current_frame);
+	}
+
+	// Write the pixels straight into the image plane of the frame's storage, or into a buffer of
+	// their own if the plane doesn't fit (i.e. the output size changed since the frame was created,
+	// or deduplication is enabled, so the buffer can be dropped if the image is a duplicate)
+	int stride = 0;
+	PixelBuffer *rgba_buffer = NULL;
+	unsigned char *rgba_pixels = f->GetStoragePixels(width, height, stride);
+	if (rgba_pixels == NULL)
+	{
+		stride = PixelBufferPool::GetAlignedStride(width, 4);
+		if (pixel_pool->GetBufferSize() >= (size_t)stride * height)
+			rgba_buffer = pixel_pool->Acquire();
 		else
-		{
-			// use max_width, and calculated height
-			width = max_width;
-			height = possible_height;
-		}
+			rgba_buffer = PixelBufferPool::AcquireUnpooled((size_t)stride * height);
+		rgba_pixels = rgba_buffer->data;
 	}
 
-	// Determine required buffer size and allocate buffer
-	numBytes = avpicture_get_size(PIX_FMT_RGBA, width, height);
+	// Point the RGBA plane directly at the buffer the frame's image will wrap (no intermediate copy)
+	uint8_t *rgba_data[4] = { rgba_pixels, NULL, NULL, NULL };
+	int rgba_linesize[4] = { stride, 0, 0, 0 };
 
-	buffer = (uint8_t *)av_malloc(numBytes * sizeof(uint8_t));
+	// Large images are split into slices of lines, which are converted in parallel on the shared thread pool
+	// (only when the size doesn't change: scaling is done in one pass, since it filters across the slices)
+	int slices = (width == info.width && height == original_height) ? GetSliceCount(width, height) : 1;
 
-	// Assign appropriate parts of buffer to image planes in pFrameRGB
-	// Note that pFrameRGB is an AVFrame, but AVFrame is a superset
-	// of AVPicture
-	avpicture_fill((AVPicture *)pFrameRGB, buffer, PIX_FMT_RGBA, width, height);
+	// Convert the common YUV formats with the built-in converter, when the size doesn't change
+	YuvImage yuv_image;
+	if (GetYuvImage(my_frame, width, height, yuv_image))
+	{
+		ThreadPool::Global().ParallelFor(slices, [&](int slice) {
+			int first_line = GetSliceStart(slice, slices, height);
+			YuvConverter::Convert(yuv_image, rgba_pixels, stride, first_line, GetSliceStart(slice + 1, slices, height) - first_line);
+		});
+	}
+	else if (slices > 1 && CanSliceFormat(pix_fmt))
+	{
+		ConvertSlices(my_frame, slices, rgba_pixels, stride, slice_convert_ctx);
+	}
+	else
+	{
+		// Reuse the scaler context (it is only re-created when the output size or format changes)
+		img_convert_ctx = sws_getCachedContext(img_convert_ctx, info.width, info.height, pCodecCtx->pix_fmt, width,
+			height, PIX_FMT_RGBA, SWS_BILINEAR, NULL, NULL, NULL);
+
+		// Resize / Convert to RGB
+		sws_scale(img_convert_ctx, my_frame->data, my_frame->linesize, 0,
+			original_height, rgba_data, rgba_linesize);
+	}
 
-	SwsContext *img_convert_ctx = sws_getContext(info.width, info.height, pCodecCtx->pix_fmt, width,
-		height, PIX_FMT_RGBA, SWS_BILINEAR, NULL, NULL, NULL);
+	// Check if this image is identical to the previous one (the hash is only a quick filter, the pixels are compared to confirm)
+	bool is_duplicate = false;
+	if (enable_frame_dedup && rgba_buffer)
+	{
+		uint64_t hash = PixelOperations::Hash(rgba_pixels, width * 4, height, stride);
 
-	// Resize / Convert to RGB
-	sws_scale(img_convert_ctx, my_frame->data, my_frame->linesize, 0,
-		original_height, pFrameRGB->data, pFrameRGB->linesize);
+		if (last_video_frame && hash == last_video_hash && last_video_frame->GetWidth() == width && last_video_frame->GetHeight() == height)
+		{
+			QSharedPointer<QImage> last_image = last_video_frame->GetImage();
+			is_duplicate = last_image->format() == QImage::Format_RGBA8888 &&
+				PixelOperations::Equal(rgba_pixels, stride, last_image->constBits(), last_image->bytesPerLine(), width * 4, height);
+		}
 
-	// Create or get the existing frame object
-	QSharedPointer<Frame> f = CreateFrame(current_frame);
+		last_video_hash = hash;
+	}
 
-	// Add Image data to frame
-	f->AddImage(width, height, 4, QImage::Format_RGBA8888, buffer);
+	if (is_duplicate)
+	{
+		// Share the pixels of the previous frame, and recycle the buffer
+		f->AddImage(QSharedPointer<QImage>::create(*last_video_frame->GetImage()));
+		PixelBufferPool::Release(rgba_buffer);
+	}
+	else if (rgba_buffer)
+	{
+		// Wrap the pixels with the frame's image (the buffer is released when the image is deleted)
+		f->AddImage(width, height, stride, QImage::Format_RGBA8888, rgba_buffer);
+	}
+	else
+		f->AddStorageImage(QImage::Format_RGBA8888);
 
 	// Set the picture type for the frame. Eg: The frame type
 	f->SetPictureType(pict_type);
@@ -1692,21 +3047,147 @@ void FFmpegReader::ProcessVideoPacket(long int requested_frame)
 	// Keep track of last last_video_frame
 	last_video_frame = f;
 
-	// Free the RGB image
-	av_free(buffer);
-	AV_FREE_FRAME(&pFrameRGB);
-
 	// Remove frame and packet
 	RemoveAVFrame(my_frame);
-	sws_freeContext(img_convert_ctx);
 
 	// Remove video frame from list of processing video frames
 	{
-		//std::lock_guard<std::mutex> lock(processing_mutex);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 
 		processing_video_frames.erase(current_frame);
 		processed_video_frames[current_frame] = current_frame;
 	}
+
+	cost_model.AddConvertTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - convert_started).count());
+}
+
+// Get the number of slices to split the conversion of an image into (1 for small images)
+int FFmpegReader::GetSliceCount(int width, int height)
+{
+	// Each slice needs enough pixels to pay for handing it to another thread
+	int slices = (int)(((int64_t)width * height) / MinSlicePixels);
+
+	return std::max(1, std::min(slices, std::min(ThreadPool::Global().GetThreadCount() + 1, height / SliceLineAlignment)));
+}
+
+// Get the first line of a slice (slices start on a multiple of SliceLineAlignment, so subsampled chroma lines are not split)
+int FFmpegReader::GetSliceStart(int slice, int slices, int height)
+{
+	if (slice >= slices)
+		return height;
+
+	return (int)(((int64_t)height * slice / slices) & ~(int64_t)(SliceLineAlignment - 1));
+}
+
+// Check if a pixel format converts the same in slices as in one pass
+bool FFmpegReader::CanSliceFormat(PixelFormat pix_fmt)
+{
+	const AVPixFmtDescriptor *descriptor = av_pix_fmt_desc_get(pix_fmt);
+
+	// Without vertical chroma subsampling, sws_scale doesn't filter across lines when the size doesn't change
+	return descriptor != NULL && !(descriptor->flags & AV_PIX_FMT_FLAG_HWACCEL) && descriptor->log2_chroma_h == 0;
+}
+
+// Convert a decoded frame to RGBA in slices of lines, in parallel on the shared thread pool
+void FFmpegReader::ConvertSlices(const AVFrame *frame, int slices, uint8_t *rgba_pixels, int stride, std::vector<SwsContext*> &contexts)
+{
+	PixelFormat pix_fmt = (PixelFormat)frame->format;
+	int width = frame->width;
+	int height = frame->height;
+	int planes = av_pix_fmt_count_planes(pix_fmt);
+	int rgba_linesize[4] = { stride, 0, 0, 0 };
+
+	// Each slice has a scaler context of its own
+	if ((int)contexts.size() < slices)
+		contexts.resize(slices, NULL);
+
+	ThreadPool::Global().ParallelFor(slices, [&](int slice) {
+		int first_line = GetSliceStart(slice, slices, height);
+		int line_count = GetSliceStart(slice + 1, slices, height) - first_line;
+
+		// Point each plane at the first line of the slice (the palette of paletted formats stays as it is)
+		const uint8_t *slice_data[AV_NUM_DATA_POINTERS];
+		for (int plane = 0; plane < AV_NUM_DATA_POINTERS; plane++)
+			slice_data[plane] = (plane < planes) ? frame->data[plane] + (ptrdiff_t)first_line * frame->linesize[plane] : frame->data[plane];
+		uint8_t *slice_rgba_data[4] = { rgba_pixels + (size_t)first_line * stride, NULL, NULL, NULL };
+
+		contexts[slice] = sws_getCachedContext(contexts[slice], width, line_count, pix_fmt, width,
+			line_count, PIX_FMT_RGBA, SWS_BILINEAR, NULL, NULL, NULL);
+
+		sws_scale(contexts[slice], slice_data, frame->linesize, 0,
+			line_count, slice_rgba_data, rgba_linesize);
+	});
+}
+
+// Describe a decoded frame for the built-in YUV converter (returns false if sws_scale is needed)
+bool FFmpegReader::GetYuvImage(AVFrame *frame, int width, int height, YuvImage &image)
+{
+	// The built-in converter doesn't scale, and needs AVX2
+	if (!enable_yuv_converter || frame->width != width || frame->height != height || !YuvConverter::IsSupported())
+		return false;
+
+	image.range = YUV_RANGE_LIMITED;
+	switch (frame->format)
+	{
+	case AV_PIX_FMT_YUVJ420P:
+		image.range = YUV_RANGE_FULL;
+		// fall through
+	case AV_PIX_FMT_YUV420P:
+		image.layout = YUV_LAYOUT_420P;
+		image.bit_depth = 8;
+		break;
+	case AV_PIX_FMT_YUVJ422P:
+		image.range = YUV_RANGE_FULL;
+		// fall through
+	case AV_PIX_FMT_YUV422P:
+		image.layout = YUV_LAYOUT_422P;
+		image.bit_depth = 8;
+		break;
+	case AV_PIX_FMT_NV12:
+		image.layout = YUV_LAYOUT_NV12;
+		image.bit_depth = 8;
+		break;
+	case AV_PIX_FMT_YUV420P10LE:
+		image.layout = YUV_LAYOUT_420P;
+		image.bit_depth = 10;
+		break;
+	case AV_PIX_FMT_YUV422P10LE:
+		image.layout = YUV_LAYOUT_422P;
+		image.bit_depth = 10;
+		break;
+	default:
+		return false;
+	}
+
+	if (frame->color_range == AVCOL_RANGE_JPEG)
+		image.range = YUV_RANGE_FULL;
+
+	switch (frame->colorspace)
+	{
+	case AVCOL_SPC_BT709:
+		image.matrix = YUV_MATRIX_BT709;
+		break;
+	case AVCOL_SPC_BT470BG:
+	case AVCOL_SPC_SMPTE170M:
+	case AVCOL_SPC_FCC:
+	case AVCOL_SPC_UNSPECIFIED:
+		// Untagged video uses BT.601, like sws_scale (so the colors don't change when the converter is enabled)
+		image.matrix = YUV_MATRIX_BT601;
+		break;
+	default:
+		// Other matrices (i.e. BT.2020) are left to sws_scale
+		return false;
+	}
+
+	image.width = width;
+	image.height = height;
+	for (int plane = 0; plane < 3; plane++)
+	{
+		image.planes[plane] = frame->data[plane];
+		image.strides[plane] = frame->linesize[plane];
+	}
+
+	return true;
 }
 
 // Convert PTS into Frame Number
@@ -1743,7 +3224,7 @@ long int FFmpegReader::ConvertVideoPTStoFrame(long int pts)
 
 		// Sometimes frames are missing due to varying timestamps, or they were dropped. 
 		// Determine if we are missing a video frame.
-		//std::lock_guard<std::mutex> lock(processing_mutex);
+		std::lock_guard<std::recursive_mutex> lock(processing_mutex);
 		while (current_video_frame < frame)
 		{
 			if (!missing_video_frames.count(current_video_frame))
@@ -1790,16 +3271,57 @@ long int FFmpegReader::ConvertFrameToAudioPTS(long int frame_number)
 }
 
 // Create a new Frame (or return an existing one) and add it to the working queue.
-QSharedPointer<Frame> FFmpegReader::CreateFrame(long int requested_frame)
+QSharedPointer<Frame> FFmpegReader::CreateFrame(long int requested_frame, bool with_image_plane)
 {
 	// Check working cache
 	QSharedPointer<Frame> output = working_cache.GetFrame(requested_frame);
 	if (!output)
 	{
-		int samples_per_frame = Frame::GetSamplesPerFrame(requested_frame, info.fps, info.sample_rate, info.channels);
+		// Frames of readers without audio (or with it disabled) have no audio channels
+		int samples_per_frame = 0;
+		if (info.has_audio)
+			samples_per_frame = Frame::GetSamplesPerFrame(requested_frame, info.fps, info.sample_rate, info.channels);
+
+		// Lay the frame out in a single buffer: the image plane (at the output size), followed by the audio channels
+		// (frames of readers without video have no image plane, and a 1x1 size, like the audio frames of Frame)
+		int width = 1;
+		int height = 1;
+		int stride = 0;
+		if (info.has_video)
+		{
+			width = info.width;
+			height = info.height;
+			GetOutputSize(width, height);
+			stride = PixelBufferPool::GetAlignedStride(width, 4);
+		}
+
+		// Size the pool for the longest frame (the # of samples per frame varies slightly)
+		int max_samples_per_frame = samples_per_frame;
+		if (info.has_audio)
+			max_samples_per_frame = max(samples_per_frame, (int)ceil(info.sample_rate * info.fps.Reciprocal().ToDouble()) + info.channels);
+
+		size_t storage_size = Frame::GetStorageSize(stride, height, max_samples_per_frame, info.channels);
+		if (pixel_pool->GetBufferSize() != storage_size)
+			pixel_pool->SetBufferSize(storage_size);
+
+		// Frames which share the image of another frame only need room for their audio (with deduplication
+		// enabled, any frame can end up sharing the image of the previous one), which comes from a pool of its
+		// own, so filling a gap or repeating a still image doesn't allocate
+		PixelBuffer *storage = NULL;
+		if ((with_image_plane && !enable_frame_dedup) || stride == 0)
+			storage = pixel_pool->Acquire();
+		else
+		{
+			size_t audio_storage_size = Frame::GetStorageSize(0, 0, max_samples_per_frame, info.channels);
+			if (audio_pool->GetBufferSize() != audio_storage_size)
+				audio_pool->SetBufferSize(audio_storage_size);
+
+			stride = 0;
+			storage = audio_pool->Acquire();
+		}
 
-		// Create a new frame on the working cache
-		output = QSharedPointer<Frame>(new Frame(requested_frame, info.width, info.height, "#000000", samples_per_frame, info.channels));
+		// Create a new frame on the working cache (the frame and its reference count share one allocation)
+		output = QSharedPointer<Frame>::create(requested_frame, width, height, stride, samples_per_frame, info.channels, storage);
 		// update pixel ratio
 		output->SetPixelRatio(info.pixel_ratio.num, info.pixel_ratio.den);
 		// update audio channel layout from the parent reader
@@ -1819,6 +3341,33 @@ QSharedPointer<Frame> FFmpegReader::CreateFrame(long int requested_frame)
 	// Return new frame
 	return output;
 }
+
+// Determine the size of the decoded images (video is scaled down to the max size, if any)
+void FFmpegReader::GetOutputSize(int &width, int &height)
+{
+	// Timelines pass their size to the clips, which pass their size to the readers (as max size)
+	// If a clip is being scaled larger, it will set max_width and max_height = 0 (which means don't down scale)
+	if (max_width != 0 && max_height != 0 && max_width < width && max_height < height)
+	{
+		// Override width and height (but maintain aspect ratio)
+		float ratio = float(width) / float(height);
+		int possible_width = round(max_height * ratio);
+		int possible_height = round(max_width / ratio);
+
+		if (possible_width <= max_width)
+		{
+			// use calculated width, and max_height
+			width = possible_width;
+			height = max_height;
+		}
+		else
+		{
+			// use max_width, and calculated height
+			width = max_width;
+			height = possible_height;
+		}
+	}
+}
 /*
 =============================================================
 Copyright Venatio Studios 2019
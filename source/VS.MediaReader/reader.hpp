@@ -14,6 +14,7 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <functional>
 
 // FFmpeg Setup
 #include "utilities.hpp"
@@ -23,12 +24,31 @@
 #include "fraction.hpp"
 #include "cache.hpp"
 #include "frame.hpp"
+#include "pixel_operations.hpp"
+#include "audio_conversion.hpp"
+#include "yuv_converter.hpp"
+#include "thread_pool.hpp"
+#include "decoder_thread_budget.hpp"
+#include "request_scheduler.hpp"
+#include "request_token.hpp"
+#include "seek_cost_model.hpp"
+#include "access_pattern_detector.hpp"
+#include "media_info_cache.hpp"
 
 using namespace std;
 using namespace vs;
 
 namespace vs
 {
+	/// @brief The result of FFmpegReader::Scrub()
+	struct ScrubResult
+	{
+		QSharedPointer<Frame> frame;	///< The image to show (see frame->number for the frame it really is, NULL if none is cached near it)
+		bool is_approximate;			///< The frame is a nearby frame (or keyframe), and not the requested one
+		long int requested_frame;		///< The frame which was requested
+		uint64_t generation;			///< Increases with every Scrub() call (the latest one is the current one)
+	};
+
 	/// @brief This class uses the FFmpeg libraries, to open video files and audio files, and return
 	/// Frame objects for any frame in the file.
 	/// @remark All seeking and caching is handled internally, and the primary public interface is the GetFrame()
@@ -38,16 +58,29 @@ namespace vs
 	class FFmpegReader
 	{
 	private:
-		std::mutex processing_mutex;
-		std::mutex get_frames_mutex;
+		std::recursive_mutex processing_mutex;	///< Guards the lists of processing / processed / missing frames
+		std::mutex info_mutex;					///< Guards the writes to info (Open, and the decoding), and its reads by the requests before they decode
+
+		/// A frame being decoded by a request (other requests for the same or nearby frames wait for it)
+		struct FrameFlight
+		{
+			uint64_t id;
+			long int frame;
+			RequestPriority priority;
+		};
+
+		std::mutex flights_mutex;
+		std::condition_variable flight_finished;
+		std::vector<FrameFlight> flights;		///< The frames being decoded
+		uint64_t next_flight_id;
 
 		string path;
 
 		int max_width;
 		int max_height;
 
-		bool is_open;
-		bool is_duration_known;
+		std::atomic<bool> is_open;
+		std::atomic<bool> is_duration_known;
 		bool check_fps;
 		bool has_missing_frames;
 		bool check_interlace;
@@ -57,13 +90,70 @@ namespace vs
 		AVCodecContext *pCodecCtx, *aCodecCtx;
 		AVStream *pStream, *aStream;
 		AVPacket *packet;
-		AVPicture *pFrame;
+		AVFrame *pFrame;
 		int picture_type;
 
+		// Decode objects owned by the reader, and reused for every packet
+		AVFrame *aFrame;
+		SwsContext *img_convert_ctx;
+		std::vector<SwsContext*> slice_convert_ctx;	///< One scaler context per slice (see GetSliceCount)
+		AVAudioResampleContext *avr;
+		int avr_sample_fmt;
+		int64_t avr_channel_layout;
+		uint8_t *audio_converted_data[AV_NUM_DATA_POINTERS];
+		int audio_converted_linesize;
+		int audio_converted_capacity;
+		AudioSampleBuffer audio_channel_buffers;
+		AudioSampleBuffer audio_interleaved_buffer;
+
 		FrameCache working_cache;
 		FrameCache missing_frames;
 		FrameCache final_cache;
 
+		QSharedPointer<PixelBufferPool> pixel_pool;	///< Recycles the storage of frames (image plane + audio channels)
+		QSharedPointer<PixelBufferPool> audio_pool;	///< Recycles the storage of frames sharing the image of another frame (audio channels only)
+
+		RequestScheduler scheduler;			///< Decides which frame request decodes next
+		SeekCostModel cost_model;			///< Decides between walking and seeking to a frame
+		AccessPatternDetector access_pattern;	///< Classifies the requests, and picks the prefetch / seek strategy
+
+		std::mutex prefetch_mutex;
+		std::condition_variable prefetch_finished;
+		std::condition_variable prefetch_wake;	///< Wakes the prefetch thread (for a new task, or to end it)
+		bool is_prefetching;				///< A prefetch task is queued or running (only one at a time)
+		std::atomic<bool> cancel_prefetch;	///< Stops the prefetch task before its next frame
+		bool stop_prefetch_worker;			///< Ends the prefetch thread (when the reader is destroyed)
+		std::thread prefetch_worker;		///< Runs the prefetch task (started by the first prefetch)
+		std::thread::id prefetch_thread;	///< The thread running the prefetch task
+		RequestToken *prefetch_token;		///< The token of the frame being prefetched (cancelled by CancelPrefetch)
+
+		/// A range of frames passed to Prefetch()
+		struct PrefetchHint
+		{
+			long int start;
+			long int end;
+			long int next;					///< The next frame of the range to decode
+			RequestPriority priority;
+		};
+
+		std::vector<PrefetchHint> prefetch_hints;	///< The hinted ranges not fully decoded yet (guarded by prefetch_mutex)
+
+		std::mutex scrub_mutex;
+		std::condition_variable scrub_changed;
+		uint64_t scrub_generation;			///< The generation of the latest Scrub() call
+		uint64_t scrub_refined;				///< The last generation which needs no refinement (exact, or refined)
+		long int scrub_target;				///< The frame of the latest Scrub() call
+		std::function<void(const ScrubResult&)> scrub_callback;
+		bool is_refining;					///< The refinement task is queued or running (only one at a time)
+		bool cancel_refine;					///< Stops the refinement task
+		bool stop_refine_worker;			///< Ends the refinement thread (when the reader is destroyed)
+		std::thread refine_worker;			///< Runs the refinement task (started by the first Scrub() which needs it)
+		std::thread::id refine_thread;		///< The thread running the refinement task
+		RequestToken *refine_token;			///< The token of the frame being refined (cancelled by newer Scrub() calls)
+
+		int video_decoder_threads;			///< The threads taken from the DecoderThreadBudget by the video codec
+		int64_t video_decoder_workload;		///< The workload the threads were taken for
+
 		AudioLocation previous_packet_location;
 
 		map<long int, long int> processing_video_frames;
@@ -78,11 +168,12 @@ namespace vs
 
 		long int audio_pts_offset;
 		long int video_pts_offset;
-		long int last_frame;
+		std::atomic<long int> last_frame;		///< Atomic, since GetPosition() and CanWalkTo() read it from other threads
 		long int largest_frame_processed;
 		long int current_video_frame;
+		std::atomic<long long int> decoded_video_frames;	///< The video frames decoded since the reader was created
 
-		bool is_seeking;
+		std::atomic<bool> is_seeking;
 		long int seeking_pts;
 		long int seeking_frame;
 		bool is_video_seek;
@@ -91,16 +182,41 @@ namespace vs
 		long int seek_video_frame_found;
 
 		QSharedPointer<Frame> last_video_frame;
+		uint64_t last_video_hash;
 
 		// Internal methods
 		void UpdateAudioInfo();
 		void UpdateVideoInfo();
 
-		QSharedPointer<Frame> ReadStream(long int requested_frame);
+		QSharedPointer<Frame> ReadStream(long int requested_frame, ScheduledRequest &request);
 		bool CheckMissingFrame(long int requested_frame);
 		void CheckWorkingFrames(bool end_of_stream, long int requested_frame);
 		bool IsPartialFrame(long int requested_frame);
 
+		void LoadKeyframeIndex();
+
+		QString info_key;					///< The key of the file in the info_cache (empty if it isn't cached)
+		bool RestoreSnapshot(const MediaInfoSnapshot &snapshot);
+		bool OpenInput(MediaInfoSnapshot &snapshot);
+		void StoreSnapshot();
+		long int GetSkipWindow();
+
+		/// Clamp a frame number to the length of the file, if it is known (safe from any thread)
+		long int ClampToLength(long int frame_number);
+
+		QSharedPointer<Frame> ReadFrame(long int requested_frame, RequestPriority priority, RequestScheduler::Clock::time_point deadline, RequestToken *token = NULL);
+		QSharedPointer<Frame> StopRequest(long int requested_frame, RequestToken *token);
+		void SchedulePrefetch();
+		long int TakeHintFrame(RequestPriority &priority);
+		long int GetPatternFrame(set<long int> &attempted);
+		void RunPrefetchWorker();
+		void RunPrefetch(std::unique_lock<std::mutex> &lock);
+		void CancelPrefetch();
+
+		void RunScrubRefinementWorker();
+		void RunScrubRefinement(std::unique_lock<std::mutex> &lock);
+		void CancelScrubRefinement();
+
 		void UpdatePTSOffset(bool is_video);
 		long int GetVideoPTS();
 		int GetNextPacket();
@@ -111,18 +227,80 @@ namespace vs
 		long int ConvertFrameToAudioPTS(long int frame_number);
 		AudioLocation GetAudioPTSLocation(long int pts);
 
-		void RemoveAVFrame(AVPicture*);
+		void RemoveAVFrame(AVFrame*);
 		void RemoveAVPacket(AVPacket*);
 
-		QSharedPointer<Frame> CreateFrame(long int requested_frame);
+		static const int SingleFlightWindow = 8;	///< Requests this close to a frame being decoded wait for it
+		bool WaitForFlight(long int requested_frame, RequestPriority priority, RequestToken *token);
+		uint64_t BeginFlight(long int requested_frame, RequestPriority priority);
+		void EndFlight(uint64_t id);
+
+		void AcquireDecoderThreads(AVCodec *codec);
+		void ReleaseDecoderThreads();
+
+		bool is_decoder_upgrade_pending;	///< The video codec was opened on one thread by a low latency Open()
+		int64_t video_decoder_delay;		///< The DTS units the frame threads of the video codec delay its output by
+		int64_t GetVideoFrameDuration();
+		void OpenVideoCodec(bool single_threaded);
+		void OpenAudioCodec();
+		void UpgradeVideoDecoder(long int requested_frame);
+
+		bool is_conversion_pending;			///< A stopped request decoded the video frame of the packet, without converting it
+
+		std::atomic<bool> is_audio_deferred;	///< A low latency Open() skips the audio packets, until audio is needed
+		std::atomic<bool> is_audio_requested;	///< A request needs audio (the next decoding request resumes it)
+		void ResumeAudio(long int requested_frame);
+
+		void AllocateDecodeObjects();
+		void FreeDecodeObjects();
+
+		QSharedPointer<Frame> CreateFrame(long int requested_frame, bool with_image_plane = true);
+		void GetOutputSize(int &width, int &height);
 
 		void Seek(long int requested_frame);
+		bool IsSeekable();
+		bool Rewind();
 		bool CheckSeek(bool is_video);
 
 		void ProcessVideoPacket(long int requested_frame);
+		bool GetYuvImage(AVFrame *frame, int width, int height, YuvImage &image);
+
 		void ProcessAudioPacket(long int requested_frame, long int target_frame, int starting_sample);
+		void ConvertAudioSamples(AVFrame *audio_frame, int nb_samples);
 
 	public:
+		static const int64_t MinSlicePixels = 1 << 19;	///< The smallest slice worth converting on another thread
+		static const int SliceLineAlignment = 4;		///< Slices start on a multiple of this many lines
+
+		/// Get the number of slices to split the conversion of an image into (1 for small images)
+		static int GetSliceCount(int width, int height);
+
+		/// Get the first line of a slice (a multiple of SliceLineAlignment, or the height for the slice after the last)
+		static int GetSliceStart(int slice, int slices, int height);
+
+		/// @brief Check if a pixel format converts the same in slices as in one pass (see ConvertSlices)
+		/// @remark sws_scale interpolates vertically subsampled chroma (i.e. yuv420p) across the lines of its slice
+		/// only, so those formats are converted in one pass.
+		static bool CanSliceFormat(PixelFormat pix_fmt);
+
+		/// @brief Convert a decoded frame to RGBA (at the same size) in slices of lines, in parallel on the shared thread pool
+		/// @param frame	The decoded frame (its format must pass CanSliceFormat)
+		/// @param slices	The number of slices
+		/// @param rgba_pixels	The first line of the RGBA image
+		/// @param stride	The bytes of a line of the RGBA image
+		/// @param contexts	The scaler context of each slice (re-created only when the size or format changes)
+		static void ConvertSlices(const AVFrame *frame, int slices, uint8_t *rgba_pixels, int stride, std::vector<SwsContext*> &contexts);
+
+		/// @brief Convert decoded samples to a float buffer per channel (-1.0 to 1.0), for the sample formats which don't need avresample
+		/// @returns False if the format needs avresample (the buffers are left as they are)
+		/// @param data	The samples (a plane per channel for the planar formats)
+		/// @param sample_fmt	The AVSampleFormat of the samples
+		/// @param channels	The number of channels
+		/// @param nb_samples	The number of samples of each channel
+		/// @param channel_buffers	A buffer per channel, each with room for nb_samples
+		/// @param interleaved_buffer	The scratch buffer of the interleaved formats (only grows)
+		static bool ConvertSampleFormat(const uint8_t * const *data, int sample_fmt, int channels, int nb_samples, float * const *channel_buffers, AudioSampleBuffer &interleaved_buffer);
+
 		/// Constructor for FFmpegReader.
 		FFmpegReader(string filename);
 
@@ -138,28 +316,195 @@ namespace vs
 		/// artifacts or blank images into the video.
 		bool enable_seek;
 
+		/// @brief Enable or disable the deduplication of identical frames (disabled by default).
+		/// @remark Each decoded image is hashed and compared with the previous one, and duplicates share
+		/// the pixels of the previous frame instead of keeping a copy. This costs a pass over every image,
+		/// but screen recordings, slideshows and static shots take a fraction of the cache space.
+		bool enable_frame_dedup;
+
+		/// @brief Enable or disable the built-in YUV to RGBA converter (disabled by default).
+		/// @remark yuv420p, yuv422p, nv12 and their 10-bit / full range variants are converted with AVX2 kernels
+		/// when the size doesn't change. Other formats, scaled images and CPUs without AVX2 use sws_scale.
+		/// Unlike sws_scale (which always uses BT.601, and the range of the pixel format), the converter follows
+		/// the tags of the frames: BT.709 video and full range tags change the colors. Untagged video uses BT.601.
+		/// The converter is opt-in: it stays disabled by default until the YuvConverterMatchesSwscale test (which
+		/// checks its colors against sws_scale within a few levels) has passed on the machines it is enabled for.
+		bool enable_yuv_converter;
+
+		/// @brief Enable or disable the prefetching of the access pattern (enabled by default).
+		/// @remark The reader detects how its frames are requested (playback, reverse playback, sampling every Nth
+		/// frame, scrubbing or random access), and decodes the next frames of predictable patterns on a thread of the
+		/// reader, at REQUEST_PREFETCH priority. See GetAccessPattern() for the detected pattern and statistics.
+		/// The ranges passed to Prefetch() are decoded either way.
+		bool enable_prefetch;
+
+		/// @brief The most bytes of frames the ranges passed to Prefetch() can pin in the cache (512 MB by default, set
+		/// before Open())
+		/// @remark The pinned frames are kept on top of the frames of the cache, so this bounds the memory of a reader
+		/// (about 2.5 seconds of 1080p, or 15 frames of 4K, at 512 MB). 0 removes the limit.
+		long long int max_pinned_bytes;
+
+		/// @brief The most bytes read to probe the streams of the file (0 uses the default of FFmpeg, 5 MB)
+		/// @remark Smaller values open files faster, but some files (i.e. MPEG-TS with late streams) need more data.
+		int64_t probe_size;
+
+		/// @brief The longest duration analyzed to probe the streams of the file, in microseconds (0 uses the default of
+		/// FFmpeg, 5 seconds)
+		int64_t analyze_duration;
+
+		/// @brief Enable or disable the video stream (enabled by default, set before Open())
+		/// @remark A disabled stream is discarded by the demuxer (AVDISCARD_ALL), and its codec is never opened, so
+		/// an audio-only consumer reads a video file at demux speed. Without video, the frames have no image (and a
+		/// 1x1 size), and the audio is divided into the frames of the video stream, so the frame numbers still match.
+		bool enable_video;
+
+		/// @brief Enable or disable the audio stream (enabled by default, set before Open())
+		/// @remark A disabled stream is discarded by the demuxer (AVDISCARD_ALL), and its codec is never opened.
+		/// Without audio, the frames have no audio channels.
+		bool enable_audio;
+
+		/// @brief Open the file for the lowest time to the first frame (disabled by default)
+		/// @remark Open() only reads the container: the codecs are opened by the first packet of their stream. The
+		/// audio packets of a video file are skipped (the frames have silent audio) until audio is needed: see
+		/// RequestAudio(), which prefetch and analysis requests call for themselves. The first frames are decoded on
+		/// a single thread (which has less latency than a thread pool warming up), and the video codec is reopened
+		/// with its share of the decoder threads at the next keyframe (without a seek).
+		/// Meant for interactive previews (i.e. thumbnails, hovering over a clip), combined with a snapshot of the file.
+		bool low_latency_open;
+
+		/// @brief The snapshots of the files opened before (MediaInfoCache::Global() by default, NULL to always probe)
+		/// @remark Opening a file with a snapshot skips avformat_find_stream_info, and the first request doesn't need
+		/// to decode frame 1 to find the PTS offsets. Each Open() stores the snapshot of its file.
+		MediaInfoCache *info_cache;
+
+		/// @brief How long the playhead must rest on a frame (in milliseconds), before Scrub() decodes it exactly
+		/// (100 by default)
+		int scrub_refine_delay;
+
 		/// returns details of the media file.
 		MediaInfo info;
 
+		/// @brief Get a copy of the details of the media file (safe from any thread)
+		/// @remark The decoding can update the info (i.e. the interlacing, or a seek reopening the file), so use this
+		/// instead of the info struct, while another thread requests frames.
+		MediaInfo GetInfo();
+
 		/// Get the cache object used by this reader
 		FrameCache* GetCache() { return &final_cache; };
 
+		/// Get the cache object that holds the frames still being decoded
+		FrameCache* GetWorkingCache() { return &working_cache; };
+
+		/// Get the cache object that holds the source frames of missing frames
+		FrameCache* GetMissingCache() { return &missing_frames; };
+
 		/// Open File
 		void Open();
 
+		/// @brief Get the info of a file, without opening its codecs (or sizing caches)
+		/// @remark Only the container is read (as much as probe_size and analyze_duration allow), so this is much
+		/// cheaper than Open() for listing files (i.e. a media browser). The interlacing, which is only known once a
+		/// frame is decoded, is not detected. Files in MediaInfoCache::Global() aren't read at all.
+		/// @returns The info of the file
+		/// @param path	The path of the file
+		/// @param probe_size	The most bytes read to probe the streams (0 uses the default of FFmpeg)
+		/// @param analyze_duration	The longest duration analyzed to probe the streams, in microseconds (0 uses the default of FFmpeg)
+		static MediaInfo Probe(const string &path, int64_t probe_size = 0, int64_t analyze_duration = 0);
+
 		/// Close File
 		void Close();
 
+		/// @brief Decode the audio of a low latency open (see low_latency_open), from the next request on
+		/// @remark The frames decoded before have silent audio, so they are removed from the cache, and decoded again
+		/// when they are requested (the ranges passed to Prefetch() stay pinned, and are decoded again in the
+		/// background). Call this before playing a file opened for a preview (or before Open(), to never
+		/// skip the audio). The audio stays on until the reader is destroyed.
+		void RequestAudio();
+
 		/// Determine if reader is open or closed
 		bool IsOpen() { return is_open; };
 
 		/// Writes to std output the details of the media file.
 		void DisplayInfo();
 
+		/// Get the position of the decoder (the last frame it decoded, 0 before the first frame, safe from any thread)
+		long int GetPosition() { return last_frame; }
+
+		/// Get the number of video frames decoded since the reader was created (safe from any thread)
+		long long int GetDecodedVideoFrames() { return decoded_video_frames; }
+
+		/// @brief Check if a frame is reached sooner by decoding forward from the current position than by seeking
+		/// @remark The decision is made by the cost model (see GetCostModel), from the measured decode and seek times
+		/// and the distance from the requested frame to its keyframe.
+		bool CanWalkTo(long int requested_frame);
+
+		/// Get the cost model which decides between walking and seeking (i.e. to read its estimates)
+		SeekCostModel* GetCostModel() { return &cost_model; }
+
+		/// Get the detector of the access pattern (i.e. to read the pattern, its strategy and the statistics)
+		AccessPatternDetector* GetAccessPattern() { return &access_pattern; }
+
 		/// @brief Get a shared pointer to a openshot::Frame object for a specific frame number of this reader.
+		/// @remark This method is safe to call from several threads. Requests for the same (or nearby) frames are
+		/// merged: one request decodes, and the others wait for it and share the result.
 		/// @returns The requested frame of video
 		/// @param requested_frame	The frame number that is requested.
 		QSharedPointer<Frame> GetFrame(long int requested_frame);
+
+		/// @brief Get a shared pointer to a openshot::Frame object, with a priority class and a deadline.
+		/// @remark Requests which miss the cache decode one at a time: the most urgent class first, then the earliest
+		/// deadline. A request yields the decoder at the next packet when a more urgent class of request arrives
+		/// (i.e. the playhead preempts prefetch, thumbnail and analysis work), and resumes afterwards.
+		/// @returns The requested frame of video
+		/// @param requested_frame	The frame number that is requested.
+		/// @param priority	The priority class of the request (GetFrame(requested_frame) uses REQUEST_PLAYHEAD)
+		/// @param deadline	When the frame is needed by (orders the requests of the same class)
+		QSharedPointer<Frame> GetFrame(long int requested_frame, RequestPriority priority, RequestScheduler::Clock::time_point deadline = RequestScheduler::NoDeadline());
+
+		/// @brief Get an image for a frame right away, while scrubbing (refined to the exact frame later)
+		/// @remark Scrub() never decodes: if the frame isn't cached, the closest cached frame (within a GOP) is
+		/// returned, or else no frame, and the result is flagged as approximate. Once the playhead rests on the frame
+		/// for scrub_refine_delay, the exact frame is decoded in the background, and passed to the callback. Newer
+		/// Scrub() calls supersede the pending refinement.
+		/// @code
+		/// ScrubResult result = reader.Scrub(frame, [](const ScrubResult &refined) {
+		///     // Called on the refinement thread of the reader (only if refined.generation is still the latest)
+		/// });
+		/// @endcode
+		/// @returns The exact frame if it was cached, otherwise an approximate frame (or no frame)
+		/// @param requested_frame	The frame number under the playhead.
+		/// @param refined	Called with the exact frame, unless a newer Scrub() call superseded this one
+		ScrubResult Scrub(long int requested_frame, std::function<void(const ScrubResult&)> refined = nullptr);
+
+		/// @brief Get a shared pointer to a openshot::Frame object, which can be cancelled, and must return by a deadline.
+		/// @remark The token is checked while the request waits for the decoder (or for another request decoding the same
+		/// frames), and between packets. A request which is cancelled or late returns right away (without waiting for the
+		/// packets of a long GOP), with the closest cached frame or NULL, and the status of the token says why.
+		/// Real-time playback uses the deadline of each frame, and drops the frames which come back late.
+		/// @returns The requested frame of video (see token.GetStatus())
+		/// @param requested_frame	The frame number that is requested.
+		/// @param priority	The priority class of the request
+		/// @param token	Cancels the request, and bounds it with a deadline (which also orders the requests of the same class)
+		QSharedPointer<Frame> GetFrame(long int requested_frame, RequestPriority priority, RequestToken &token);
+
+		/// @brief Decode a range of frames in the background, and keep them cached until Evict() releases them
+		/// @remark Use this when the upcoming frames are known (i.e. the source ranges of the next edits of a timeline),
+		/// so they are ready before the playhead gets there. The ranges are decoded on a thread of the reader, the most
+		/// urgent priority first, and yield to the playhead requests like any other request of their priority. The
+		/// frames of the range are pinned in the cache (see FrameCache::Pin), up to max_pinned_bytes for all the
+		/// ranges: a range which doesn't fit is cut short, and only the part which fits is decoded.
+		/// @returns The last frame of the range which is pinned and decoded (start_frame - 1 if none of it fits, until
+		/// Evict() releases other ranges)
+		/// @param start_frame	The first frame of the range
+		/// @param end_frame	The last frame of the range
+		/// @param priority	The priority class of the decoding (REQUEST_PREFETCH by default)
+		long int Prefetch(long int start_frame, long int end_frame, RequestPriority priority = REQUEST_PREFETCH);
+
+		/// @brief Release a range passed to Prefetch() (stops decoding it, unpins it, and removes its frames from the cache)
+		/// @remark The frames of the range which another range still pins stay pinned, cached, and decoding.
+		/// @param start_frame	The first frame of the range
+		/// @param end_frame	The last frame of the range
+		void Evict(long int start_frame, long int end_frame);
 	};
 }
 
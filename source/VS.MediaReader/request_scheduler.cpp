@@ -0,0 +1,170 @@
+/*
+@file		request_scheduler.cpp
+@author		Webstar
+@date		2026-10-18 19:35
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <algorithm>
+#include <functional>
+
+#include "request_scheduler.hpp"
+
+using namespace std;
+using namespace vs;
+
+// How often a waiting request checks its token
+const int RequestScheduler::TokenCheckMilliseconds;
+
+// Constructor
+RequestScheduler::RequestScheduler()
+	: is_busy(false), holder_sequence(0), next_sequence(0)
+{
+	for (int i = 0; i < REQUEST_PRIORITY_COUNT; i++)
+		waiting_count[i] = 0;
+}
+
+// Check if a ticket goes before another one
+bool RequestScheduler::IsMoreUrgent(const Ticket &a, const Ticket &b)
+{
+	if (a.priority != b.priority)
+		return a.priority < b.priority;
+	if (a.deadline != b.deadline)
+		return a.deadline < b.deadline;
+	return a.sequence < b.sequence;
+}
+
+// Wait until the ticket is the most urgent one, and the decoder is free
+bool RequestScheduler::WaitForTurn(const Ticket &ticket, std::unique_lock<std::mutex> &lock, RequestToken *token)
+{
+	waiting.push_back(ticket);
+	waiting_count[ticket.priority]++;
+
+	std::function<bool()> is_turn = [this, &ticket] {
+		if (is_busy)
+			return false;
+
+		// Is any other waiting request more urgent?
+		for (size_t i = 0; i < waiting.size(); i++)
+			if (IsMoreUrgent(waiting[i], ticket))
+				return false;
+
+		return true;
+	};
+
+	bool has_turn = true;
+	if (!token)
+		turn_changed.wait(lock, is_turn);
+	else
+	{
+		// Wake up now and then, to check the token (cancelling it doesn't notify the scheduler)
+		while (!is_turn())
+		{
+			if (token->ShouldStop())
+			{
+				has_turn = false;
+				break;
+			}
+
+			Clock::time_point check = std::min(token->GetDeadline(), Clock::now() + std::chrono::milliseconds(TokenCheckMilliseconds));
+			turn_changed.wait_until(lock, check);
+		}
+	}
+
+	// Take the decoder (or leave the line)
+	for (size_t i = 0; i < waiting.size(); i++)
+	{
+		if (waiting[i].sequence == ticket.sequence)
+		{
+			waiting.erase(waiting.begin() + i);
+			break;
+		}
+	}
+	waiting_count[ticket.priority]--;
+
+	if (!has_turn)
+	{
+		// The requests behind this one may be next now
+		turn_changed.notify_all();
+		return false;
+	}
+
+	is_busy = true;
+	holder_sequence = ticket.sequence;
+	return true;
+}
+
+// Wait for the decoder
+RequestScheduler::Ticket RequestScheduler::Begin(RequestPriority priority, Clock::time_point deadline)
+{
+	std::unique_lock<std::mutex> lock(scheduler_mutex);
+
+	Ticket ticket;
+	ticket.priority = priority;
+	ticket.deadline = deadline;
+	ticket.sequence = next_sequence++;
+
+	WaitForTurn(ticket, lock, NULL);
+	return ticket;
+}
+
+// Wait for the decoder, unless the token stops the request first
+bool RequestScheduler::Begin(RequestPriority priority, RequestToken &token, Ticket &ticket)
+{
+	std::unique_lock<std::mutex> lock(scheduler_mutex);
+
+	ticket.priority = priority;
+	ticket.deadline = token.GetDeadline();
+	ticket.sequence = next_sequence++;
+
+	return WaitForTurn(ticket, lock, &token);
+}
+
+// Give the decoder back
+void RequestScheduler::End(const Ticket &ticket)
+{
+	{
+		// A ticket which gave the decoder up (i.e. its Yield was stopped by its token) can't free it for another one
+		std::lock_guard<std::mutex> lock(scheduler_mutex);
+		if (!is_busy || holder_sequence != ticket.sequence)
+			return;
+
+		is_busy = false;
+	}
+	turn_changed.notify_all();
+}
+
+// Check if a more urgent class of request is waiting for the decoder
+bool RequestScheduler::ShouldYield(const Ticket &ticket)
+{
+	for (int priority = 0; priority < ticket.priority; priority++)
+		if (waiting_count[priority] > 0)
+			return true;
+
+	return false;
+}
+
+// Give the decoder to the more urgent requests, and wait for the ticket's turn again
+bool RequestScheduler::Yield(const Ticket &ticket, RequestToken *token)
+{
+	std::unique_lock<std::mutex> lock(scheduler_mutex);
+
+	is_busy = false;
+	turn_changed.notify_all();
+
+	return WaitForTurn(ticket, lock, token);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 19:35
+#vNext
+=============================================================
+*/
@@ -0,0 +1,168 @@
+#ifndef GUARD_request_scheduler_20261018193540_
+#define GUARD_request_scheduler_20261018193540_
+/*
+@file		request_scheduler.hpp
+@author		Webstar
+@date		2026-10-18 19:35
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "request_token.hpp"
+
+namespace vs
+{
+	/// The priority classes of frame requests (most urgent first)
+	enum RequestPriority
+	{
+		REQUEST_PLAYHEAD,		///< The frame the user is looking at (interactive)
+		REQUEST_PREFETCH,		///< Frames the playhead is expected to need soon
+		REQUEST_THUMBNAIL,		///< Thumbnails (i.e. a timeline strip)
+		REQUEST_ANALYSIS,		///< Background analysis (i.e. waveforms, scene detection)
+		REQUEST_PRIORITY_COUNT
+	};
+
+	/// @brief This class decides which frame request decodes next
+	/// @remark A reader has a single decoder, so only one request decodes at a time. Waiting requests are ordered
+	/// by priority class, then by deadline, then by arrival. The decoding request checks ShouldYield() at every
+	/// packet boundary, and steps aside (Yield) when a request of a more urgent class is waiting, so a playhead
+	/// request never waits for a thumbnail or analysis job to finish.
+	/// @code
+	/// ScheduledRequest request(scheduler, REQUEST_THUMBNAIL, RequestScheduler::NoDeadline());
+	/// while (decoding)
+	/// {
+	///     if (scheduler.ShouldYield(request.GetTicket()))
+	///         request.Yield();
+	///     // ... decode a packet ...
+	/// }
+	/// @endcode
+	class RequestScheduler
+	{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		/// A request holding (or waiting for) the decoder
+		struct Ticket
+		{
+			RequestPriority priority;
+			Clock::time_point deadline;
+			uint64_t sequence;			///< The order of arrival
+		};
+
+	private:
+		std::mutex scheduler_mutex;
+		std::condition_variable turn_changed;
+
+		std::vector<Ticket> waiting;						///< The requests waiting for the decoder
+		std::atomic<int> waiting_count[REQUEST_PRIORITY_COUNT];	///< The number of waiting requests of each class
+		bool is_busy;										///< A request holds the decoder
+		uint64_t holder_sequence;							///< The ticket holding the decoder (when busy)
+		uint64_t next_sequence;
+
+		/// Check if a ticket goes before another one
+		static bool IsMoreUrgent(const Ticket &a, const Ticket &b);
+
+		/// @brief Wait until the ticket is the most urgent one, and the decoder is free (the lock is held)
+		/// @returns false if the token stopped the request first (the ticket leaves the line)
+		bool WaitForTurn(const Ticket &ticket, std::unique_lock<std::mutex> &lock, RequestToken *token);
+
+	public:
+		/// How often a waiting request checks its token for cancellation
+		static const int TokenCheckMilliseconds = 5;
+
+		/// Constructor
+		RequestScheduler();
+
+		/// A deadline which never expires
+		static Clock::time_point NoDeadline() { return Clock::time_point::max(); }
+
+		/// @brief Wait for the decoder (blocks until no more urgent request is waiting, and the decoder is free)
+		/// @returns The ticket holding the decoder, which must be given back with End()
+		Ticket Begin(RequestPriority priority, Clock::time_point deadline);
+
+		/// @brief Wait for the decoder, unless the token stops the request first
+		/// @returns true if the ticket holds the decoder (and must be given back with End())
+		bool Begin(RequestPriority priority, RequestToken &token, Ticket &ticket);
+
+		/// Give the decoder back (ignored unless the ticket holds the decoder)
+		void End(const Ticket &ticket);
+
+		/// Check if a more urgent class of request is waiting for the decoder (cheap, call it at every packet)
+		bool ShouldYield(const Ticket &ticket);
+
+		/// @brief Give the decoder to the more urgent requests, and wait for the ticket's turn again (it keeps its place in line)
+		/// @returns false if the token stopped the request first (the ticket doesn't hold the decoder anymore)
+		bool Yield(const Ticket &ticket, RequestToken *token = NULL);
+
+		/// Count the requests of a class waiting for the decoder
+		int CountWaiting(RequestPriority priority) { return waiting_count[priority]; }
+	};
+
+	/// @brief Holds the decoder for the lifetime of this object (the decoder is given back even if an exception is thrown)
+	class ScheduledRequest
+	{
+	private:
+		RequestScheduler &scheduler;
+		RequestScheduler::Ticket ticket;
+		RequestToken *token;
+		bool has_decoder;
+
+		ScheduledRequest(const ScheduledRequest&);
+		ScheduledRequest& operator=(const ScheduledRequest&);
+
+	public:
+		/// Wait for the decoder
+		ScheduledRequest(RequestScheduler &scheduler, RequestPriority priority, RequestScheduler::Clock::time_point deadline)
+			: scheduler(scheduler), ticket(scheduler.Begin(priority, deadline)), token(NULL), has_decoder(true) { }
+
+		/// Wait for the decoder, unless the token (if any) stops the request first (see HasDecoder)
+		ScheduledRequest(RequestScheduler &scheduler, RequestPriority priority, RequestScheduler::Clock::time_point deadline, RequestToken *token)
+			: scheduler(scheduler), token(token), has_decoder(true)
+		{
+			if (token)
+				has_decoder = scheduler.Begin(priority, *token, ticket);
+			else
+				ticket = scheduler.Begin(priority, deadline);
+		}
+
+		/// Give the decoder back
+		~ScheduledRequest() { if (has_decoder) scheduler.End(ticket); }
+
+		/// Check if the request holds the decoder (false once its token stopped it)
+		bool HasDecoder() { return has_decoder; }
+
+		/// Check if the token of the request was cancelled, or is past its deadline
+		bool ShouldStop() { return token && token->ShouldStop(); }
+
+		/// Get the ticket holding the decoder
+		const RequestScheduler::Ticket& GetTicket() { return ticket; }
+
+		/// Check if a more urgent class of request is waiting for the decoder
+		bool ShouldYield() { return scheduler.ShouldYield(ticket); }
+
+		/// Give the decoder to the more urgent requests, and wait for this request's turn again (false if the token stopped it)
+		bool Yield() { has_decoder = scheduler.Yield(ticket, token); return has_decoder; }
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 19:35
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,36 @@
+/*
+@file		request_token.cpp
+@author		Webstar
+@date		2026-10-18 21:45
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+#include "request_token.hpp"
+
+using namespace std;
+using namespace vs;
+
+// Constructor
+RequestToken::RequestToken(Clock::time_point deadline)
+	: cancelled(false), status(REQUEST_PENDING), deadline(deadline)
+{
+}
+
+// Stop the request
+void RequestToken::Cancel()
+{
+	cancelled = true;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 21:45
+#vNext
+=============================================================
+*/
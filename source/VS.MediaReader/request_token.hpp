@@ -0,0 +1,93 @@
+#ifndef GUARD_request_token_20261018214530_
+#define GUARD_request_token_20261018214530_
+/*
+@file		request_token.hpp
+@author		Webstar
+@date		2026-10-18 21:45
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <atomic>
+#include <chrono>
+
+namespace vs
+{
+	/// The outcome of a frame request
+	enum RequestStatus
+	{
+		REQUEST_PENDING = 0,	///< The request hasn't returned yet
+		REQUEST_COMPLETED,		///< The requested frame was returned
+		REQUEST_CANCELLED,		///< Cancel() was called (the closest cached frame, if any, was returned)
+		REQUEST_TIMED_OUT,		///< The deadline expired (the closest cached frame, if any, was returned)
+		REQUEST_FAILED			///< The request threw an exception
+	};
+
+	/// @brief This class lets the caller of a frame request cancel it, and bounds it with a deadline
+	/// @remark The reader checks the token while the request waits (for the decoder, or for another request decoding
+	/// the same frames) and between packets, so a request stops within a packet of being cancelled or late. The
+	/// reader is left in a consistent state, and the next request resumes from where this one stopped.
+	/// @code
+	/// RequestToken token(RequestToken::Clock::now() + std::chrono::milliseconds(40));
+	/// QSharedPointer<Frame> frame = reader.GetFrame(number, REQUEST_PLAYHEAD, token);
+	/// if (token.GetStatus() != REQUEST_COMPLETED)
+	///     // ... drop the late frame (or show the approximate one) ...
+	/// @endcode
+	class RequestToken
+	{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+	private:
+		std::atomic<bool> cancelled;
+		std::atomic<int> status;
+		Clock::time_point deadline;
+
+		RequestToken(const RequestToken&);
+		RequestToken& operator=(const RequestToken&);
+
+	public:
+		/// @brief Constructor
+		/// @param deadline When the request must return by (never, by default)
+		RequestToken(Clock::time_point deadline = Clock::time_point::max());
+
+		/// Stop the request (safe to call from any thread)
+		void Cancel();
+
+		/// Check if Cancel() was called
+		bool IsCancelled() { return cancelled; }
+
+		/// Check if the deadline has passed
+		bool IsExpired() { return deadline != Clock::time_point::max() && Clock::now() >= deadline; }
+
+		/// Check if the request should stop (cancelled, or past its deadline)
+		bool ShouldStop() { return IsCancelled() || IsExpired(); }
+
+		/// Get the deadline
+		Clock::time_point GetDeadline() { return deadline; }
+
+		/// Get the outcome of the request
+		RequestStatus GetStatus() { return (RequestStatus)status.load(); }
+
+		/// Set the outcome of the request (used by the reader)
+		void SetStatus(RequestStatus status) { this->status = status; }
+
+		/// Get the status of a stopped request (REQUEST_CANCELLED or REQUEST_TIMED_OUT)
+		RequestStatus GetStopStatus() { return IsCancelled() ? REQUEST_CANCELLED : REQUEST_TIMED_OUT; }
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 21:45
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,184 @@
+/*
+@file		seek_cost_model.cpp
+@author		Webstar
+@date		2026-10-18 20:35
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "seek_cost_model.hpp"
+
+using namespace std;
+using namespace vs;
+
+// Weight of a new measurement in the moving averages
+const double SeekCostModel::Smoothing = 0.1;
+
+// Constructor
+SeekCostModel::SeekCostModel(double default_gop_length)
+{
+	Reset(default_gop_length);
+}
+
+// Forget the measurements and keyframes
+void SeekCostModel::Reset(double default_gop_length)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	// Rough starting points (1080p H.264 on a desktop), replaced by the measurements
+	decode_time = 0.005;
+	convert_time = 0.002;
+	seek_time = 0.02;
+	this->default_gop_length = std::max(1.0, default_gop_length);
+	keyframes.clear();
+	has_index = false;
+}
+
+// Blend a new measurement into a moving average
+void SeekCostModel::Update(double &average, double seconds)
+{
+	if (seconds >= 0.0)
+		average += (seconds - average) * Smoothing;
+}
+
+// Record the time it took to decode a frame
+void SeekCostModel::AddDecodeTime(double seconds)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	Update(decode_time, seconds);
+}
+
+// Record the time it took to convert a frame
+void SeekCostModel::AddConvertTime(double seconds)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	Update(convert_time, seconds);
+}
+
+// Record the time a seek took
+void SeekCostModel::AddSeekTime(double seconds)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	Update(seek_time, seconds);
+}
+
+// Record a keyframe
+void SeekCostModel::AddKeyframe(long int frame, bool from_index)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	if (frame < 1)
+		return;
+
+	keyframes.insert(frame);
+	has_index = has_index || from_index;
+}
+
+// Get the average distance between keyframes
+double SeekCostModel::GetGopLength()
+{
+	if (keyframes.size() < 2)
+		return default_gop_length;
+
+	return double(*keyframes.rbegin() - *keyframes.begin()) / double(keyframes.size() - 1);
+}
+
+// Get the keyframe a seek to a frame would start decoding from
+long int SeekCostModel::FindKeyframe(long int frame)
+{
+	// The closest known keyframe at (or before) the frame
+	long int known = 1;
+	std::set<long int>::iterator itr = keyframes.upper_bound(frame);
+	if (itr != keyframes.begin())
+		known = *(--itr);
+
+	// The index lists every keyframe. Otherwise there can be keyframes we haven't seen between the known one
+	// and the frame: assume the frame is half a GOP after its keyframe.
+	double gop_length = GetGopLength();
+	if (has_index || frame - known <= gop_length)
+		return known;
+
+	return std::max(known, frame - (long int)(gop_length / 2.0));
+}
+
+// Estimate the time to reach a frame by decoding forward from a position
+double SeekCostModel::EstimateWalk(long int position, long int requested_frame)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	// Walking can only go forward (position 0 is the start of the stream, before frame 1)
+	if (position < 0 || requested_frame <= position)
+		return std::numeric_limits<double>::infinity();
+
+	return (requested_frame - position) * decode_time;
+}
+
+// Estimate the time to reach a frame by seeking to the keyframe before it
+double SeekCostModel::EstimateSeek(long int requested_frame)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	return seek_time + (requested_frame - FindKeyframe(requested_frame) + 1) * decode_time;
+}
+
+// Get the keyframe a seek to a frame starts decoding from
+long int SeekCostModel::GetKeyframeBefore(long int requested_frame)
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	return FindKeyframe(requested_frame);
+}
+
+// Check if walking forward from a position reaches a frame sooner than seeking
+bool SeekCostModel::ShouldWalk(long int position, long int requested_frame, double walk_bias)
+{
+	return EstimateWalk(position, requested_frame) <= EstimateSeek(requested_frame) * walk_bias;
+}
+
+// Get the number of frames before a requested frame that are worth converting
+long int SeekCostModel::GetSkipWindow()
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	// Stepping back to a skipped frame costs a seek, and the decoding from its keyframe
+	double refetch_time = seek_time + GetGopLength() / 2.0 * decode_time;
+	long int window = (long int)std::ceil(refetch_time / std::max(convert_time, 1e-6));
+
+	return std::max(1L, std::min(window, MaxSkipWindow));
+}
+
+// Get a snapshot of the estimates
+SeekCostEstimates SeekCostModel::GetEstimates()
+{
+	std::lock_guard<std::mutex> lock(model_mutex);
+
+	SeekCostEstimates estimates;
+	estimates.decode_time = decode_time;
+	estimates.convert_time = convert_time;
+	estimates.seek_time = seek_time;
+	estimates.gop_length = GetGopLength();
+	estimates.keyframes = (long int)keyframes.size();
+	estimates.has_index = has_index;
+
+	return estimates;
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 20:35
+#vNext
+=============================================================
+*/
@@ -0,0 +1,116 @@
+#ifndef GUARD_seek_cost_model_20261018203550_
+#define GUARD_seek_cost_model_20261018203550_
+/*
+@file		seek_cost_model.hpp
+@author		Webstar
+@date		2026-10-18 20:35
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <mutex>
+#include <set>
+
+namespace vs
+{
+	/// @brief A snapshot of the estimates of a SeekCostModel (times in seconds)
+	struct SeekCostEstimates
+	{
+		double decode_time;			///< Time to decode one frame
+		double convert_time;		///< Time to convert (and cache) one decoded frame
+		double seek_time;			///< Time of the seek itself (before decoding from the keyframe)
+		double gop_length;			///< Average distance between keyframes (in frames)
+		long int keyframes;			///< Number of known keyframes
+		bool has_index;				///< The keyframes come from the index of the file (not only from observation)
+	};
+
+	/// @brief This class estimates whether walking forward or seeking reaches a frame sooner
+	/// @remark Walking decodes every frame from the current position to the target. Seeking jumps to the keyframe
+	/// before the target, and decodes from there. The model measures the decode, conversion and seek times of the
+	/// reader (moving averages), and knows the keyframes from the index of the file or from the decoded frames, so
+	/// a 1 second GOP H.264 file seeks for shorter jumps than a 10 second GOP HEVC file.
+	class SeekCostModel
+	{
+	private:
+		std::mutex model_mutex;
+
+		double decode_time;
+		double convert_time;
+		double seek_time;
+		double default_gop_length;		///< Used until two keyframes have been observed
+		std::set<long int> keyframes;
+		bool has_index;
+
+		/// Blend a new measurement into a moving average
+		static void Update(double &average, double seconds);
+
+		/// Get the keyframe a seek to a frame would start decoding from (the lock is held)
+		long int FindKeyframe(long int frame);
+
+		/// Get the average distance between keyframes (the lock is held)
+		double GetGopLength();
+
+	public:
+		/// Weight of a new measurement in the moving averages
+		static const double Smoothing;
+
+		/// The most frames kept before a requested frame (see GetSkipWindow)
+		static const long int MaxSkipWindow = 120;
+
+		/// @brief Constructor
+		/// @param default_gop_length The distance between keyframes to assume until it has been observed (in frames)
+		SeekCostModel(double default_gop_length = 250.0);
+
+		/// Forget the measurements and keyframes (i.e. when a new file is opened)
+		void Reset(double default_gop_length);
+
+		/// Record the time it took to decode a frame (in seconds)
+		void AddDecodeTime(double seconds);
+
+		/// Record the time it took to convert a frame (in seconds)
+		void AddConvertTime(double seconds);
+
+		/// Record the time a seek took (in seconds, not counting the decoding after it)
+		void AddSeekTime(double seconds);
+
+		/// Record a keyframe (from the index, or from a decoded frame)
+		void AddKeyframe(long int frame, bool from_index = false);
+
+		/// @brief Estimate the time to reach a frame by decoding forward from a position (infinite when it is behind)
+		/// @remark Position 0 is the start of the stream (nothing decoded yet), so frame N is N frames away.
+		double EstimateWalk(long int position, long int requested_frame);
+
+		/// Estimate the time to reach a frame by seeking to the keyframe before it
+		double EstimateSeek(long int requested_frame);
+
+		/// Get the keyframe a seek to a frame starts decoding from (an estimate, if the index is unknown)
+		long int GetKeyframeBefore(long int requested_frame);
+
+		/// @brief Check if walking forward from a position reaches a frame sooner than seeking
+		/// @param walk_bias Multiplies the seek estimate (above 1 walks further, below 1 seeks sooner)
+		bool ShouldWalk(long int position, long int requested_frame, double walk_bias = 1.0);
+
+		/// @brief Get the number of frames before a requested frame that are worth converting (and caching)
+		/// @remark The frames just before the target are converted as long as converting them all costs less than
+		/// one seek, which is what stepping back to one of them later would cost.
+		long int GetSkipWindow();
+
+		/// Get a snapshot of the estimates (for tuning)
+		SeekCostEstimates GetEstimates();
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 20:35
+#vNext
+=============================================================
+*/
+
+#endif
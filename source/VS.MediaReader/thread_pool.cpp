@@ -0,0 +1,217 @@
+/*
+@file		thread_pool.cpp
+@author		Webstar
+@date		2026-10-18 18:30
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <algorithm>
+
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace vs;
+
+namespace vs
+{
+	namespace helpers
+	{
+		/// The pool (and the index in it) of the current worker thread (NULL for other threads)
+		thread_local ThreadPool *current_pool = NULL;
+		thread_local int current_worker = -1;
+	}
+}
+
+// Constructor
+ThreadPool::ThreadPool(int thread_count)
+	: pending_tasks(0), next_queue(0), is_stopping(false)
+{
+	for (int i = 0; i < thread_count; i++)
+		workers.push_back(std::unique_ptr<Worker>(new Worker()));
+
+	for (int i = 0; i < thread_count; i++)
+		threads.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+}
+
+// Destructor (runs the queued tasks, then waits for the workers to finish)
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		is_stopping = true;
+	}
+	work_available.notify_all();
+
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+}
+
+// Get the pool shared by all readers
+ThreadPool& ThreadPool::Global()
+{
+	// Leave one core to the threads calling ParallelFor
+	static ThreadPool *pool = new ThreadPool(std::max(1, (int)std::thread::hardware_concurrency() - 1));
+	return *pool;
+}
+
+// Run a task on one of the workers
+void ThreadPool::Submit(std::function<void()> task)
+{
+	// Without workers, run it right away
+	if (workers.empty())
+	{
+		task();
+		return;
+	}
+
+	// Workers keep their own tasks, other threads spread them across the queues
+	int index = (helpers::current_pool == this) ? helpers::current_worker : (int)(next_queue++ % workers.size());
+	{
+		std::lock_guard<std::mutex> lock(workers[index]->queue_mutex);
+		workers[index]->tasks.push_back(std::move(task));
+	}
+	pending_tasks++;
+
+	// Wake up a sleeping worker (taking the lock, so a worker about to sleep can't miss the task)
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+	}
+	work_available.notify_one();
+}
+
+// Take a task from a worker's own queue (newest first), or steal one from another queue (oldest first)
+bool ThreadPool::TakeTask(int index, std::function<void()> &task)
+{
+	{
+		Worker &own = *workers[index];
+		std::lock_guard<std::mutex> lock(own.queue_mutex);
+
+		if (!own.tasks.empty())
+		{
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			pending_tasks--;
+			return true;
+		}
+	}
+
+	for (size_t i = 1; i < workers.size(); i++)
+	{
+		Worker &victim = *workers[(index + i) % workers.size()];
+		std::lock_guard<std::mutex> lock(victim.queue_mutex);
+
+		if (!victim.tasks.empty())
+		{
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			pending_tasks--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// The loop run by each worker thread
+void ThreadPool::WorkerLoop(int index)
+{
+	helpers::current_pool = this;
+	helpers::current_worker = index;
+
+	std::function<void()> task;
+	while (true)
+	{
+		if (TakeTask(index, task))
+		{
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		// Sleep until a task is submitted
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		work_available.wait(lock, [this] { return is_stopping || pending_tasks > 0; });
+
+		if (is_stopping && pending_tasks == 0)
+			return;
+	}
+}
+
+// Run iterations of a loop until there are none left to hand out
+void ThreadPool::RunIterations(Loop &loop)
+{
+	int index;
+	while ((index = loop.next++) < loop.count)
+	{
+		// Once an iteration failed, the others only count down (the caller waits for the running ones)
+		if (!loop.has_failed)
+		{
+			try
+			{
+				(*loop.body)(index);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(loop.loop_mutex);
+				if (!loop.has_failed)
+					loop.error = std::current_exception();
+				loop.has_failed = true;
+			}
+		}
+
+		// The last iteration wakes up the caller
+		if (--loop.remaining == 0)
+		{
+			std::lock_guard<std::mutex> lock(loop.loop_mutex);
+			loop.finished.notify_all();
+		}
+	}
+}
+
+// Call body(0) ... body(count - 1), spread across the workers and the calling thread
+void ThreadPool::ParallelFor(int count, const std::function<void(int)> &body)
+{
+	// Nothing to share
+	if (count <= 1 || workers.empty())
+	{
+		for (int i = 0; i < count; i++)
+			body(i);
+		return;
+	}
+
+	// The loop is shared with the helper tasks, which can start after the loop has finished (they find no
+	// iterations left, so the body is never called once ParallelFor has returned)
+	std::shared_ptr<Loop> loop = std::make_shared<Loop>();
+	loop->body = &body;
+	loop->count = count;
+	loop->next = 0;
+	loop->remaining = count;
+	loop->has_failed = false;
+
+	int helpers_count = std::min(count - 1, (int)workers.size());
+	for (int i = 0; i < helpers_count; i++)
+		Submit([loop] { RunIterations(*loop); });
+
+	// Work on the loop too, then wait for the iterations running on the workers
+	RunIterations(*loop);
+
+	std::unique_lock<std::mutex> lock(loop->loop_mutex);
+	loop->finished.wait(lock, [&loop] { return loop->remaining == 0; });
+
+	if (loop->error)
+		std::rethrow_exception(loop->error);
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 18:30
+#vNext
+=============================================================
+*/
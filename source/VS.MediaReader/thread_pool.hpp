@@ -0,0 +1,116 @@
+#ifndef GUARD_thread_pool_20261018183005_
+#define GUARD_thread_pool_20261018183005_
+/*
+@file		thread_pool.hpp
+@author		Webstar
+@date		2026-10-18 18:30
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vs
+{
+	/// @brief This class runs tasks on a fixed set of worker threads, which steal work from each other
+	/// @remark Every worker has a queue of its own. Tasks submitted by a worker go to its own queue (and run
+	/// newest first, while the data is still in the cache), and idle workers steal the oldest tasks from the
+	/// other queues. All the readers share the Global() pool for the slices of their image conversions (see
+	/// ParallelFor), and ProbeBatch probes its files on it, so the number of threads doesn't grow with the number
+	/// of open readers.
+	/// @code
+	/// ThreadPool::Global().Submit([=] { /* ... */ });
+	/// ThreadPool::Global().ParallelFor(slices, [&](int slice) {
+	///     // ... convert the lines of this slice ...
+	/// });
+	/// @endcode
+	class ThreadPool
+	{
+	private:
+		/// The queue of a worker thread
+		struct Worker
+		{
+			std::mutex queue_mutex;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		/// A loop shared by ParallelFor with the workers
+		struct Loop
+		{
+			const std::function<void(int)> *body;
+			int count;						///< The number of iterations
+			std::atomic<int> next;			///< The next iteration to hand out
+			std::atomic<int> remaining;		///< The number of iterations not finished yet
+			std::atomic<bool> has_failed;	///< An iteration threw (the next ones are skipped)
+			std::exception_ptr error;		///< The first exception thrown by an iteration (guarded by loop_mutex)
+			std::mutex loop_mutex;
+			std::condition_variable finished;
+		};
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::vector<std::thread> threads;
+		std::atomic<int> pending_tasks;		///< The number of queued tasks (not running yet)
+		std::atomic<unsigned int> next_queue;	///< The queue of the next task submitted from outside the pool
+		std::mutex sleep_mutex;
+		std::condition_variable work_available;
+		bool is_stopping;
+
+		/// The loop run by each worker thread
+		void WorkerLoop(int index);
+
+		/// Take a task from a worker's own queue (newest first), or steal one from another queue (oldest first)
+		bool TakeTask(int index, std::function<void()> &task);
+
+		/// Run iterations of a loop until there are none left to hand out
+		static void RunIterations(Loop &loop);
+
+	public:
+		/// @brief Constructor
+		/// @param thread_count The number of worker threads (not counting the threads calling ParallelFor)
+		ThreadPool(int thread_count);
+
+		/// Destructor (runs the queued tasks, then waits for the workers to finish)
+		~ThreadPool();
+
+		/// @brief Get the pool shared by all readers (one worker per core, except the calling thread)
+		/// @remark The pool is never destroyed, since joining threads while a DLL unloads can deadlock.
+		static ThreadPool& Global();
+
+		/// Get the number of worker threads
+		int GetThreadCount() { return (int)threads.size(); }
+
+		/// @brief Run a task on one of the workers
+		/// @remark Tasks must not wait for tasks submitted after them (they could be queued behind them).
+		void Submit(std::function<void()> task);
+
+		/// @brief Call body(0) ... body(count - 1), spread across the workers and the calling thread
+		/// @remark Returns once every iteration has finished. The iterations must not depend on each other.
+		/// It is safe to call from a task (the calling thread always makes progress on its own loop). If an
+		/// iteration throws, the iterations not started yet are skipped, and the first exception is rethrown once
+		/// the running ones have finished.
+		void ParallelFor(int count, const std::function<void(int)> &body);
+	};
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 18:30
+#vNext
+=============================================================
+*/
+
+#endif
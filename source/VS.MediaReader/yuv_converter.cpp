@@ -0,0 +1,241 @@
+/*
+@file		yuv_converter.cpp
+@author		Webstar
+@date		2026-10-18 17:45
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "cpu_features.hpp"
+#include "yuv_converter.hpp"
+
+using namespace std;
+using namespace vs;
+
+namespace vs
+{
+	namespace helpers
+	{
+		/// Constrain a color value from 0 to 255
+		inline unsigned char ClampColor(int value)
+		{
+			return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+		}
+
+		/// Convert a single pixel (the same fixed-point math as the AVX2 kernels, so the results match bit for bit)
+		inline void ConvertYuvPixel(unsigned char *rgba, int y, int u, int v, const YuvCoefficients &c)
+		{
+			int luma = (y - c.y_offset) * c.y_scale + 4096;
+			u -= c.c_offset;
+			v -= c.c_offset;
+
+			rgba[0] = ClampColor((luma + v * c.r_v) >> 13);
+			rgba[1] = ClampColor((luma + u * c.g_u + v * c.g_v) >> 13);
+			rgba[2] = ClampColor((luma + u * c.b_u) >> 13);
+			rgba[3] = 255;
+		}
+
+		/// Convert the pixels of a line, starting at a given pixel (the even pixels sit on a chroma sample, the odd
+		/// pixels average the samples on both sides)
+		template <typename Sample>
+		void ConvertLine(unsigned char *rgba, const Sample *y, const uint16_t *u, const uint16_t *v, int start, int width, const YuvCoefficients &c)
+		{
+			for (int x = start; x < width; x++)
+			{
+				int chroma = x >> 1;
+				if (x & 1)
+					ConvertYuvPixel(rgba + x * 4, y[x], (u[chroma] + u[chroma + 1] + 1) >> 1, (v[chroma] + v[chroma + 1] + 1) >> 1, c);
+				else
+					ConvertYuvPixel(rgba + x * 4, y[x], u[chroma], v[chroma], c);
+			}
+		}
+
+		// Convert the pixels of a line of 8-bit Y, starting at a given pixel
+		void ConvertYuvLine(unsigned char *rgba, const uint8_t *y, const uint16_t *u, const uint16_t *v, int start, int width, const YuvCoefficients &coefficients)
+		{
+			ConvertLine(rgba, y, u, v, start, width, coefficients);
+		}
+
+		// Convert the pixels of a line of 16-bit Y, starting at a given pixel
+		void ConvertYuvLine(unsigned char *rgba, const uint16_t *y, const uint16_t *u, const uint16_t *v, int start, int width, const YuvCoefficients &coefficients)
+		{
+			ConvertLine(rgba, y, u, v, start, width, coefficients);
+		}
+
+		/// Interpolate the samples of a line of chroma, starting at a given sample
+		template <typename Sample>
+		void InterpolateLine(uint16_t *chroma, const Sample *nearest, const Sample *farther, int step, int start, int count)
+		{
+			for (int x = start; x < count; x++)
+				chroma[x] = (uint16_t)((3 * nearest[x * step] + farther[x * step] + 2) >> 2);
+		}
+
+		// Interpolate the samples of a line of 8-bit chroma, starting at a given sample
+		void InterpolateChromaLine(uint16_t *chroma, const uint8_t *nearest, const uint8_t *farther, int step, int start, int count)
+		{
+			InterpolateLine(chroma, nearest, farther, step, start, count);
+		}
+
+		// Interpolate the samples of a line of 16-bit chroma, starting at a given sample
+		void InterpolateChromaLine(uint16_t *chroma, const uint16_t *nearest, const uint16_t *farther, int step, int start, int count)
+		{
+			InterpolateLine(chroma, nearest, farther, step, start, count);
+		}
+
+		/// Interpolate the U and V lines of an image, between 2 lines of its chroma planes
+		void InterpolateChroma(const YuvImage &image, int nearest_line, int farther_line, uint16_t *u, uint16_t *v, int count, bool use_avx2)
+		{
+			const unsigned char *nearest_u = image.planes[1] + (size_t)nearest_line * image.strides[1];
+			const unsigned char *farther_u = image.planes[1] + (size_t)farther_line * image.strides[1];
+			int interpolated_u = 0;
+			int interpolated_v = 0;
+
+			if (image.layout == YUV_LAYOUT_NV12)
+			{
+#if VS_CPU_X86
+				if (use_avx2)
+					interpolated_u = interpolated_v = avx2::InterpolateChromaLineNv12(u, v, nearest_u, farther_u, count);
+#endif
+				InterpolateChromaLine(u, nearest_u, farther_u, 2, interpolated_u, count);
+				InterpolateChromaLine(v, nearest_u + 1, farther_u + 1, 2, interpolated_v, count);
+				return;
+			}
+
+			const unsigned char *nearest_v = image.planes[2] + (size_t)nearest_line * image.strides[2];
+			const unsigned char *farther_v = image.planes[2] + (size_t)farther_line * image.strides[2];
+
+			if (image.bit_depth > 8)
+			{
+#if VS_CPU_X86
+				if (use_avx2)
+				{
+					interpolated_u = avx2::InterpolateChromaLine16(u, (const uint16_t *)nearest_u, (const uint16_t *)farther_u, count);
+					interpolated_v = avx2::InterpolateChromaLine16(v, (const uint16_t *)nearest_v, (const uint16_t *)farther_v, count);
+				}
+#endif
+				InterpolateChromaLine(u, (const uint16_t *)nearest_u, (const uint16_t *)farther_u, 1, interpolated_u, count);
+				InterpolateChromaLine(v, (const uint16_t *)nearest_v, (const uint16_t *)farther_v, 1, interpolated_v, count);
+			}
+			else
+			{
+#if VS_CPU_X86
+				if (use_avx2)
+				{
+					interpolated_u = avx2::InterpolateChromaLine8(u, nearest_u, farther_u, count);
+					interpolated_v = avx2::InterpolateChromaLine8(v, nearest_v, farther_v, count);
+				}
+#endif
+				InterpolateChromaLine(u, nearest_u, farther_u, 1, interpolated_u, count);
+				InterpolateChromaLine(v, nearest_v, farther_v, 1, interpolated_v, count);
+			}
+		}
+
+		/// The interpolated chroma lines of each thread (so converting slices in parallel doesn't allocate)
+		thread_local vector<uint16_t> chroma_lines;
+	}
+}
+
+// Check if the fast converter can be used on this CPU
+bool YuvConverter::IsSupported()
+{
+#if VS_CPU_X86
+	return CpuFeatures::Get().has_avx2;
+#else
+	return false;
+#endif
+}
+
+// Calculate the fixed-point coefficients of a conversion
+YuvCoefficients YuvConverter::GetCoefficients(YuvMatrix matrix, YuvRange range, int bit_depth)
+{
+	// Luma weights of red and blue (green is the rest)
+	double kr = (matrix == YUV_MATRIX_BT709) ? 0.2126 : 0.299;
+	double kb = (matrix == YUV_MATRIX_BT709) ? 0.0722 : 0.114;
+	double kg = 1.0 - kr - kb;
+
+	// Scale the values to 8-bit full range
+	int shift = bit_depth - 8;
+	double y_scale = 255.0 / ((range == YUV_RANGE_FULL) ? ((1 << bit_depth) - 1) : (219 << shift));
+	double c_scale = 255.0 / ((range == YUV_RANGE_FULL) ? ((1 << bit_depth) - 1) : (224 << shift));
+
+	YuvCoefficients coefficients;
+	coefficients.y_offset = (int16_t)((range == YUV_RANGE_FULL) ? 0 : (16 << shift));
+	coefficients.c_offset = (int16_t)(128 << shift);
+	coefficients.y_scale = (int16_t)lround(y_scale * 8192.0);
+	coefficients.r_v = (int16_t)lround(2.0 * (1.0 - kr) * c_scale * 8192.0);
+	coefficients.g_u = (int16_t)lround(-2.0 * kb * (1.0 - kb) / kg * c_scale * 8192.0);
+	coefficients.g_v = (int16_t)lround(-2.0 * kr * (1.0 - kr) / kg * c_scale * 8192.0);
+	coefficients.b_u = (int16_t)lround(2.0 * (1.0 - kb) * c_scale * 8192.0);
+
+	return coefficients;
+}
+
+// Convert some lines of a YUV image to RGBA
+void YuvConverter::Convert(const YuvImage &image, unsigned char *rgba, int rgba_stride, int first_line, int line_count)
+{
+	YuvCoefficients coefficients = GetCoefficients(image.matrix, image.range, image.bit_depth);
+	bool use_avx2 = IsSupported();
+	bool is_420 = (image.layout != YUV_LAYOUT_422P);
+	int chroma_width = (image.width + 1) >> 1;
+	int chroma_height = is_420 ? (image.height + 1) >> 1 : image.height;
+
+	// A line of U, then a line of V (each with its last sample repeated)
+	vector<uint16_t> &chroma_lines = helpers::chroma_lines;
+	if ((int)chroma_lines.size() < (chroma_width + 1) * 2)
+		chroma_lines.resize((chroma_width + 1) * 2);
+	uint16_t *u = chroma_lines.data();
+	uint16_t *v = u + chroma_width + 1;
+
+	for (int line = first_line; line < first_line + line_count; line++)
+	{
+		// 420 chroma sits between 2 lines: the even lines are closer to the chroma line above, the odd lines
+		// to the chroma line below
+		int nearest_line = is_420 ? (line >> 1) : line;
+		int farther_line = nearest_line;
+		if (is_420)
+			farther_line = std::max(0, std::min(chroma_height - 1, (line & 1) ? nearest_line + 1 : nearest_line - 1));
+
+		// The odd pixel at the end of the line averages the last sample with itself
+		helpers::InterpolateChroma(image, nearest_line, farther_line, u, v, chroma_width, use_avx2);
+		u[chroma_width] = u[chroma_width - 1];
+		v[chroma_width] = v[chroma_width - 1];
+
+		unsigned char *rgba_line = rgba + (size_t)line * rgba_stride;
+		const unsigned char *y = image.planes[0] + (size_t)line * image.strides[0];
+		int converted = 0;
+
+		if (image.bit_depth > 8)
+		{
+#if VS_CPU_X86
+			if (use_avx2)
+				converted = avx2::ConvertYuvLine16(rgba_line, (const uint16_t *)y, u, v, image.width, coefficients);
+#endif
+			helpers::ConvertYuvLine(rgba_line, (const uint16_t *)y, u, v, converted, image.width, coefficients);
+		}
+		else
+		{
+#if VS_CPU_X86
+			if (use_avx2)
+				converted = avx2::ConvertYuvLine8(rgba_line, y, u, v, image.width, coefficients);
+#endif
+			helpers::ConvertYuvLine(rgba_line, y, u, v, converted, image.width, coefficients);
+		}
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 17:45
+#vNext
+=============================================================
+*/
@@ -0,0 +1,147 @@
+#ifndef GUARD_yuv_converter_20261018174510_
+#define GUARD_yuv_converter_20261018174510_
+/*
+@file		yuv_converter.hpp
+@author		Webstar
+@date		2026-10-18 17:45
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// STD
+#include <cstdint>
+
+namespace vs
+{
+	/// The layouts of YUV images supported by the YuvConverter
+	enum YuvLayout
+	{
+		YUV_LAYOUT_420P,	///< 3 planes, chroma subsampled horizontally and vertically (i.e. yuv420p, yuv420p10le)
+		YUV_LAYOUT_422P,	///< 3 planes, chroma subsampled horizontally (i.e. yuv422p, yuv422p10le)
+		YUV_LAYOUT_NV12,	///< 2 planes (Y, then interleaved UV), chroma subsampled horizontally and vertically
+	};
+
+	/// The matrices used to convert YUV to RGB
+	enum YuvMatrix
+	{
+		YUV_MATRIX_BT601,	///< Standard definition (ITU-R BT.601)
+		YUV_MATRIX_BT709,	///< High definition (ITU-R BT.709)
+	};
+
+	/// The range of the YUV values
+	enum YuvRange
+	{
+		YUV_RANGE_LIMITED,	///< Y from 16 to 235, U and V from 16 to 240 (scaled for higher bit depths)
+		YUV_RANGE_FULL,		///< Y, U and V use the full range of values
+	};
+
+	/// @brief This struct describes a YUV image (which is not owned)
+	/// @remark The samples of 10-bit images are stored in the low bits of 16-bit (little endian) values.
+	struct YuvImage
+	{
+		YuvLayout layout;
+		YuvMatrix matrix;
+		YuvRange range;
+		int bit_depth;					///< 8 or 10
+		int width;
+		int height;
+		const unsigned char *planes[3];	///< Y, U, V (NV12: Y, UV)
+		int strides[3];					///< The bytes per line of each plane
+	};
+
+	/// @brief Fixed-point (Q13) coefficients of a YUV to RGB conversion
+	/// @remark R = ((Y - y_offset) * y_scale + (V - c_offset) * r_v + 4096) >> 13, and so on for G and B.
+	struct YuvCoefficients
+	{
+		int16_t y_offset;
+		int16_t c_offset;
+		int16_t y_scale;
+		int16_t r_v;
+		int16_t g_u;
+		int16_t g_v;
+		int16_t b_u;
+	};
+
+	/// @brief This class converts YUV images to RGBA (8 bits per channel, alpha = 255), without scaling
+	/// @remark The common layouts decoded by FFmpeg are converted 16 pixels at a time with AVX2, which is much faster
+	/// than sws_scale when the size doesn't change. The chroma is interpolated bilinearly, like SWS_BILINEAR: the
+	/// chroma samples are sited left (between 2 lines for 420 images), as in MPEG-2 and H.264. When the CPU has no
+	/// AVX2, IsSupported() is false, and callers should use sws_scale instead.
+	/// @code
+	/// if (YuvConverter::IsSupported())
+	///     YuvConverter::Convert(image, rgba_pixels, rgba_stride, 0, image.height);
+	/// @endcode
+	class YuvConverter
+	{
+	public:
+		/// Check if the fast converter can be used on this CPU
+		static bool IsSupported();
+
+		/// Calculate the fixed-point coefficients of a conversion
+		static YuvCoefficients GetCoefficients(YuvMatrix matrix, YuvRange range, int bit_depth);
+
+		/// @brief Convert some lines of a YUV image to RGBA
+		/// @remark Lines can be converted in slices (i.e. on several threads).
+		/// @param rgba The first line of the whole RGBA image (not the first line of the slice)
+		/// @param rgba_stride The bytes per line of the RGBA image
+		/// @param first_line The first line to convert
+		/// @param line_count The number of lines to convert
+		static void Convert(const YuvImage &image, unsigned char *rgba, int rgba_stride, int first_line, int line_count);
+	};
+
+	namespace helpers
+	{
+		/// @brief Convert the pixels of a line, starting at a given pixel (the scalar loop the AVX2 kernels match bit for bit)
+		/// @remark U and V are lines of chroma at half resolution, interpolated vertically already, with the last
+		/// sample repeated once (the odd pixels average 2 neighbouring samples).
+		void ConvertYuvLine(unsigned char *rgba, const uint8_t *y, const uint16_t *u, const uint16_t *v, int start, int width, const YuvCoefficients &coefficients);
+
+		/// Convert the pixels of a line of 16-bit Y, starting at a given pixel (see above)
+		void ConvertYuvLine(unsigned char *rgba, const uint16_t *y, const uint16_t *u, const uint16_t *v, int start, int width, const YuvCoefficients &coefficients);
+
+		/// @brief Interpolate a line of chroma between the 2 nearest chroma lines, starting at a given sample
+		/// @remark Each sample is (3 * nearest + farther + 2) >> 2 (the same line twice for 422 images).
+		/// @param step The distance between 2 samples (2 for the interleaved UV of NV12)
+		void InterpolateChromaLine(uint16_t *chroma, const uint8_t *nearest, const uint8_t *farther, int step, int start, int count);
+
+		/// Interpolate a line of 16-bit chroma, starting at a given sample (see above)
+		void InterpolateChromaLine(uint16_t *chroma, const uint16_t *nearest, const uint16_t *farther, int step, int start, int count);
+	}
+
+	namespace avx2
+	{
+		/// @brief Convert a line of 8-bit Y (U and V as described by helpers::ConvertYuvLine)
+		/// @remark Returns the number of pixels converted (a multiple of 16), the remaining pixels are left to the caller.
+		int ConvertYuvLine8(unsigned char *rgba, const uint8_t *y, const uint16_t *u, const uint16_t *v, int width, const YuvCoefficients &coefficients);
+
+		/// @brief Convert a line of 16-bit Y (U and V as described by helpers::ConvertYuvLine)
+		/// @remark Returns the number of pixels converted (a multiple of 16), the remaining pixels are left to the caller.
+		int ConvertYuvLine16(unsigned char *rgba, const uint16_t *y, const uint16_t *u, const uint16_t *v, int width, const YuvCoefficients &coefficients);
+
+		/// @brief Interpolate a line of 8-bit chroma (as helpers::InterpolateChromaLine does)
+		/// @remark Returns the number of samples interpolated (a multiple of 16), the remaining samples are left to the caller.
+		int InterpolateChromaLine8(uint16_t *chroma, const uint8_t *nearest, const uint8_t *farther, int count);
+
+		/// @brief Interpolate a line of 16-bit chroma (as helpers::InterpolateChromaLine does)
+		/// @remark Returns the number of samples interpolated (a multiple of 16), the remaining samples are left to the caller.
+		int InterpolateChromaLine16(uint16_t *chroma, const uint16_t *nearest, const uint16_t *farther, int count);
+
+		/// @brief Interpolate a line of interleaved UV into a line of U and a line of V (as helpers::InterpolateChromaLine does)
+		/// @remark Returns the number of samples interpolated (a multiple of 16), the remaining samples are left to the caller.
+		int InterpolateChromaLineNv12(uint16_t *u, uint16_t *v, const uint8_t *nearest, const uint8_t *farther, int count);
+	}
+}
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 17:45
+#vNext
+=============================================================
+*/
+
+#endif
@@ -0,0 +1,196 @@
+/*
+@file		yuv_converter_avx2.cpp
+@author		Webstar
+@date		2026-10-18 17:45
+@version	0.0.1
+@note		Developed for Visual C++ 15.0
+@brief		...
+*/
+
+// This file is compiled with /arch:AVX2 (see the project settings), and its kernels are only called on CPUs with AVX2
+
+#include "cpu_features.hpp"
+
+#if VS_CPU_X86
+
+// STD
+#include <immintrin.h>
+
+#include "yuv_converter.hpp"
+
+namespace vs
+{
+	namespace avx2
+	{
+		/// The coefficients of a conversion, spread across the lanes
+		struct YuvConstants
+		{
+			__m256i y_offset;
+			__m256i c_offset;
+			__m256i y_coefficients;		///< Pairs of (y_scale, 4096), to multiply with pairs of (Y, 1)
+			__m256i r_coefficients;		///< Pairs of (0, r_v), to multiply with pairs of (U, V)
+			__m256i g_coefficients;		///< Pairs of (g_u, g_v)
+			__m256i b_coefficients;		///< Pairs of (b_u, 0)
+			__m256i one;
+			__m256i max_color;
+			__m256i alpha;
+
+			YuvConstants(const YuvCoefficients &c)
+			{
+				y_offset = _mm256_set1_epi16(c.y_offset);
+				c_offset = _mm256_set1_epi16(c.c_offset);
+				y_coefficients = _mm256_set1_epi32((int)((4096u << 16) | (uint16_t)c.y_scale));
+				r_coefficients = _mm256_set1_epi32((int)((uint32_t)(uint16_t)c.r_v << 16));
+				g_coefficients = _mm256_set1_epi32((int)(((uint32_t)(uint16_t)c.g_v << 16) | (uint16_t)c.g_u));
+				b_coefficients = _mm256_set1_epi32((int)(uint16_t)c.b_u);
+				one = _mm256_set1_epi16(1);
+				max_color = _mm256_set1_epi16(255);
+				alpha = _mm256_set1_epi16((short)0xFF00);
+			}
+		};
+
+		/// Spread 8 chroma samples over 16 pixels (the even pixels take a sample, the odd pixels average it with the next one)
+		static inline __m256i InterpolateChroma(const uint16_t *chroma)
+		{
+			__m128i samples = _mm_loadu_si128((const __m128i*)chroma);
+			__m128i averages = _mm_avg_epu16(samples, _mm_loadu_si128((const __m128i*)(chroma + 1)));
+
+			return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(samples, averages)), _mm_unpackhi_epi16(samples, averages), 1);
+		}
+
+		/// Combine the luma with the chroma of one color (32-bit results, in the lane order of the unpack instructions)
+		static inline __m256i ConvertColor(__m256i luma_lo, __m256i luma_hi, __m256i uv_lo, __m256i uv_hi, __m256i coefficients)
+		{
+			__m256i lo = _mm256_srai_epi32(_mm256_add_epi32(luma_lo, _mm256_madd_epi16(uv_lo, coefficients)), 13);
+			__m256i hi = _mm256_srai_epi32(_mm256_add_epi32(luma_hi, _mm256_madd_epi16(uv_hi, coefficients)), 13);
+
+			// Packing undoes the lane order of the unpacks, so the pixels are back in order
+			return _mm256_packs_epi32(lo, hi);
+		}
+
+		/// Convert 16 pixels (16-bit Y, U and V), and store them as RGBA
+		static inline void ConvertPixels(unsigned char *rgba, __m256i y, __m256i u, __m256i v, const YuvConstants &k)
+		{
+			y = _mm256_sub_epi16(y, k.y_offset);
+			u = _mm256_sub_epi16(u, k.c_offset);
+			v = _mm256_sub_epi16(v, k.c_offset);
+
+			// (Y - y_offset) * y_scale + 4096
+			__m256i luma_lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(y, k.one), k.y_coefficients);
+			__m256i luma_hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(y, k.one), k.y_coefficients);
+			__m256i uv_lo = _mm256_unpacklo_epi16(u, v);
+			__m256i uv_hi = _mm256_unpackhi_epi16(u, v);
+
+			__m256i zero = _mm256_setzero_si256();
+			__m256i r = _mm256_min_epi16(_mm256_max_epi16(ConvertColor(luma_lo, luma_hi, uv_lo, uv_hi, k.r_coefficients), zero), k.max_color);
+			__m256i g = _mm256_min_epi16(_mm256_max_epi16(ConvertColor(luma_lo, luma_hi, uv_lo, uv_hi, k.g_coefficients), zero), k.max_color);
+			__m256i b = _mm256_min_epi16(_mm256_max_epi16(ConvertColor(luma_lo, luma_hi, uv_lo, uv_hi, k.b_coefficients), zero), k.max_color);
+
+			// Interleave the colors (RG and BA pairs, then RGBA)
+			__m256i rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+			__m256i ba = _mm256_or_si256(b, k.alpha);
+			__m256i lo = _mm256_unpacklo_epi16(rg, ba);		// pixels 0-3 and 8-11
+			__m256i hi = _mm256_unpackhi_epi16(rg, ba);		// pixels 4-7 and 12-15
+
+			_mm256_storeu_si256((__m256i*)rgba, _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256((__m256i*)(rgba + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+		}
+
+		/// Interpolate 16 samples between 2 lines of chroma: (3 * nearest + farther + 2) >> 2
+		static inline __m256i InterpolateSamples(__m256i nearest, __m256i farther)
+		{
+			__m256i sum = _mm256_add_epi16(_mm256_add_epi16(nearest, _mm256_add_epi16(nearest, nearest)), farther);
+			return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(2)), 2);
+		}
+
+		// Convert a line of 8-bit Y (the chroma samples of the 16 pixels, and the one after them, are read)
+		int ConvertYuvLine8(unsigned char *rgba, const uint8_t *y, const uint16_t *u, const uint16_t *v, int width, const YuvCoefficients &coefficients)
+		{
+			YuvConstants k(coefficients);
+
+			int x = 0;
+			for (; x + 16 <= width; x += 16)
+			{
+				__m256i luma = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(y + x)));
+				ConvertPixels(rgba + x * 4, luma, InterpolateChroma(u + x / 2), InterpolateChroma(v + x / 2), k);
+			}
+
+			return x;
+		}
+
+		// Convert a line of 16-bit Y
+		int ConvertYuvLine16(unsigned char *rgba, const uint16_t *y, const uint16_t *u, const uint16_t *v, int width, const YuvCoefficients &coefficients)
+		{
+			YuvConstants k(coefficients);
+
+			int x = 0;
+			for (; x + 16 <= width; x += 16)
+			{
+				__m256i luma = _mm256_loadu_si256((const __m256i*)(y + x));
+				ConvertPixels(rgba + x * 4, luma, InterpolateChroma(u + x / 2), InterpolateChroma(v + x / 2), k);
+			}
+
+			return x;
+		}
+
+		// Interpolate a line of 8-bit chroma
+		int InterpolateChromaLine8(uint16_t *chroma, const uint8_t *nearest, const uint8_t *farther, int count)
+		{
+			int x = 0;
+			for (; x + 16 <= count; x += 16)
+			{
+				__m256i nearest16 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(nearest + x)));
+				__m256i farther16 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(farther + x)));
+				_mm256_storeu_si256((__m256i*)(chroma + x), InterpolateSamples(nearest16, farther16));
+			}
+
+			return x;
+		}
+
+		// Interpolate a line of 16-bit chroma (10 bits at most, so the sums fit in 16 bits)
+		int InterpolateChromaLine16(uint16_t *chroma, const uint16_t *nearest, const uint16_t *farther, int count)
+		{
+			int x = 0;
+			for (; x + 16 <= count; x += 16)
+			{
+				__m256i nearest16 = _mm256_loadu_si256((const __m256i*)(nearest + x));
+				__m256i farther16 = _mm256_loadu_si256((const __m256i*)(farther + x));
+				_mm256_storeu_si256((__m256i*)(chroma + x), InterpolateSamples(nearest16, farther16));
+			}
+
+			return x;
+		}
+
+		// Interpolate a line of interleaved UV into a line of U and a line of V
+		int InterpolateChromaLineNv12(uint16_t *u, uint16_t *v, const uint8_t *nearest, const uint8_t *farther, int count)
+		{
+			const __m256i low_bytes = _mm256_set1_epi16(0x00FF);
+
+			int x = 0;
+			for (; x + 16 <= count; x += 16)
+			{
+				// Each 16-bit pair holds U in its low byte and V in its high byte
+				__m256i nearest_uv = _mm256_loadu_si256((const __m256i*)(nearest + x * 2));
+				__m256i farther_uv = _mm256_loadu_si256((const __m256i*)(farther + x * 2));
+
+				_mm256_storeu_si256((__m256i*)(u + x), InterpolateSamples(_mm256_and_si256(nearest_uv, low_bytes), _mm256_and_si256(farther_uv, low_bytes)));
+				_mm256_storeu_si256((__m256i*)(v + x), InterpolateSamples(_mm256_srli_epi16(nearest_uv, 8), _mm256_srli_epi16(farther_uv, 8)));
+			}
+
+			return x;
+		}
+	}
+}
+
+#endif
+
+/*
+=============================================================
+Copyright Venatio Studios 2019
+=============================================================
+Revision History
+
+0.0.1 : 2026-10-18 17:45
+#vNext
+=============================================================
+*/